@@ -18,6 +18,9 @@ extern "C"
 #include "aiger.h"
 }
 
+#include "Ic3.h"
+#include "MiniSatApi.h"
+
 // set this to TRUE to add additional debug-outputs in the circuit
 // this can be useful for debugging.
 // set this to FALLSE if you want to use the resulting circuit with a MC, because these only
@@ -35,6 +38,9 @@ unsigned int num_err_latches_ = 0;
 
 map<unsigned, unsigned> orig_to_copy;
 vector<int> ci_variables;
+vector<unsigned> ci_inputs;
+vector<pair<unsigned, unsigned> > latch_copies; // (original latch, latch of the copy)
+unsigned f_latch = 0;
 
 // -------------------------------------------------------------------------------------------
 // @brief creates an XOR Gate:
@@ -173,6 +179,7 @@ void create_ci_signals(aiger* circuit, unsigned num_orig_latches)
 	for (unsigned i = 0; i < num_orig_latches; i++)
 	{
 		ci_in.push_back(next_free_aig_lit);
+		ci_inputs.push_back(next_free_aig_lit);
 		aiger_add_input(circuit, next_free_aig_lit, "ci");
 		next_free_aig_lit += 2;
 	}
@@ -221,6 +228,7 @@ unsigned create_f_signal(aiger* mc_circuit)
 	or_output = aiger_not(or_output);
 
 	aiger_add_latch(mc_circuit, f_latch_lit, or_output, "f_latch");
+	f_latch = f_latch_lit;
 
 	unsigned f_real_sig = next_free_aig_lit;
 	next_free_aig_lit += 2;
@@ -345,6 +353,7 @@ aiger* aiger_create_MC_copy(aiger* original_circuit)
 
 		aiger_add_latch(mc_circuit, o_lit, o_next, o_name);
 		aiger_add_latch(mc_circuit, mc_lit, read_orig_to_copy(o_next), o_name); // TODO: maybe name is copy_ ?
+		latch_copies.push_back(make_pair(o_lit, mc_lit));
 
 	}
 	// -----------------------------------------------------------------------------------------
@@ -469,15 +478,64 @@ void compute_num_or_err_latches(aiger* aig_original)
 		}
 	}
 }
+// -------------------------------------------------------------------------------------------
+// @brief checks the MC problem with the IC3 engine of OpenSEA, once per (original) latch
+// all latches are checked in the same IC3 session. The latch under test is selected by
+// assumptions on the ci inputs (ci true, all cj with j < i false), so lemmas which do not
+// depend on the selected latch are reused for the next latches.
+// Before the flip (f_latch is still false) both copies of each latch are equal: these clauses
+// are passed to IC3 as candidate lemmas, which saves most of the work of the generalization.
+// returns the number of vulnerable latches
+unsigned check_with_ic3(aiger* aig_mc, unsigned max_frames)
+{
+	SatSolver* solver = new MiniSatApi();
+	Ic3 ic3(aig_mc, solver);
+	for (unsigned i = 0; i < latch_copies.size(); i++)
+	{
+		unsigned orig = latch_copies[i].first;
+		unsigned copy = latch_copies[i].second;
+		ic3.addCandidateLemma({ f_latch, aiger_not(orig), copy });
+		ic3.addCandidateLemma({ f_latch, orig, aiger_not(copy) });
+	}
+
+	unsigned num_vulnerable = 0;
+	vector<unsigned> selection;
+	for (unsigned l = 0; l < ci_inputs.size(); l++)
+	{
+		selection.push_back(ci_inputs[l]);
+		ic3.setInputAssumptions(selection);
+		selection.back() = aiger_not(ci_inputs[l]);
+
+		Ic3::Result result = ic3.check(max_frames);
+		cout << "latch " << latch_copies[l].first << ": ";
+		if (result == Ic3::UNSAFE)
+		{
+			cout << "vulnerable";
+			num_vulnerable++;
+		}
+		else if (result == Ic3::SAFE)
+			cout << "protected";
+		else
+			cout << "unknown";
+		cout << " (" << ic3.getNumFrames() << " frames)" << endl;
+	}
+	delete solver;
+	return num_vulnerable;
+}
+
 // -------------------------------------------------------------------------------------------
 // @ brief prints Help to stdout
 void print_help(int argc, char* argv[])
 {
 	cout << "USAGE: " << argv[0] << " <input-aiger-file> <output-aiger-file>" << endl;
+	cout << "   or: " << argv[0] << " --ic3[=MAX_FRAMES] <input-aiger-file>" << endl;
 	cout << "     <input-aiger-file> ..... path to the aiger circuit with protection logic"
 			<< endl;
 	cout << "     <output-aiger-file> .... path to the resulting MC-compatible aiger circuit"
 			<< endl;
+	cout << "     --ic3 .................. checks the MC problem in-process (IC3) instead of"
+			<< endl;
+	cout << "                              writing it, and prints a verdict per latch" << endl;
 }
 
 // -------------------------------------------------------------------------------------------
@@ -493,14 +551,24 @@ int main(int argc, char *argv[])
 		return RET_WRONG_PARAMS;
 	}
 
+	string first_arg(argv[1]);
+	bool use_ic3 = first_arg.compare(0, 5, "--ic3") == 0;
+	unsigned ic3_max_frames = 0;
+	if (use_ic3 && first_arg.size() > 5)
+	{
+		istringstream iss(first_arg.substr(6));
+		iss >> ic3_max_frames;
+	}
+	const char* input_file = use_ic3 ? argv[2] : argv[1];
+
 	//------------------------------------------------------------------------------------------
 	// Read AIGER input file
 	aiger* aig_original = aiger_init();
-	const char *read_err = aiger_open_and_read_from_file(aig_original, argv[1]);
+	const char *read_err = aiger_open_and_read_from_file(aig_original, input_file);
 
 	if (read_err != NULL)
 	{
-		cout << "Error: Could not open AIGER file `" << argv[1] << "`" << endl;
+		cout << "Error: Could not open AIGER file `" << input_file << "`" << endl;
 		return RET_ERR_AIG_READ;
 	}
 
@@ -512,6 +580,16 @@ int main(int argc, char *argv[])
 	aiger* aig_mc = aiger_create_MC_copy(aig_original);
 	aiger_reset(aig_original);
 
+	//------------------------------------------------------------------------------------------
+	// check in-process
+	if (use_ic3)
+	{
+		unsigned num_vulnerable = check_with_ic3(aig_mc, ic3_max_frames);
+		cout << "#Vulnerabilities found: " << num_vulnerable << endl;
+		aiger_reset(aig_mc);
+		return RET_OK;
+	}
+
 	//------------------------------------------------------------------------------------------
 	// write output file
 	aiger_reencode(aig_mc);
@@ -26,6 +26,10 @@ avg_latches = "2" 		        # one additional error_latch protects 'avg_latches'
 
 TMP_DIR = "tmp/"
 
+# model checker: "blimc" (external binary, reads the MC file) or "ic3" (in-process IC3 engine
+# of alarmToMC, one verdict per latch, no MC file is written)
+MC_BACKEND = "blimc"
+
 # for each benchmark
 with open(BENCHMARKS_LIST) as f:
     for aiger_path in f:
@@ -47,6 +51,24 @@ with open(BENCHMARKS_LIST) as f:
         print "Inputs: X, Latches: Y, Error Latches: Z, Outputs: A" # todo: read values
         
 
+        if MC_BACKEND == "ic3":
+            print "BackEnd: IC3 (in-process), input: " + prot_file
+            cmd_ic3 = "./alarmToMC --ic3 " + out_file
+            start = time.time()
+            proc = subprocess.Popen(cmd_ic3, shell=True, stdout=subprocess.PIPE)
+            ic3_out = proc.communicate()[0]
+            end = time.time()
+            duration = end - start
+            if proc.returncode != 0:
+                print "Error calling the alarmToMC CMD: " + cmd_ic3
+                sys.exit(0)
+            for line in ic3_out.splitlines():
+                if line.startswith("#Vulnerabilities found:"):
+                    print line
+            print "Overall execution time: "+str(duration)+" sec CPU time, "+str(duration)+" sec real time."
+            sys.stdout.flush()
+            continue
+
 	# convert to MC problem
         mc_file = TMP_DIR + "mc_"+aiger_path.replace("/","_")
         cmd_mc_tool = "./alarmToMC " + out_file + " " + mc_file
@@ -0,0 +1,63 @@
+#!/usr/bin/python
+import subprocess
+import sys
+#############################################################################################
+##                                                                                         ##
+##   This script compares the static BDD variable orders (--bdd_order) of the 'bdd'        ##
+##   back-end. The circuits (without protection circuit) are converted using              ##
+##   AddParityTool so that they have an alarm signal. Then every converted circuit is      ##
+##   analyzed once for every variable order heuristic.                                     ##
+##                                                                                         ##
+############################################################################################# 
+
+# select tool + mode
+IMMORTAL_BIN = "./immortal-bin"
+BACKEND_MODE = "-b bdd -m 3"
+BDD_ORDERS = ["0", "1", "2"]	# 0: creation, 1: fanin_dfs, 2: fanin_dfs_f_first
+
+NUM_RAND_TC = "3"
+RAND_TC_LEN = "15"
+
+# set benchmarks
+BENCHMARK_DIR = "../../benchmark_files/"        # benchmarking circuits without protection circuits are in here
+# list of circuit-filenames located within the BENCHMARK_DIR:
+BENCHMARKS_LIST = "all_benchmarks.txt"		# the IWLS 2002 and 2005 benchmarks
+#BENCHMARKS_LIST = "standard_benchmarks.txt"	# easy benchmarks
+#BENCHMARKS_LIST = "medium_benchmarks.txt"	    # slightly more challenging
+
+
+# convert input circuits with addParityTool (protects the circuit with additional latches, adds an alarm-output)
+add_parity_binary = "./../../AddParityTool/addParityTool"
+percentage_to_protect = "50"    # randomly select this the given percentage of latches to protect 
+avg_latches = "2" 		        # one additional error_latch protects 'avg_latches' latches
+
+TMP_DIR = "tmp/bdd_order"
+
+# for each benchmark
+with open(BENCHMARKS_LIST) as f:
+    for aiger_path in f:
+        aiger_path = aiger_path.rstrip()
+        print "\n================================================================================"
+        out_file = TMP_DIR + "protected_"+aiger_path.replace("/","_")
+        cmd_add_parity = add_parity_binary + " " + BENCHMARK_DIR + aiger_path + " " + percentage_to_protect + " " + avg_latches + " " + out_file
+
+	# convert benchmark using addParityTool
+        return_code = subprocess.call(cmd_add_parity, shell=True, stdout=subprocess.PIPE)
+        if return_code != 0:
+            print "Error calling the addParityTool. CMD: " + cmd_add_parity
+            sys.exit(0)
+        sys.stdout.flush()
+
+	# execute converted benchmark with random inputs, once for every variable order.
+        for bdd_order in BDD_ORDERS:
+            print "--bdd_order=" + bdd_order
+            sys.stdout.flush()
+            cmd_immortal = IMMORTAL_BIN + " -i " + out_file + " -tcr " + NUM_RAND_TC + " " + RAND_TC_LEN + " " + BACKEND_MODE + " --bdd_order=" + bdd_order + " --print=L --seed=123456"
+            p = subprocess.Popen(cmd_immortal, shell=True, stderr=subprocess.PIPE) 
+            while True: # print output of tool
+                out = p.stderr.read(1)
+                if out == '' and p.poll() != None:
+                    break
+                if out != '':
+                    sys.stdout.write(out)
+                    sys.stdout.flush()
@@ -41,6 +41,12 @@ AIG2CNF& AIG2CNF::instance()
 
 // -------------------------------------------------------------------------------------------
 void AIG2CNF::initFromAig(aiger *aig)
+{
+  initFromAig(aig, 0);
+}
+
+// -------------------------------------------------------------------------------------------
+void AIG2CNF::initFromAig(aiger *aig, const vector<bool>* and_mask)
 {
   clear();
   trans_.add1LitClause(-1); // = TRUE costant
@@ -49,6 +55,8 @@ void AIG2CNF::initFromAig(aiger *aig)
   // clauses defining the outputs of the AND gates:
   for (unsigned i = 0; i < aig->num_ands; i++)
   {
+      if (and_mask != 0 && !(*and_mask)[i])
+        continue;
 
       int out_cnf_lit = aigLitToCnfLit(aig->ands[i].lhs);
       int rhs1_cnf_lit = aigLitToCnfLit(aig->ands[i].rhs1);
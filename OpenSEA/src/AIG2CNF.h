@@ -95,6 +95,19 @@ class AIG2CNF
 ///        implementation assumes version 1.9.4 of the AIGER utilities.
 	void initFromAig(aiger *aig);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Initializes this class from an aiger structure, but only encodes some AND gates.
+///
+/// Same as @link #initFromAig initFromAig(aiger*) @endlink, but AND gates which are not set
+/// in and_mask are not encoded (e.g., the ones outside the cone of influence of the outputs
+/// and next-state functions, see ConeOfInfluence). Their CNF variables are left unconstrained.
+///
+/// @pre aig != NULL
+/// @param aig The aiger structure as parsed by the AIGER utilities.
+/// @param and_mask The AND gates to encode (index = position in aig->ands), 0 = all
+	void initFromAig(aiger *aig, const vector<bool>* and_mask);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Clears all the CNFs constructed by @link #initFromAig initFromAig() @endlink.
@@ -307,6 +307,15 @@ vector<int> AigSimulator::getNextLatchValues()
 	return latches;
 }
 
+// -------------------------------------------------------------------------------------------
+int AigSimulator::getNextLatchValue(size_t latch_index) const
+{
+	unsigned next = circuit_->latches[latch_index].next;
+	if (next & 1)
+		return aiger_not(results_[aiger_lit2var(next)]);
+	return results_[aiger_lit2var(next)];
+}
+
 // -------------------------------------------------------------------------------------------
 void AigSimulator::initLatches()
 {
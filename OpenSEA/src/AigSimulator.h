@@ -156,6 +156,13 @@ class AigSimulator
 ///
 	vector<int> getNextLatchValues();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the next-state value of a single latch (without allocating a vector)
+///
+/// @param latch_index the index of the latch in the aiger latch array.
+	int getNextLatchValue(size_t latch_index) const;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief (re)sets the latch values to Zero
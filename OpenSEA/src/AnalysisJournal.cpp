@@ -0,0 +1,170 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file AnalysisJournal.cpp
+/// @brief Contains the definition of the class AnalysisJournal.
+// -------------------------------------------------------------------------------------------
+
+#include "AnalysisJournal.h"
+#include "Logger.h"
+
+// -------------------------------------------------------------------------------------------
+AnalysisJournal::AnalysisJournal(const string& path, const string& header, bool resume) :
+		path_(path)
+{
+	pthread_mutex_init(&mutex_, 0);
+	if (resume)
+		load(header);
+
+	out_.open(path_.c_str(), resume ? ios::app : ios::trunc);
+	MASSERT(out_, "could not write journal file: " + path_)
+	out_ << "# " << header << endl;
+}
+
+// -------------------------------------------------------------------------------------------
+AnalysisJournal::~AnalysisJournal()
+{
+	out_.close();
+	pthread_mutex_destroy(&mutex_);
+}
+
+// -------------------------------------------------------------------------------------------
+bool AnalysisJournal::isDone(unsigned latch_aig, unsigned testcase) const
+{
+	pthread_mutex_lock(&mutex_);
+	bool done = done_.find(make_pair(latch_aig, testcase)) != done_.end();
+	pthread_mutex_unlock(&mutex_);
+	return done;
+}
+
+// -------------------------------------------------------------------------------------------
+void AnalysisJournal::markDone(unsigned latch_aig, unsigned testcase)
+{
+	pthread_mutex_lock(&mutex_);
+	if (done_.insert(make_pair(latch_aig, testcase)).second)
+		out_ << "d " << latch_aig << " " << testcase << endl; // endl flushes
+	pthread_mutex_unlock(&mutex_);
+}
+
+// -------------------------------------------------------------------------------------------
+void AnalysisJournal::markFound(const set<unsigned>& detected_latches)
+{
+	pthread_mutex_lock(&mutex_);
+	for (set<unsigned>::const_iterator it = detected_latches.begin();
+			it != detected_latches.end(); ++it)
+	{
+		if (found_.insert(*it).second)
+			out_ << "f " << *it << endl;
+	}
+	pthread_mutex_unlock(&mutex_);
+}
+
+// -------------------------------------------------------------------------------------------
+const set<unsigned>& AnalysisJournal::getFoundLatches() const
+{
+	return found_;
+}
+
+// -------------------------------------------------------------------------------------------
+void AnalysisJournal::markTrace(const SuperfluousTrace& trace)
+{
+	ostringstream line; // written at once, the lines of several threads must not interleave
+	line << "t " << trace.component_ << " " << trace.component_index_ << " "
+			<< trace.flip_timestep_ << " " << trace.alarm_timestep_ << " "
+			<< trace.error_gone_timestep_ << " " << trace.testcase_.size();
+	for (unsigned step = 0; step < trace.testcase_.size(); ++step)
+	{
+		const vector<int>& inputs = trace.testcase_[step];
+		line << " ";
+		if (inputs.empty())
+			line << "-";
+		for (unsigned in = 0; in < inputs.size(); ++in)
+			line << inputs[in];
+	}
+
+	pthread_mutex_lock(&mutex_);
+	out_ << line.str() << endl;
+	pthread_mutex_unlock(&mutex_);
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<SuperfluousTrace>& AnalysisJournal::getTraces() const
+{
+	return traces_;
+}
+
+// -------------------------------------------------------------------------------------------
+void AnalysisJournal::load(const string& header)
+{
+	ifstream in_file(path_.c_str());
+	if (!in_file)
+	{
+		L_WRN("journal file " << path_ << " does not exist, starting from scratch");
+		return;
+	}
+
+	string line;
+	while (getline(in_file, line))
+	{
+		if (line.empty())
+			continue;
+		if (line[0] == '#')
+		{
+			MASSERT(line == "# " + header,
+					"journal " + path_ + " belongs to a different analysis or different inputs: '"
+					+ line + "', expected '# " + header + "'")
+			continue;
+		}
+
+		istringstream iss(line);
+		char type;
+		unsigned latch_aig, testcase;
+		if (!(iss >> type >> latch_aig))
+			continue; // incomplete line (e.g., written during a crash)
+		if (type == 'f')
+			found_.insert(latch_aig);
+		else if (type == 't')
+		{
+			SuperfluousTrace trace;
+			unsigned num_steps;
+			trace.component_ = latch_aig;
+			if (!(iss >> trace.component_index_ >> trace.flip_timestep_ >> trace.alarm_timestep_
+					>> trace.error_gone_timestep_ >> num_steps))
+				continue;
+			string step;
+			while (trace.testcase_.size() < num_steps && (iss >> step))
+			{
+				vector<int> inputs;
+				if (step != "-")
+				{
+					for (unsigned in = 0; in < step.size(); ++in)
+						inputs.push_back(step[in] - '0');
+				}
+				trace.testcase_.push_back(inputs);
+			}
+			if (trace.testcase_.size() == num_steps)
+				traces_.push_back(trace);
+		}
+		else if (type == 'd' && (iss >> testcase))
+			done_.insert(make_pair(latch_aig, testcase));
+	}
+	L_LOG("resuming from journal " << path_ << ": " << done_.size() << " completed, "
+			<< found_.size() << " detected, " << traces_.size() << " traces")
+}
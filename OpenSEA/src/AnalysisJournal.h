@@ -0,0 +1,188 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file AnalysisJournal.h
+/// @brief Contains the declaration of the class AnalysisJournal.
+// -------------------------------------------------------------------------------------------
+
+#ifndef AnalysisJournal_H__
+#define AnalysisJournal_H__
+
+#include "defines.h"
+#include "SuperFluousTrace.h"
+
+#include <pthread.h>
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class AnalysisJournal
+/// @brief An append-only checkpoint file for long analysis runs.
+///
+/// The journal records which (latch, test-case) pairs have been analyzed completely, which
+/// latches have been detected so far and (for the false-positives back-end) the traces found
+/// so far. Every entry is flushed immediately, so after a crash
+/// or preemption the run can be continued with --resume, skipping all completed work.
+///
+/// The file is line-based:
+/// <pre>
+///   # <back-end> <mode> <fingerprint>   header, must match the current run
+///   d <latch> <testcase>     the pair has been analyzed completely
+///   f <latch>                the latch has been detected
+///   t <latch> <index> <flip> <alarm> <gone> <steps> <inputs>...   a false-positive trace
+/// </pre>
+/// The fingerprint (see Options::getInputFingerprint()) identifies the circuit, the test-cases
+/// and the seed. The inputs of a trace are written as one string of 0/1 per time step ('-' if
+/// the circuit has no inputs). An analysis which flips all latches at once records a 'd'
+/// entry for each of its latches, and skips a test-case only if all of its latches are done.
+/// All methods may be called concurrently (e.g. by the groups of FalsePositives, which share
+/// the journal of their parent). The order of the lines does not matter and incomplete lines
+/// are ignored. Hence, journals
+/// of several shards (e.g. runs with disjoint --exclude lists) can simply be concatenated and
+/// used with --resume to get the merged result.
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class AnalysisJournal
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param path the file name of the journal.
+/// @param header identifies the analysis (back-end, mode and input fingerprint).
+/// @param resume if true, the existing entries are loaded and new entries are appended.
+///        Otherwise, the file is overwritten.
+	AnalysisJournal(const string& path, const string& header, bool resume);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+	virtual ~AnalysisJournal();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks if a (latch, test-case) pair has already been analyzed completely
+///
+/// @param latch_aig the latch.
+/// @param testcase the index of the test-case.
+/// @return true if the pair is recorded in the journal.
+	bool isDone(unsigned latch_aig, unsigned testcase) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records that a (latch, test-case) pair has been analyzed completely
+///
+/// @param latch_aig the latch.
+/// @param testcase the index of the test-case.
+	void markDone(unsigned latch_aig, unsigned testcase);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records the detected latches which are not in the journal yet
+///
+/// @param detected_latches the latches detected so far.
+	void markFound(const set<unsigned>& detected_latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns all latches recorded as detected (including the loaded ones)
+///
+/// @return the detected latches.
+	const set<unsigned>& getFoundLatches() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records a trace found by the false-positives back-end
+///
+/// @param trace the trace (including its concrete inputs).
+	void markTrace(const SuperfluousTrace& trace);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the traces loaded from the journal
+///
+/// @return the traces recorded in a previous run.
+	const vector<SuperfluousTrace>& getTraces() const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief reads the entries of an existing journal file
+///
+/// @param header the expected header.
+	void load(const string& header);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the file name of the journal
+	string path_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the file the new entries are appended to
+	ofstream out_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the completed (latch, test-case) pairs
+	set<pair<unsigned, unsigned> > done_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the detected latches
+	set<unsigned> found_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the traces recorded in a previous run
+	vector<SuperfluousTrace> traces_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief protects done_, found_ and out_
+	mutable pthread_mutex_t mutex_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+	AnalysisJournal(const AnalysisJournal &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+	AnalysisJournal& operator=(const AnalysisJournal &other);
+
+};
+
+#endif // AnalysisJournal_H__
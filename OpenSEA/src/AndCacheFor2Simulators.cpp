@@ -29,7 +29,7 @@
 AndCacheFor2Simulators::AndCacheFor2Simulators(vector<int> &results1, vector<int> &results2,
 		SatSolver* solver, int& next_free_cnf_var) :
 		results1_(results1), results2_(results2), solver_(solver), next_free_cnf_var_(
-				next_free_cnf_var)
+				next_free_cnf_var), difference_gates_(solver), num_shared_(0), num_different_(0)
 {
 }
 
@@ -38,33 +38,39 @@ AndCacheFor2Simulators::~AndCacheFor2Simulators()
 {
 }
 
+// -------------------------------------------------------------------------------------------
 void AndCacheFor2Simulators::addAndGate(int lhs_aig_lit, int rhs0_aig_lit, int rhs1_aig_lit)
 {
-
-	if ((results1_[rhs0_aig_lit >> 1] == results2_[rhs0_aig_lit >> 1])
-			&& (results1_[rhs1_aig_lit >> 1] == results2_[rhs1_aig_lit >> 1]))
+	if (!isDifferent(rhs0_aig_lit) && !isDifferent(rhs1_aig_lit))
 	{
+		// no difference in the inputs: the output is the one of the golden copy
 		results2_[lhs_aig_lit >> 1] = results1_[lhs_aig_lit >> 1];
+		num_shared_++;
+		return;
 	}
-	else
-	{
-//		cout << "cache miss" << endl;
-		int res = next_free_cnf_var_++;
-//		solver_->addVarToKeep(res);
 
-		int rhs1_cnf_value2 = Utils::readCnfValue(results2_, rhs1_aig_lit);
-		int rhs0_cnf_value2 = Utils::readCnfValue(results2_, rhs0_aig_lit);
+	// difference cone
+	int rhs1_cnf_value2 = Utils::readCnfValue(results2_, rhs1_aig_lit);
+	int rhs0_cnf_value2 = Utils::readCnfValue(results2_, rhs0_aig_lit);
+	results2_[lhs_aig_lit >> 1] = difference_gates_.addAndGate(rhs0_cnf_value2, rhs1_cnf_value2,
+			next_free_cnf_var_);
+	num_different_++;
+}
+
+// -------------------------------------------------------------------------------------------
+bool AndCacheFor2Simulators::isDifferent(unsigned aig_lit) const
+{
+	return results1_[aig_lit >> 1] != results2_[aig_lit >> 1];
+}
 
-// Do Sat-Solver calls
-// res == rhs1_cnf_value & rhs0_cnf_value:
-// Step 1: (rhs1_cnf_value == false) -> (res == false)
-		solver_->incAdd2LitClause(rhs1_cnf_value2, -res);
-		// Step 2: (rhs0_cnf_value == false) -> (res == false)
-		solver_->incAdd2LitClause(rhs0_cnf_value2, -res);
-		// Step 3: (rhs0_cnf_value == true && rhs1_cnf_value == true)
-		//   -> (res == true)
-		solver_->incAdd3LitClause(-rhs1_cnf_value2, -rhs0_cnf_value2, res);
+// -------------------------------------------------------------------------------------------
+unsigned AndCacheFor2Simulators::getNumSharedGates() const
+{
+	return num_shared_;
+}
 
-		results2_[lhs_aig_lit >> 1] = res;
-	}
+// -------------------------------------------------------------------------------------------
+unsigned AndCacheFor2Simulators::getNumDifferentGates() const
+{
+	return num_different_;
 }
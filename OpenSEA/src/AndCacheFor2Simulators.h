@@ -27,12 +27,20 @@
 
 #include "defines.h"
 #include "SatSolver.h"
+#include "AndCacheMap.h"
 
 // -------------------------------------------------------------------------------------------
 ///
 /// @class AndCacheFor2Simulators
 /// @brief A simple cache for two simulators running (almost) the same circuit.
 ///
+/// The first simulator is the fault-free (golden) copy, the second one the faulty copy, which
+/// uses this cache. An AND gate of the faulty copy whose inputs do not differ from the golden
+/// copy gets the golden value without any new clause. Only the gates with a difference in
+/// their inputs (the difference cone) are encoded, and these are structurally hashed, so the
+/// same gate is encoded only once even if it appears in several steps.
+/// The golden copy must simulate each step before the faulty copy.
+///
 /// @author Patrick Klampfl
 /// @version 1.2.0
 class AndCacheFor2Simulators
@@ -54,6 +62,24 @@ public:
 /// @brief Adds a new AND-Gate, if it is not already in the cache.
   void addAndGate(int lhs_aig_lit, int rhs0_aig_lit, int rhs1_aig_lit);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if a signal of the faulty copy differs from the golden copy.
+///
+/// @param aig_lit the AIGER literal of the signal.
+/// @return true if the two copies have different CNF literals for the signal.
+  bool isDifferent(unsigned aig_lit) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of AND gates which got the value of the golden copy.
+  unsigned getNumSharedGates() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of AND gates which were looked up in the difference cone.
+  unsigned getNumDifferentGates() const;
+
 protected:
 
   vector<int> &results1_;
@@ -61,6 +87,17 @@ protected:
   SatSolver* solver_;
   int &next_free_cnf_var_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the structurally hashed AND gates of the difference cone
+  AndCacheMap difference_gates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief statistics, see getNumSharedGates() and getNumDifferentGates()
+  unsigned num_shared_;
+  unsigned num_different_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
@@ -28,6 +28,10 @@
 #include "ErrorTraceManager.h"
 #include "Options.h"
 #include "Logger.h"
+#include "FaultCollapsing.h"
+#include "ConeOfInfluence.h"
+#include "SatSolver.h"
+#include "AnalysisJournal.h"
 
 extern "C"
 {
@@ -37,7 +41,8 @@ extern "C"
 // -------------------------------------------------------------------------------------------
 BackEnd::BackEnd(aiger* circuit, int num_err_latches, int mode, aiger* environment_model) :
 		circuit_(circuit), environment_model_(environment_model), mode_(mode),
-		num_err_latches_(num_err_latches)
+		num_err_latches_(num_err_latches), analysis_started_(Stopwatch::start()),
+		latch_started_(analysis_started_), journal_(0), journal_enabled_(true)
 {
 	MASSERT(!environment_model || environment_model->num_outputs >= circuit->num_outputs - 1, "Error: Environment model has too few outputs!");
 }
@@ -45,7 +50,7 @@ BackEnd::BackEnd(aiger* circuit, int num_err_latches, int mode, aiger* environme
 // -------------------------------------------------------------------------------------------
 BackEnd::~BackEnd()
 {
-	// nothing to be done
+	delete journal_;
 }
 
 // -------------------------------------------------------------------------------------------
@@ -57,6 +62,8 @@ const set<unsigned>& BackEnd::getDetectedLatches() const
 void BackEnd::printResults()
 {
 	L_LOG("#Errors found: " << detected_latches_.size());
+	if (!unknown_latches_.empty())
+		L_LOG("#Unknown (budget exceeded): " << unknown_latches_.size());
 	if (Options::instance().isUseDiagnosticOutput())
 	{
 		ErrorTraceManager::instance().printErrorTraces();
@@ -83,4 +90,154 @@ void BackEnd::storeResultingLatches()
 
 	out_file.close();
 
+	if (unknown_latches_.empty())
+		return;
+
+	string unknown_path = Options::instance().getLatchesResultPath() + ".unknown";
+	out_file.open(unknown_path.c_str());
+	MASSERT(out_file, "could not write latches result file: " + unknown_path)
+	for(set<unsigned>::iterator it = unknown_latches_.begin(); it != unknown_latches_.end(); ++it)
+	{
+		out_file << *it << endl;
+	}
+	out_file.close();
+}
+
+void BackEnd::propagateCollapsedLatches()
+{
+	FaultCollapsing* fault_collapsing = Options::instance().getFaultCollapsing();
+	if (fault_collapsing == 0)
+		return;
+
+	fault_collapsing->propagateVerdict(detected_latches_);
+	fault_collapsing->propagateVerdict(unknown_latches_);
+
+	if (!Options::instance().isUseDiagnosticOutput())
+		return;
+	vector<ErrorTrace*>& traces = ErrorTraceManager::instance().error_traces_;
+	unsigned num_traces = traces.size(); // only the traces of the representatives
+	for (unsigned t_cnt = 0; t_cnt < num_traces; ++t_cnt)
+	{
+		const vector<unsigned>& members =
+				fault_collapsing->getClassMembers(traces[t_cnt]->latch_index_);
+		for (unsigned m_cnt = 0; m_cnt < members.size(); ++m_cnt)
+		{
+			ErrorTrace* trace = new ErrorTrace(*traces[t_cnt]);
+			trace->latch_index_ = members[m_cnt];
+			traces.push_back(trace);
+		}
+	}
+}
+
+const set<unsigned>& BackEnd::getUnknownLatches() const
+{
+	return unknown_latches_;
+}
+
+void BackEnd::scheduleLatches(vector<unsigned>& latches) const
+{
+	if (!Options::instance().isScheduleLatches())
+		return;
+
+	ConeOfInfluence coi(circuit_);
+	vector<pair<unsigned, unsigned> > difficulty_and_latch;
+	difficulty_and_latch.reserve(latches.size());
+	for (unsigned l_cnt = 0; l_cnt < latches.size(); ++l_cnt)
+	{
+		coi.setFlippedLatch(latches[l_cnt]);
+		difficulty_and_latch.push_back(make_pair(coi.getNumAndsInMask(), latches[l_cnt]));
+	}
+	// pairs are compared by difficulty first, the latch literal keeps the order deterministic
+	sort(difficulty_and_latch.begin(), difficulty_and_latch.end());
+	for (unsigned l_cnt = 0; l_cnt < latches.size(); ++l_cnt)
+		latches[l_cnt] = difficulty_and_latch[l_cnt].second;
+}
+
+void BackEnd::startLatchBudget(SatSolver* solver)
+{
+	latch_started_ = Stopwatch::start();
+	if (solver != 0)
+		solver->setConflictLimit(Options::instance().getConflictLimit());
+}
+
+bool BackEnd::isBudgetExceeded() const
+{
+	double latch_timeout = Options::instance().getLatchTimeout();
+	if (latch_timeout > 0 && Stopwatch::getCPUTimeSec(latch_started_) > latch_timeout)
+		return true;
+	return isGlobalBudgetExceeded();
+}
+
+bool BackEnd::isGlobalBudgetExceeded() const
+{
+	double global_timeout = Options::instance().getGlobalTimeout();
+	return global_timeout > 0 && Stopwatch::getRealTimeSec(analysis_started_) > global_timeout;
+}
+
+void BackEnd::markLatchUnknown(unsigned latch_aig)
+{
+	if (detected_latches_.find(latch_aig) == detected_latches_.end())
+		unknown_latches_.insert(latch_aig);
+}
+
+void BackEnd::markUndetectedLatchesUnknown(const vector<unsigned>& latches)
+{
+	for (unsigned l_cnt = 0; l_cnt < latches.size(); ++l_cnt)
+		markLatchUnknown(latches[l_cnt]);
+}
+
+void BackEnd::disableJournal()
+{
+	journal_enabled_ = false;
+	delete journal_;
+	journal_ = 0;
+}
+
+void BackEnd::openJournal()
+{
+	const string& path = Options::instance().getJournalPath();
+	if (path == "" || !journal_enabled_)
+		return;
+
+	ostringstream header;
+	header << Options::instance().getBackEndName() << " " << mode_ << " "
+			<< Options::instance().getInputFingerprint(circuit_);
+	delete journal_;
+	journal_ = new AnalysisJournal(path, header.str(), Options::instance().isResume());
+	const set<unsigned>& found = journal_->getFoundLatches();
+	detected_latches_.insert(found.begin(), found.end());
+}
+
+bool BackEnd::isJournaledDone(unsigned latch_aig, unsigned testcase) const
+{
+	return journal_ != 0 && journal_->isDone(latch_aig, testcase);
+}
+
+void BackEnd::journalDone(unsigned latch_aig, unsigned testcase)
+{
+	if (journal_ == 0)
+		return;
+	journal_->markFound(detected_latches_);
+	journal_->markDone(latch_aig, testcase);
+}
+
+bool BackEnd::isJournaledDone(const vector<unsigned>& latches, unsigned testcase) const
+{
+	if (journal_ == 0 || latches.empty())
+		return false;
+	for (unsigned l_cnt = 0; l_cnt < latches.size(); ++l_cnt)
+	{
+		if (!journal_->isDone(latches[l_cnt], testcase))
+			return false;
+	}
+	return true;
+}
+
+void BackEnd::journalDone(const vector<unsigned>& latches, unsigned testcase)
+{
+	if (journal_ == 0)
+		return;
+	journal_->markFound(detected_latches_);
+	for (unsigned l_cnt = 0; l_cnt < latches.size(); ++l_cnt)
+		journal_->markDone(latches[l_cnt], testcase);
 }
@@ -26,8 +26,11 @@
 #define BackEnd_H__
 
 #include "defines.h"
+#include "Stopwatch.h"
 
 struct aiger;
+class SatSolver;
+class AnalysisJournal;
 // -------------------------------------------------------------------------------------------
 ///
 /// @class BackEnd
@@ -76,7 +79,129 @@ public:
 
 	void storeResultingLatches();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief copies the results of analyze() from the representatives to all other latches of
+/// their fault collapsing class (does nothing if fault collapsing is disabled)
+///
+/// The faulty runs of all members of a class are identical, so the detected and unknown
+/// latches as well as the error traces (--diagnostic_output) are copied, the traces are
+/// re-targeted to each member.
+	virtual void propagateCollapsedLatches();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the latches for which analyze() gave up because a budget was exceeded
+///
+/// @return The set of latches with an unknown result
+	const set<unsigned>& getUnknownLatches() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief ignores --journal for this instance
+///
+/// Used for back-ends which run inside another analysis (e.g., the 'stla' fallback of 'bdd'):
+/// they must neither overwrite the journal of the outer analysis nor skip work recorded in it.
+	void disableJournal();
+
 protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief orders the latches by their estimated difficulty (if enabled with --schedule)
+///
+/// The difficulty of a latch is estimated by the number of AND gates in the cone of influence
+/// of a bit-flip in this latch. Easy latches come first, so that a budget is spent on as many
+/// latches as possible.
+///
+/// @param latches the AIG literals of the latches to analyze, will be reordered.
+	void scheduleLatches(vector<unsigned>& latches) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief starts the budget of a new latch
+///
+/// Restarts the per-latch timer and sets the conflict limit (--conflict_limit) of the solver.
+///
+/// @param solver the solver used for this latch (0 if none).
+	void startLatchBudget(SatSolver* solver);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks if the budget of the current latch or of the whole analysis is used up
+///
+/// @return true if --latch_timeout or --timeout has been exceeded.
+	bool isBudgetExceeded() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks if the budget of the whole analysis (--timeout) is used up
+///
+/// @return true if --timeout has been exceeded.
+	bool isGlobalBudgetExceeded() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief reports a latch as unknown (only if it has not been detected already)
+///
+/// @param latch_aig the latch we gave up on.
+	void markLatchUnknown(unsigned latch_aig);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief reports all latches which have not been detected as unknown
+///
+/// Used by the analyses which flip all latches at once, if a budget (--timeout or
+/// --conflict_limit) stopped them before all test-cases were analyzed completely.
+///
+/// @param latches the latches of the analysis.
+	void markUndetectedLatchesUnknown(const vector<unsigned>& latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief opens the checkpoint journal (if enabled with --journal)
+///
+/// With --resume, the latches detected in the previous run are added to detected_latches_.
+/// Call this at the beginning of an analysis, after detected_latches_ has been cleared.
+	void openJournal();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks if a (latch, test-case) pair has been completed in a previous run
+///
+/// @param latch_aig the latch.
+/// @param testcase the index of the test-case.
+/// @return true if the pair can be skipped.
+	bool isJournaledDone(unsigned latch_aig, unsigned testcase) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks if a test-case has been completed for all given latches in a previous run
+///
+/// Used by the analyses which flip all latches at once. A test-case journaled by a run with
+/// other latches (e.g. another --exclude list) is only skipped if it covered all of them.
+///
+/// @param latches the latches of the analysis.
+/// @param testcase the index of the test-case.
+/// @return true if the test-case can be skipped.
+	bool isJournaledDone(const vector<unsigned>& latches, unsigned testcase) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records a completed (latch, test-case) pair and all latches detected so far
+///
+/// @param latch_aig the latch.
+/// @param testcase the index of the test-case.
+	void journalDone(unsigned latch_aig, unsigned testcase);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records a test-case completed for all given latches and all latches detected so far
+///
+/// @param latches the latches of the analysis.
+/// @param testcase the index of the test-case.
+	void journalDone(const vector<unsigned>& latches, unsigned testcase);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief the circuit to analyze
@@ -101,6 +226,27 @@ protected:
 /// protection circuit.
 	unsigned num_err_latches_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the latches for which analyze() ran out of budget
+	set<unsigned> unknown_latches_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the start of the analysis (for --timeout) and of the current latch (--latch_timeout)
+	PointInTime analysis_started_;
+	PointInTime latch_started_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the checkpoint journal (0 if disabled)
+	AnalysisJournal* journal_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief false if --journal is ignored (see disableJournal())
+	bool journal_enabled_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
@@ -26,18 +26,43 @@
 #include "BddAnalysis.h"
 
 #include "AigSimulator.h"
+#include "BddCnfBridge.h"
 #include "BddSimulator.h"
 #include "BddSimulator2.h"
+#include "BddVariableOrder.h"
 #include "ErrorTraceManager.h"
 #include "Logger.h"
 #include "Options.h"
+#include "SatSolver.h"
+#include "SymbTimeLocationAnalysis.h"
+#include "SymbolicSimulator.h"
 #include "TestCaseProvider.h"
 
 #include <math.h> // ceil, log2
+#include <pthread.h>
+#include <stdexcept>
+
+// -------------------------------------------------------------------------------------------
+/// @brief Computes the set of BDD variables the current state depends on.
+///
+/// @param circuit The simulated circuit.
+/// @param cudd The BDD manager.
+/// @param sim The simulator (BddSimulator or BddSimulator2), after switchToNextState().
+/// @return The cube of all variables in the support of the latch values.
+template<class BddSim>
+static BDD computeStateSupport(aiger* circuit, Cudd& cudd, BddSim& sim)
+{
+	BDD support = cudd.bddOne();
+	for (unsigned l = 0; l < circuit->num_latches; ++l)
+		support &= sim.getResultValue(circuit->latches[l].lit >> 1).Support();
+	return support;
+}
 
 // -------------------------------------------------------------------------------------------
 BddAnalysis::BddAnalysis(aiger* circuit, int num_err_latches, int mode) :
-		BackEnd(circuit, num_err_latches, mode), useStatistics_(false)
+		BackEnd(circuit, num_err_latches, mode),
+		cudd_(0, 0, Options::instance().getBddUniqueSlots(), Options::instance().getBddCacheSlots()),
+		useStatistics_(Options::instance().getBddStatsPath() != ""), current_testcase_(0)
 {
 }
 
@@ -51,25 +76,46 @@ bool BddAnalysis::analyze(vector<TestCase>& testcases)
 {
 	PointInTime begin = Stopwatch::start();
 	accumulated_durations_.clear();
+	accumulated_cudd_counters_.clear();
+	partition_manager_counters_.clear();
 	detected_latches_.clear();
 
 	next_free_cnf_var_ = 2;
+	free_bdd_vars_.clear();
 
 //	cudd_.AutodynEnable(CUDD_REORDER_SIFT);  // it is better to turn off automatic reordering
 //	cudd_.EnableReorderingReporting();
+	setMemoryLimits();
+	current_testcase_ = 0;
 
-	if (mode_ == C_ONE_HOT_ENCODING)
-		analyze_one_hot_enc_c_signals(testcases);
-	else if (mode_ == C_CONSTR)
-		analyze_one_hot_enc_c_constraints(testcases);
-	else if (mode_ == C_BINARY_ENCODING)
-		analyze_binary_enc_c_signals(testcases);
-	else if (mode_ == C_F_BINARY)
-		analyze_binary_enc_c_and_f_signals(testcases);
-	else if (mode_ == C_F_BINARY_FREE_INPUTS)
-		analyze_binary_enc_c_and_f_signals_FREE_INPUTS(testcases);
-	else
-		MASSERT(false, "unknown mode!")
+	unsigned num_partitions = Options::instance().getBddPartitions();
+	if (num_partitions > 1 && latch_subset_.empty()) // partitions do not partition again
+	{
+		analyzePartitioned(testcases, num_partitions);
+		printStatistics(begin);
+		return detected_latches_.size() > 0;
+	}
+
+	try
+	{
+		if (mode_ == C_ONE_HOT_ENCODING)
+			analyze_one_hot_enc_c_signals(testcases);
+		else if (mode_ == C_CONSTR)
+			analyze_one_hot_enc_c_constraints(testcases);
+		else if (mode_ == C_BINARY_ENCODING)
+			analyze_binary_enc_c_signals(testcases);
+		else if (mode_ == C_F_BINARY || mode_ == C_F_BINARY_HYBRID)
+			analyze_binary_enc_c_and_f_signals(testcases);
+		else if (mode_ == C_F_BINARY_FREE_INPUTS)
+			analyze_binary_enc_c_and_f_signals_FREE_INPUTS(testcases);
+		else
+			MASSERT(false, "unknown mode!")
+	}
+	catch (std::logic_error& e) // thrown by the default error handler of the Cudd class
+	{
+		L_LOG("BDD limit exceeded (" << e.what() << "), falling back to 'stla'")
+		fallbackToSymbTimeLocation(testcases);
+	}
 
 
 	printStatistics(begin);
@@ -85,7 +131,9 @@ void BddAnalysis::analyze_one_hot_enc_c_signals(vector<TestCase>& testcases)
 
 	AigSimulator sim_(circuit_);
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	vector<unsigned> l_list = getLatchesToCheck();
+	BddVariableOrder var_order(circuit_, Options::instance().getBddVariableOrder());
+	var_order.orderLatches(l_list);
 	set<int> latches_to_check_;
 
 	//------------------------------------------------------------------------------------------
@@ -125,6 +173,7 @@ void BddAnalysis::analyze_one_hot_enc_c_signals(vector<TestCase>& testcases)
 		}
 		cj_to_BDD_signal[map_iter->second] = real_c_signal;
 	}
+	BDD c_cube = create_var_cube(first_cj_var, last_cj_var);
 	stopWatchStore(CREATE_C_SIGNALS);
 
 	//------------------------------------------------------------------------------------------
@@ -133,6 +182,12 @@ void BddAnalysis::analyze_one_hot_enc_c_signals(vector<TestCase>& testcases)
 	// for each testcase-step
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
+		current_testcase_ = tc_number; // where to continue if a BDD limit is exceeded
+		if (isGlobalBudgetExceeded()) // BDD operations cannot be interrupted, check per test-case
+		{
+			markUndetectedLatchesUnknown(l_list);
+			break;
+		}
 
 		// initial state for concrete simulation = (0 0 0 0 0 0 0)  (AIG literals)
 		vector<int> concrete_state;
@@ -172,7 +227,7 @@ void BddAnalysis::analyze_one_hot_enc_c_signals(vector<TestCase>& testcases)
 			// fi indicates whether the component is flipped in step i or not
 			// there can only be a flip at time-step i if both cj and fi are true.
 
-			int fi = next_free_cnf_var_++;
+			int fi = allocate_bdd_var();
 			BDD fi_bdd = cudd_.bddVar(fi);
 
 			stopWatchStart();
@@ -253,62 +308,78 @@ void BddAnalysis::analyze_one_hot_enc_c_signals(vector<TestCase>& testcases)
 			BDD check = side_constraints & output_is_different_bdd;
 
 			stopWatchStart();
-			while (!check.IsZero())
+			bool is_sat = !check.IsZero();
+			stopWatchStore(SATISFIABILITY);
+			if (is_sat)
 			{
-				stopWatchStore(SATISFIABILITY);
-
+				// project all counterexamples onto the c vars at once and read the vulnerable
+				// latches from the projection, instead of extracting them one cube at a time
 				stopWatchStart();
-				check.PickOneCube(model); // store model
+				BDD c_projection = project_on_c_vars(check, c_cube);
+				vector<vector<char> > c_cubes;
+				enumerate_c_cubes(c_projection, first_cj_var, last_cj_var, c_cubes);
 				stopWatchStore(STORE_MODEL);
 
 				stopWatchStart();
-				// find the one and only true c-signal in model
-				int cj = 0;
-				for (int i = first_cj_var; i <= last_cj_var; i++)
+				// c is one-hot: the only c-signal of a cube that is not false is the flipped one
+				set<int> vulnerable_cjs;
+				for (unsigned cube = 0; cube < c_cubes.size(); ++cube)
 				{
-					if (model[i] == 1)
+					for (unsigned i = 0; i < c_cubes[cube].size(); ++i)
 					{
-						cj = i;
-						break;
+						if (c_cubes[cube][i] != 0)
+							vulnerable_cjs.insert(first_cj_var + i);
 					}
 				}
-				cj_to_BDD_signal[cj] = cudd_.bddZero(); // free the memory
-				// TODO: set cudd.bddVar(cj) to constant false/remove ??
+				stopWatchStore(PARSE_MODEL);
 
-				// find the one and only true f-signal from model
-				int fi = 0;
-				for (unsigned i = 0; i < f_inputs.size(); i++)
+				for (set<int>::iterator it = vulnerable_cjs.begin(); it != vulnerable_cjs.end(); ++it)
 				{
-					if (model[f_inputs[i]] == 1)
+					int cj = *it;
+					cj_to_BDD_signal[cj] = cudd_.bddZero(); // free the memory
+
+					if (Options::instance().isUseDiagnosticOutput())
 					{
-						fi = f_inputs[i];
-						break;
-					}
-				}
-				stopWatchStore(PARSE_MODEL);
+						// a counterexample for this latch, to find the flip time-step
+						(check & cudd_.bddVar(cj)).PickOneCube(model);
+						int fi = 0;
+						for (unsigned i = 0; i < f_inputs.size(); i++)
+						{
+							if (model[f_inputs[i]] == 1)
+							{
+								fi = f_inputs[i];
+								break;
+							}
+						}
 
-				if (Options::instance().isUseDiagnosticOutput())
-				{
-					ErrorTrace* trace = new ErrorTrace;
+						ErrorTrace* trace = new ErrorTrace;
 
-					trace->error_timestep_ = timestep;
-					trace->input_trace_ = testcase;
-					trace->latch_index_ = cj_to_latch[cj];
-					trace->flipped_timestep_ = fi_to_timestep[fi];
+						trace->error_timestep_ = timestep;
+						trace->input_trace_ = testcase;
+						trace->latch_index_ = cj_to_latch[cj];
+						trace->flipped_timestep_ = fi_to_timestep[fi];
 
-					ErrorTraceManager::instance().error_traces_.push_back(trace);
+						storeErrorTrace(trace);
+					}
+
+					detected_latches_.insert(cj_to_latch[cj]);
 				}
 
-				detected_latches_.insert(cj_to_latch[cj]);
 				stopWatchStart();
-				side_constraints &= ~cudd_.bddVar(cj);
-				check = side_constraints & output_is_different_bdd;
+				side_constraints &= ~c_projection;
 				stopWatchStore(SIDE_CONSTRAINTS);
-
-				stopWatchStart(); // SATISFIABILITY
 			}
 
+			//--------------------------------------------------------------------------------------
+			// flips in time-steps the next state does not depend on can not cause any further
+			// errors: quantify their f vars out of the side constraints and recycle them
+			stopWatchStart();
+			release_expired_f_vars(computeStateSupport(circuit_, cudd_, bddSim), f_inputs,
+					f_prime_bdd, side_constraints);
+			stopWatchStore(SIDE_CONSTRAINTS);
+
 		} // -- END "for each timestep in testcase" --
+		release_f_vars(f_inputs);
 	} // ------ END 'for each testcase' ---------------
 
 	free(model);
@@ -322,7 +393,9 @@ void BddAnalysis::analyze_one_hot_enc_c_constraints(vector<TestCase>& testcases)
 
 	AigSimulator sim_(circuit_);
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	vector<unsigned> l_list = getLatchesToCheck();
+	BddVariableOrder var_order(circuit_, Options::instance().getBddVariableOrder());
+	var_order.orderLatches(l_list);
 	set<int> latches_to_check_;
 
 	//------------------------------------------------------------------------------------------
@@ -352,6 +425,7 @@ void BddAnalysis::analyze_one_hot_enc_c_constraints(vector<TestCase>& testcases)
 		}
 	}
 	int last_cj_var = next_free_cnf_var_ - 1;
+	BDD c_cube = create_var_cube(first_cj_var, last_cj_var);
 	stopWatchStore(CREATE_C_SIGNALS);
 
 	BddSimulator bddSim(circuit_, cudd_, next_free_cnf_var_);
@@ -359,6 +433,12 @@ void BddAnalysis::analyze_one_hot_enc_c_constraints(vector<TestCase>& testcases)
 	// for each testcase-step
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
+		current_testcase_ = tc_number; // where to continue if a BDD limit is exceeded
+		if (isGlobalBudgetExceeded()) // BDD operations cannot be interrupted, check per test-case
+		{
+			markUndetectedLatchesUnknown(l_list);
+			break;
+		}
 
 		// initial state for concrete simulation = (0 0 0 0 0 0 0)  (AIG literals)
 		vector<int> concrete_state;
@@ -395,7 +475,7 @@ void BddAnalysis::analyze_one_hot_enc_c_constraints(vector<TestCase>& testcases)
 			// fi indicates whether the component is flipped in step i or not
 			// there can only be a flip at time-step i if both cj and fi are true.
 
-			int fi = next_free_cnf_var_++;
+			int fi = allocate_bdd_var();
 			BDD fi_bdd = cudd_.bddVar(fi);
 
 			stopWatchStart();
@@ -476,62 +556,78 @@ void BddAnalysis::analyze_one_hot_enc_c_constraints(vector<TestCase>& testcases)
 			BDD check = side_constraints & output_is_different_bdd;
 
 			stopWatchStart();
-			while (!check.IsZero())
+			bool is_sat = !check.IsZero();
+			stopWatchStore(SATISFIABILITY);
+			if (is_sat)
 			{
-				stopWatchStore(SATISFIABILITY);
-
+				// project all counterexamples onto the c vars at once and read the vulnerable
+				// latches from the projection, instead of extracting them one cube at a time
 				stopWatchStart();
-				check.PickOneCube(model); // store model
+				BDD c_projection = project_on_c_vars(check, c_cube);
+				vector<vector<char> > c_cubes;
+				enumerate_c_cubes(c_projection, first_cj_var, last_cj_var, c_cubes);
 				stopWatchStore(STORE_MODEL);
 
 				stopWatchStart();
-				// find the one and only true c-signal in model
-				int cj = 0;
-				for (int i = first_cj_var; i <= last_cj_var; i++)
+				// c is one-hot: the only c-signal of a cube that is not false is the flipped one
+				set<int> vulnerable_cjs;
+				for (unsigned cube = 0; cube < c_cubes.size(); ++cube)
 				{
-					if (model[i] == 1)
+					for (unsigned i = 0; i < c_cubes[cube].size(); ++i)
 					{
-						cj = i;
-						break;
+						if (c_cubes[cube][i] != 0)
+							vulnerable_cjs.insert(first_cj_var + i);
 					}
 				}
-				cj_to_BDD_signal[cj] = cudd_.bddZero(); // free the memory
-				// TODO: set cudd.bddVar(cj) to constant false/remove ??
+				stopWatchStore(PARSE_MODEL);
 
-				// find the one and only true f-signal from model
-				int fi = 0;
-				for (unsigned i = 0; i < f_inputs.size(); i++)
+				for (set<int>::iterator it = vulnerable_cjs.begin(); it != vulnerable_cjs.end(); ++it)
 				{
-					if (model[f_inputs[i]] == 1)
+					int cj = *it;
+					cj_to_BDD_signal[cj] = cudd_.bddZero(); // free the memory
+
+					if (Options::instance().isUseDiagnosticOutput())
 					{
-						fi = f_inputs[i];
-						break;
-					}
-				}
-				stopWatchStore(PARSE_MODEL);
+						// a counterexample for this latch, to find the flip time-step
+						(check & cudd_.bddVar(cj)).PickOneCube(model);
+						int fi = 0;
+						for (unsigned i = 0; i < f_inputs.size(); i++)
+						{
+							if (model[f_inputs[i]] == 1)
+							{
+								fi = f_inputs[i];
+								break;
+							}
+						}
 
-				if (Options::instance().isUseDiagnosticOutput())
-				{
-					ErrorTrace* trace = new ErrorTrace;
+						ErrorTrace* trace = new ErrorTrace;
 
-					trace->error_timestep_ = timestep;
-					trace->input_trace_ = testcase;
-					trace->latch_index_ = cj_to_latch[cj];
-					trace->flipped_timestep_ = fi_to_timestep[fi];
+						trace->error_timestep_ = timestep;
+						trace->input_trace_ = testcase;
+						trace->latch_index_ = cj_to_latch[cj];
+						trace->flipped_timestep_ = fi_to_timestep[fi];
+
+						storeErrorTrace(trace);
+					}
 
-					ErrorTraceManager::instance().error_traces_.push_back(trace);
+					detected_latches_.insert(cj_to_latch[cj]);
 				}
 
-				detected_latches_.insert(cj_to_latch[cj]);
 				stopWatchStart();
-				side_constraints &= ~cudd_.bddVar(cj);
-				check = side_constraints & output_is_different_bdd;
+				side_constraints &= ~c_projection;
 				stopWatchStore(SIDE_CONSTRAINTS);
-
-				stopWatchStart(); // SATISFIABILITY
 			}
 
+			//--------------------------------------------------------------------------------------
+			// flips in time-steps the next state does not depend on can not cause any further
+			// errors: quantify their f vars out of the side constraints and recycle them
+			stopWatchStart();
+			release_expired_f_vars(computeStateSupport(circuit_, cudd_, bddSim), f_inputs,
+					f_prime_bdd, side_constraints);
+			stopWatchStore(SIDE_CONSTRAINTS);
+
 		} // -- END "for each timestep in testcase" --
+		release_f_vars(f_inputs);
 	} // ------ END 'for each testcase' ---------------
 
 	free(model);
@@ -559,16 +655,169 @@ BDD BddAnalysis::binary_conjunct(unsigned binary_encoding,
 }
 
 void BddAnalysis::create_binary_encoded_c_BDDs(const vector<BDD>& c_vars,
-		map<unsigned, BDD>& latch_to_BDD_signal, set<int>& latches_to_check)
+		const vector<unsigned>& latches, map<unsigned, BDD>& latch_to_BDD_signal,
+		vector<unsigned>& code_to_latch)
+{
+	code_to_latch = latches;
+	for (unsigned binary_encoding = 0; binary_encoding < latches.size(); ++binary_encoding)
+	{
+		latch_to_BDD_signal[latches[binary_encoding]] = binary_conjunct(binary_encoding, c_vars);
+	}
+}
+
+int BddAnalysis::allocate_bdd_var()
 {
+	if (free_bdd_vars_.empty())
+		return next_free_cnf_var_++;
+
+	int var = free_bdd_vars_.back();
+	free_bdd_vars_.pop_back();
+	return var;
+}
 
-	unsigned binary_encoding = 0;
-	for (set<int>::iterator it = latches_to_check.begin(); it != latches_to_check.end();
-			++it)
+// -------------------------------------------------------------------------------------------
+BDD BddAnalysis::create_var_cube(int first_var, int last_var)
+{
+	BDD cube = cudd_.bddOne();
+	for (int var = first_var; var <= last_var; ++var)
+		cube &= cudd_.bddVar(var);
+	return cube;
+}
+
+// -------------------------------------------------------------------------------------------
+BDD BddAnalysis::project_on_c_vars(const BDD& check, const BDD& c_cube)
+{
+	// the support of check without the c vars
+	BDD other_vars = check.Support().ExistAbstract(c_cube);
+	return check.ExistAbstract(other_vars);
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::enumerate_c_cubes(const BDD& c_projection, int first_c_var, int last_c_var,
+		vector<vector<char> >& c_cubes)
+{
+	DdManager* manager = cudd_.getManager();
+	int* cube;
+	CUDD_VALUE_TYPE value;
+	DdGen* gen = Cudd_FirstCube(manager, c_projection.getNode(), &cube, &value);
+	MASSERT(gen != 0, "out of memory")
+	while (!Cudd_IsGenEmpty(gen))
 	{
-		latch_to_BDD_signal[*it] = binary_conjunct(binary_encoding, c_vars);
-		++binary_encoding;
+		vector<char> c_values;
+		c_values.reserve(last_c_var - first_c_var + 1);
+		for (int var = first_c_var; var <= last_c_var; ++var)
+			c_values.push_back(cube[var]);
+		c_cubes.push_back(c_values);
+		Cudd_NextCube(gen, &cube, &value);
 	}
+	Cudd_GenFree(gen);
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::decode_binary_c_cubes(const vector<vector<char> >& c_cubes,
+		set<unsigned>& codes)
+{
+	for (unsigned cube = 0; cube < c_cubes.size(); ++cube)
+	{
+		const vector<char>& c_values = c_cubes[cube];
+		unsigned num_of_c_vars = c_values.size();
+
+		unsigned code = 0;
+		vector<unsigned> dontcare_c_bits;
+		for (unsigned i = 0; i < num_of_c_vars; ++i)
+		{
+			unsigned bit_index = num_of_c_vars - 1 - i; // the most significant bit first
+			if (c_values[i] == 1)
+				code |= (1 << bit_index);
+			else if (c_values[i] == 2) // the bit is irrelevant for satisfiability
+				dontcare_c_bits.push_back(bit_index);
+		}
+
+		// create all codes the cube covers
+		for (unsigned concrete_vals = 0; concrete_vals < (1u << dontcare_c_bits.size());
+				concrete_vals++)
+		{
+			unsigned concrete_code = code;
+			for (unsigned i = 0; i < dontcare_c_bits.size(); i++)
+			{
+				if ((concrete_vals & (1 << i)) > 0) // bit set in combination?
+					concrete_code |= (1 << dontcare_c_bits[i]); // set the bit
+			}
+			codes.insert(concrete_code);
+		}
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::quantify_expired_input_vars(const BDD& state_support,
+		vector<int>& input_vars, BDD& side_constraints)
+{
+	BDD expired_cube = cudd_.bddOne();
+	vector<int> still_used;
+	for (unsigned i = 0; i < input_vars.size(); ++i)
+	{
+		BDD var = cudd_.bddVar(input_vars[i]);
+		if (state_support <= var) // the state still depends on this input
+			still_used.push_back(input_vars[i]);
+		else
+			expired_cube &= var;
+	}
+	if (still_used.size() == input_vars.size())
+		return;
+
+	side_constraints = side_constraints.ExistAbstract(expired_cube);
+	input_vars.swap(still_used);
+}
+
+void BddAnalysis::release_f_vars(const vector<int>& f_inputs)
+{
+	free_bdd_vars_.insert(free_bdd_vars_.end(), f_inputs.begin(), f_inputs.end());
+}
+
+void BddAnalysis::release_expired_f_vars(const BDD& state_support, vector<int>& f_inputs,
+		vector<BDD>& f_prime_bdd, BDD& side_constraints)
+{
+	BDD expired_cube = cudd_.bddOne();
+	unsigned num_alive = 0;
+	for (unsigned cnt = 0; cnt < f_inputs.size(); cnt++)
+	{
+		if (state_support <= f_prime_bdd[cnt]) // fi is in the support: still alive
+		{
+			f_inputs[num_alive] = f_inputs[cnt];
+			f_prime_bdd[num_alive] = f_prime_bdd[cnt];
+			num_alive++;
+		}
+		else
+		{
+			expired_cube &= f_prime_bdd[cnt];
+			free_bdd_vars_.push_back(f_inputs[cnt]);
+		}
+	}
+	if (num_alive == f_inputs.size())
+		return;
+
+	f_inputs.resize(num_alive);
+	f_prime_bdd.resize(num_alive);
+	side_constraints = side_constraints.ExistAbstract(expired_cube);
+}
+
+int BddAnalysis::create_binary_encoded_f_vars(const vector<TestCase>& testcases,
+		vector<BDD>& f_vars)
+{
+	size_t max_length = 0;
+	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
+		max_length = max(max_length, testcases[tc_number].size());
+
+	// one additional code (any value >= the test-case length) means 'no flip'
+	unsigned num_of_f_vars = ceil(log2(max_length + 1));
+
+	int first_f_var = next_free_cnf_var_;
+	f_vars.clear();
+	f_vars.reserve(num_of_f_vars);
+	for (unsigned f_cnt = 0; f_cnt < num_of_f_vars; ++f_cnt)
+		f_vars.push_back(cudd_.bddVar(next_free_cnf_var_++));
+
+	return first_f_var;
 }
 
 void BddAnalysis::analyze_binary_enc_c_signals(vector<TestCase>& testcases)
@@ -578,7 +827,9 @@ void BddAnalysis::analyze_binary_enc_c_signals(vector<TestCase>& testcases)
 
 	stopWatchStart();
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	vector<unsigned> l_list = getLatchesToCheck();
+	BddVariableOrder var_order(circuit_, Options::instance().getBddVariableOrder());
+	var_order.orderLatches(l_list);
 
 	// the binary logarithm of the number of latches is the number of c signals
 	unsigned num_of_c_vars = ceil(log2(l_list.size()));
@@ -594,7 +845,9 @@ void BddAnalysis::analyze_binary_enc_c_signals(vector<TestCase>& testcases)
 	// create the binary encoding for c vars
 	map<unsigned, BDD> latch_to_BDD_signal;
 	set<int> latches_to_check_(l_list.begin(), l_list.end());
-	create_binary_encoded_c_BDDs(c_vars, latch_to_BDD_signal, latches_to_check_);
+	vector<unsigned> code_to_latch;
+	create_binary_encoded_c_BDDs(c_vars, l_list, latch_to_BDD_signal, code_to_latch);
+	BDD c_cube = create_var_cube(first_cj_var, last_cj_var);
 	stopWatchStore(CREATE_C_SIGNALS);
 
 	AigSimulator sim_concrete_ok(circuit_);
@@ -603,6 +856,12 @@ void BddAnalysis::analyze_binary_enc_c_signals(vector<TestCase>& testcases)
 	// for each testcase-step
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
+		current_testcase_ = tc_number; // where to continue if a BDD limit is exceeded
+		if (isGlobalBudgetExceeded()) // BDD operations cannot be interrupted, check per test-case
+		{
+			markUndetectedLatchesUnknown(l_list);
+			break;
+		}
 		// f = a set of variables fi indicating whether the latch is *flipped in _step_ i* or not
 		vector<int> f_inputs;
 		vector<BDD> f_prime_bdd;
@@ -634,7 +893,7 @@ void BddAnalysis::analyze_binary_enc_c_signals(vector<TestCase>& testcases)
 			// fi indicates whether the component is flipped in step i or not
 			// there can only be a flip at time-step i if both cj and fi are true.
 
-			int fi = next_free_cnf_var_++;
+			int fi = allocate_bdd_var();
 			BDD fi_bdd = cudd_.bddVar(fi);
 
 			stopWatchStart();
@@ -714,100 +973,72 @@ void BddAnalysis::analyze_binary_enc_c_signals(vector<TestCase>& testcases)
 			BDD check = side_constraints & output_is_different_bdd;
 
 			stopWatchStart();
-			while (!check.IsZero())
+			bool is_sat = !check.IsZero();
+			stopWatchStore(SATISFIABILITY);
+			if (is_sat)
 			{
-				stopWatchStore(SATISFIABILITY);
-
+				// project all counterexamples onto the c vars at once and read the vulnerable
+				// latches from the projection, instead of extracting them one cube at a time
 				stopWatchStart();
-				check.PickOneCube(model); // store model
+				BDD c_projection = project_on_c_vars(check, c_cube);
+				vector<vector<char> > c_cubes;
+				enumerate_c_cubes(c_projection, first_cj_var, last_cj_var, c_cubes);
 				stopWatchStore(STORE_MODEL);
 
 				stopWatchStart();
-				// find the one and only true c-signal in model
-				vector<unsigned> dontcare_c_bits;
-				unsigned cj = 0;
-				unsigned bit_index = num_of_c_vars - 1;
-				BDD blocking_cube = cudd_.bddOne();
-				for (int i = first_cj_var; i <= last_cj_var; i++)
-				{
-					if (model[i] == 1)
-					{
-						cj |= (1 << bit_index);
-						blocking_cube &= c_vars[num_of_c_vars - 1 - bit_index];
-					}
-					else if (model[i] == 0)
-					{
-						blocking_cube &= ~c_vars[num_of_c_vars - 1 - bit_index];
-					}
-					else // input is irrelevant
-					{
-						dontcare_c_bits.push_back(bit_index);
-					}
-					bit_index--;
-				}
-				vector<unsigned> vulnerable_cj_combinations;
+				set<unsigned> vulnerable_codes;
+				decode_binary_c_cubes(c_cubes, vulnerable_codes);
+				stopWatchStore(PARSE_MODEL);
 
-				if (dontcare_c_bits.size() == 0) // no bits are irrelevant for satisfiability
-				{
-					vulnerable_cj_combinations.push_back(cj); // use the concrete value
-				}
-				else // create all possible c combinations
+				for (set<unsigned>::iterator it = vulnerable_codes.begin();
+						it != vulnerable_codes.end(); ++it)
 				{
-					for (unsigned concrete_vals = 0;
-							concrete_vals < pow(2, dontcare_c_bits.size()); concrete_vals++)
+					unsigned cj = *it;
+					if (cj >= code_to_latch.size())
+						continue; // unused code
+
+					if (Options::instance().isUseDiagnosticOutput())
 					{
-						unsigned concrete_cj = cj;
-						for (unsigned i = 0; i < dontcare_c_bits.size(); i++)
+						// a counterexample for this latch, to find the flip time-step
+						(check & binary_conjunct(cj, c_vars)).PickOneCube(model);
+						int fi = 0;
+						for (unsigned i = 0; i < f_inputs.size(); i++)
 						{
-							if ((concrete_vals & (1 << i)) > 0) // bit set in combination?
-								concrete_cj |= (1 << dontcare_c_bits[i]); // set the bit
+							if (model[f_inputs[i]] == 1)
+							{
+								fi = f_inputs[i];
+								break;
+							}
 						}
-						vulnerable_cj_combinations.push_back(concrete_cj);
-					}
-				}
 
-				// find the one and only true f-signal from model
-				int fi = 0;
-				for (unsigned i = 0; i < f_inputs.size(); i++)
-				{
-					if (model[f_inputs[i]] == 1)
-					{
-						fi = f_inputs[i];
-//						cout << "fi" << fi << "timestep" << fi_to_timestep[fi] << endl;
-						break;
-					}
-				}
-				stopWatchStore(PARSE_MODEL);
-				for (unsigned i = 0; i < vulnerable_cj_combinations.size(); i++)
-				{
-					cj = vulnerable_cj_combinations[i];
-//					latch_to_BDD_signal[cj] = cudd.bddZero(); // NO, DON't do this!!
-
-					if (Options::instance().isUseDiagnosticOutput())
-					{
 						ErrorTrace* trace = new ErrorTrace;
 
 						trace->error_timestep_ = timestep;
 						trace->input_trace_ = testcase;
-						trace->latch_index_ = circuit_->latches[cj].lit;
+						trace->latch_index_ = code_to_latch[cj];
 						trace->flipped_timestep_ = fi_to_timestep[fi];
 
-						ErrorTraceManager::instance().error_traces_.push_back(trace);
+						storeErrorTrace(trace);
 					}
 
-					detected_latches_.insert(circuit_->latches[cj].lit);
+					detected_latches_.insert(code_to_latch[cj]);
 				}
 
 				stopWatchStart();
-				side_constraints &= ~blocking_cube;
-
-				check = side_constraints & output_is_different_bdd;
+				side_constraints &= ~c_projection;
 				stopWatchStore(SIDE_CONSTRAINTS);
-
-				stopWatchStart(); // SATISFIABILITY
 			}
 
+			//--------------------------------------------------------------------------------------
+			// flips in time-steps the next state does not depend on can not cause any further
+			// errors: quantify their f vars out of the side constraints and recycle them
+			stopWatchStart();
+			release_expired_f_vars(computeStateSupport(circuit_, cudd_, bddSim), f_inputs,
+					f_prime_bdd, side_constraints);
+			stopWatchStore(SIDE_CONSTRAINTS);
+
 		} // -- END "for each timestep in testcase" --
+		release_f_vars(f_inputs);
 	} // ------ END 'for each testcase' ---------------
 
 	free(model);
@@ -821,7 +1052,9 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals(vector<TestCase>& testcases
 
 	stopWatchStart();
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	vector<unsigned> l_list = getLatchesToCheck();
+	BddVariableOrder var_order(circuit_, Options::instance().getBddVariableOrder());
+	var_order.orderLatches(l_list);
 
 	// the binary logarithm of the number of latches is the number of c signals
 	unsigned num_of_c_vars = ceil(log2(l_list.size()));
@@ -837,15 +1070,30 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals(vector<TestCase>& testcases
 	// create the binary encoding for c vars
 	map<unsigned, BDD> latch_to_BDD_signal;
 	set<int> latches_to_check_(l_list.begin(), l_list.end());
-	create_binary_encoded_c_BDDs(c_vars, latch_to_BDD_signal, latches_to_check_);
+	vector<unsigned> code_to_latch;
+	create_binary_encoded_c_BDDs(c_vars, l_list, latch_to_BDD_signal, code_to_latch);
+	BDD c_cube = create_var_cube(first_cj_var, last_cj_var);
 	stopWatchStore(CREATE_C_SIGNALS);
 
 	AigSimulator sim_concrete_ok(circuit_);
 	BddSimulator2 bddSim(circuit_, cudd_, next_free_cnf_var_);
 
+	// the flip time-step is encoded with a fixed number of f vars shared by all test-cases
+	vector<BDD> f_vars;
+	int first_f_var = create_binary_encoded_f_vars(testcases, f_vars);
+	unsigned num_of_f_vars = f_vars.size();
+	int last_f_var = first_f_var + num_of_f_vars - 1;
+	var_order.apply(cudd_, first_cj_var, first_f_var, num_of_f_vars);
+
 	// for each testcase-step
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
+		current_testcase_ = tc_number; // where to continue if a BDD limit is exceeded
+		if (isGlobalBudgetExceeded()) // BDD operations cannot be interrupted, check per test-case
+		{
+			markUndetectedLatchesUnknown(l_list);
+			break;
+		}
 		BDD side_constraints = cudd_.bddOne();
 
 		sim_concrete_ok.initLatches();
@@ -855,17 +1103,19 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals(vector<TestCase>& testcases
 
 		TestCase& testcase = testcases[tc_number];
 
-		unsigned num_of_f_vars = ceil(log2(testcase.size() + 1));
-		int first_f_var = next_free_cnf_var_;
-		int last_f_var = first_f_var + num_of_f_vars - 1;
-		vector<BDD> f_vars;
-		f_vars.reserve(num_of_f_vars);
-		for (unsigned f_cnt = 0; f_cnt < num_of_f_vars; ++f_cnt)
-			f_vars.push_back(cudd_.bddVar(next_free_cnf_var_++));
-
 		for (unsigned timestep = 0; timestep < testcase.size(); timestep++)
 		{ // -------- BEGIN "for each timestep in testcase" --------------------------------------
 
+			if (mode_ == C_F_BINARY_HYBRID
+					&& Cudd_ReadNodeCount(cudd_.getManager()) > (long) Options::instance().getHybridNodeLimit())
+			{
+				// the BDDs get too large: continue this test-case with the SAT solver
+				analyze_remaining_steps_with_sat(testcase, timestep, sim_concrete_ok, bddSim,
+						side_constraints, c_vars, f_vars, latches_to_check_, latch_to_BDD_signal,
+						code_to_latch);
+				break;
+			}
+
 			//--------------------------------------------------------------------------------------
 			// Concrete simulations:
 			sim_concrete_ok.simulateOneTimeStep(testcase[timestep]);
@@ -946,98 +1196,59 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals(vector<TestCase>& testcases
 			BDD check = side_constraints & output_is_different_bdd;
 
 			stopWatchStart();
-			while (!check.IsZero())
+			bool is_sat = !check.IsZero();
+			stopWatchStore(SATISFIABILITY);
+			if (is_sat)
 			{
-				stopWatchStore(SATISFIABILITY);
-
+				// project all counterexamples onto the c vars at once and read the vulnerable
+				// latches from the projection, instead of extracting them one cube at a time
 				stopWatchStart();
-				check.PickOneCube(model); // store model
+				BDD c_projection = project_on_c_vars(check, c_cube);
+				vector<vector<char> > c_cubes;
+				enumerate_c_cubes(c_projection, first_cj_var, last_cj_var, c_cubes);
 				stopWatchStore(STORE_MODEL);
 
 				stopWatchStart();
-				// find the one and only true c-signal in model
-				vector<unsigned> dontcare_c_bits;
-				unsigned cj = 0;
-				unsigned bit_index = num_of_c_vars - 1;
-				BDD blocking_cube = cudd_.bddOne();
-				for (int i = first_cj_var; i <= last_cj_var; i++)
-				{
-					if (model[i] == 1)
-					{
-						cj |= (1 << bit_index);
-						blocking_cube &= c_vars[num_of_c_vars - 1 - bit_index];
-					}
-					else if (model[i] == 0)
-					{
-						blocking_cube &= ~c_vars[num_of_c_vars - 1 - bit_index];
-					}
-					else // input is irrelevant
-					{
-						dontcare_c_bits.push_back(bit_index);
-					}
-					bit_index--;
-				}
-				vector<unsigned> vulnerable_cj_combinations;
+				set<unsigned> vulnerable_codes;
+				decode_binary_c_cubes(c_cubes, vulnerable_codes);
+				stopWatchStore(PARSE_MODEL);
 
-				if (dontcare_c_bits.size() == 0) // no bits are irrelevant for satisfiability
+				for (set<unsigned>::iterator it = vulnerable_codes.begin();
+						it != vulnerable_codes.end(); ++it)
 				{
-					vulnerable_cj_combinations.push_back(cj); // use the concrete value
-				}
-				else // create all possible c combinations
-				{
-					for (unsigned concrete_vals = 0;
-							concrete_vals < pow(2, dontcare_c_bits.size()); concrete_vals++)
+					unsigned cj = *it;
+					if (cj >= code_to_latch.size())
+						continue; // unused code
+
+					if (Options::instance().isUseDiagnosticOutput())
 					{
-						unsigned concrete_cj = cj;
-						for (unsigned i = 0; i < dontcare_c_bits.size(); i++)
+						// a counterexample for this latch, to find the flip time-step
+						(check & binary_conjunct(cj, c_vars)).PickOneCube(model);
+						int flip_timestep = 0;
+						unsigned bit_index = 0;
+						for (int i = first_f_var; i <= last_f_var; i++)
 						{
-							if ((concrete_vals & (1 << i)) > 0) // bit set in combination?
-								concrete_cj |= (1 << dontcare_c_bits[i]); // set the bit
+							if (model[i] == 1)
+								flip_timestep |= (1 << (num_of_f_vars - 1 - bit_index));
+							bit_index++;
 						}
-						vulnerable_cj_combinations.push_back(concrete_cj);
-					}
-				}
 
-				// find the one and only true f-signal from model
-				int flip_timestep = 0;
-				bit_index = 0;
-				for (int i = first_f_var; i <= last_f_var; i++)
-				{
-					if (model[i] == 1)
-					{
-						flip_timestep |= (1 << (num_of_f_vars - 1 - bit_index));
-					}
-					bit_index++;
-				}
-//				cout << "flip timestep = " << flip_timestep << endl;
-				stopWatchStore(PARSE_MODEL);
-				for (unsigned i = 0; i < vulnerable_cj_combinations.size(); i++)
-				{
-					cj = vulnerable_cj_combinations[i];
-//					latch_to_BDD_signal[cj] = cudd.bddZero(); // NO, DON't do this!!
-
-					if (Options::instance().isUseDiagnosticOutput())
-					{
 						ErrorTrace* trace = new ErrorTrace;
 
 						trace->error_timestep_ = timestep;
 						trace->input_trace_ = testcase;
-						trace->latch_index_ = circuit_->latches[cj].lit;
+						trace->latch_index_ = code_to_latch[cj];
 						trace->flipped_timestep_ = flip_timestep;
 
-						ErrorTraceManager::instance().error_traces_.push_back(trace);
+						storeErrorTrace(trace);
 					}
 
-					detected_latches_.insert(circuit_->latches[cj].lit);
+					detected_latches_.insert(code_to_latch[cj]);
 				}
 
 				stopWatchStart();
-				side_constraints &= ~blocking_cube;
-
-				check = side_constraints & output_is_different_bdd;
+				side_constraints &= ~c_projection;
 				stopWatchStore(SIDE_CONSTRAINTS);
-
-				stopWatchStart(); // SATISFIABILITY
 			}
 
 		} // -- END "for each timestep in testcase" --
@@ -1047,6 +1258,157 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals(vector<TestCase>& testcases
 }
 
 
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::analyze_remaining_steps_with_sat(TestCase& testcase, unsigned first_timestep,
+		AigSimulator& sim_concrete_ok, BddSimulator2& bddSim, const BDD& side_constraints,
+		const vector<BDD>& c_vars, const vector<BDD>& f_vars, const set<int>& latches_to_check,
+		map<unsigned, BDD>& latch_to_BDD_signal, const vector<unsigned>& code_to_latch)
+{
+	L_DBG("hybrid: " << Cudd_ReadNodeCount(cudd_.getManager())
+			<< " BDD nodes, switching to SAT in time-step " << first_timestep)
+
+	int next_free_cnf_var = 2;
+	vector<int> c_lits;
+	for (unsigned k = 0; k < c_vars.size(); ++k)
+		c_lits.push_back(next_free_cnf_var++);
+	vector<int> f_lits;
+	for (unsigned k = 0; k < f_vars.size(); ++k)
+		f_lits.push_back(next_free_cnf_var++);
+	vector<int> vars_of_interest(c_lits);
+	vars_of_interest.insert(vars_of_interest.end(), f_lits.begin(), f_lits.end());
+
+	SatSolver* solver = Options::instance().getSATSolver();
+	solver->startIncrementalSession(vars_of_interest, false);
+	startLatchBudget(solver); // all latches at once, only the conflict limit applies
+	solver->addVarToKeep(abs(CNF_TRUE));
+	solver->incAddUnitClause(CNF_TRUE); // CNF_TRUE= unit-clause representing TRUE constant
+
+	// the state and the side constraints only depend on the c and f vars (the inputs are
+	// concrete), so they can be translated into CNF over the corresponding CNF variables
+	BddCnfBridge bridge(solver, next_free_cnf_var);
+	for (unsigned k = 0; k < c_vars.size(); ++k)
+		bridge.setVarLiteral(c_vars[k].NodeReadIndex(), c_lits[k]);
+	for (unsigned k = 0; k < f_vars.size(); ++k)
+		bridge.setVarLiteral(f_vars[k].NodeReadIndex(), f_lits[k]);
+
+	SymbolicSimulator symbsim(circuit_, solver, next_free_cnf_var);
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		unsigned latch_var = circuit_->latches[l].lit >> 1;
+		int latch_lit = bridge.encode(bddSim.getResultValue(latch_var));
+		solver->addVarToKeep(abs(latch_lit));
+		symbsim.setResultValue(latch_var, latch_lit);
+	}
+	solver->incAddUnitClause(bridge.encode(side_constraints));
+
+	map<int, int> latch_to_c_lit; // the CNF literal of the binary code of each latch
+	for (set<int>::const_iterator it = latches_to_check.begin(); it != latches_to_check.end(); ++it)
+	{
+		latch_to_c_lit[*it] = bridge.encode(latch_to_BDD_signal[*it]);
+		solver->addVarToKeep(abs(latch_to_c_lit[*it]));
+	}
+
+	// a set of literals to enable or disable the represented output_is_different clauses
+	// (see SymbTimeLocationAnalysis)
+	vector<int> odiff_enable_literals;
+
+	for (unsigned timestep = first_timestep; timestep < testcase.size(); timestep++)
+	{ // -------- BEGIN "for each timestep in testcase" --------------------------------------
+		sim_concrete_ok.simulateOneTimeStep(testcase[timestep]);
+		vector<int> outputs_ok = sim_concrete_ok.getOutputs();
+		sim_concrete_ok.switchToNextState();
+
+		symbsim.setInputValues(testcase[timestep]);
+
+		// flip a latch iff both fi and its code are true
+		int fi = bridge.encode(binary_conjunct(timestep, f_vars));
+		solver->addVarToKeep(abs(fi));
+		for (set<int>::const_iterator it = latches_to_check.begin(); it != latches_to_check.end();
+				++it)
+		{
+			int latch_output = *it >> 1;
+			symbsim.flipLatchIf(latch_output, latch_to_c_lit[*it], fi);
+		}
+
+		symbsim.simulateOneTimeStep();
+		solver->incAddUnitClause(-symbsim.getAlarmValue());
+		vector<int> out_cnf_values = symbsim.getOutputValues();
+		symbsim.switchToNextState();
+
+		// clause saying that the outputs_ok o and o' are different
+		vector<int> o_is_diff_clause;
+		o_is_diff_clause.reserve(out_cnf_values.size() + 1);
+		for (unsigned out_idx = 0; out_idx < out_cnf_values.size(); ++out_idx)
+		{
+			if (outputs_ok[out_idx] == AIG_TRUE) // simulation result of output is true
+				o_is_diff_clause.push_back(-out_cnf_values[out_idx]); // add negated output
+			else if (outputs_ok[out_idx] == AIG_FALSE)
+				o_is_diff_clause.push_back(out_cnf_values[out_idx]);
+		}
+		int o_is_diff_enable_literal = next_free_cnf_var++;
+		o_is_diff_clause.push_back(o_is_diff_enable_literal);
+		odiff_enable_literals.push_back(-o_is_diff_enable_literal);
+		solver->addVarToKeep(o_is_diff_enable_literal);
+		solver->incAddClause(o_is_diff_clause);
+
+		vector<int> model;
+		while (solver->incIsSatModelOrCore(odiff_enable_literals, vars_of_interest, model))
+		{
+			// decode the code of the flipped latch (and the flip time-step), block the code
+			unsigned code = 0;
+			vector<int> blocking_clause;
+			for (unsigned k = 0; k < c_lits.size(); ++k)
+			{
+				bool bit = find(model.begin(), model.end(), c_lits[k]) != model.end();
+				if (bit)
+					code |= (1 << (c_lits.size() - 1 - k));
+				blocking_clause.push_back(bit ? -c_lits[k] : c_lits[k]);
+			}
+			unsigned flip_timestep = 0;
+			for (unsigned k = 0; k < f_lits.size(); ++k)
+			{
+				if (find(model.begin(), model.end(), f_lits[k]) != model.end())
+					flip_timestep |= (1 << (f_lits.size() - 1 - k));
+			}
+
+			if (code < code_to_latch.size())
+			{
+				if (Options::instance().isUseDiagnosticOutput())
+				{
+					ErrorTrace* trace = new ErrorTrace;
+
+					trace->error_timestep_ = timestep;
+					trace->input_trace_ = testcase;
+					trace->latch_index_ = code_to_latch[code];
+					trace->flipped_timestep_ = flip_timestep;
+
+					storeErrorTrace(trace);
+				}
+				detected_latches_.insert(code_to_latch[code]);
+			}
+
+			if (blocking_clause.empty()) // there is only one latch and it is detected now
+			{
+				delete solver;
+				return;
+			}
+			solver->incAddClause(blocking_clause);
+			model.clear();
+		}
+
+		if (solver->isLastResultUnknown() || isGlobalBudgetExceeded())
+		{
+			markUndetectedLatchesUnknown(code_to_latch);
+			break;
+		}
+
+		// disable the newest output_is_different clause for the next time-steps
+		odiff_enable_literals.back() = -odiff_enable_literals.back();
+	} // -- END "for each timestep in testcase" --
+
+	delete solver;
+}
+
 void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase>& testcases)
 {
 
@@ -1056,7 +1418,9 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase
 
 	stopWatchStart();
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	vector<unsigned> l_list = getLatchesToCheck();
+	BddVariableOrder var_order(circuit_, Options::instance().getBddVariableOrder());
+	var_order.orderLatches(l_list);
 
 	// the binary logarithm of the number of latches is the number of c signals
 	unsigned num_of_c_vars = ceil(log2(l_list.size()));
@@ -1072,15 +1436,30 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase
 	// create the binary encoding for c vars
 	map<unsigned, BDD> latch_to_BDD_signal;
 	set<int> latches_to_check_(l_list.begin(), l_list.end());
-	create_binary_encoded_c_BDDs(c_vars, latch_to_BDD_signal, latches_to_check_);
+	vector<unsigned> code_to_latch;
+	create_binary_encoded_c_BDDs(c_vars, l_list, latch_to_BDD_signal, code_to_latch);
+	BDD c_cube = create_var_cube(first_cj_var, last_cj_var);
 	stopWatchStore(CREATE_C_SIGNALS);
 
 	BddSimulator sim_ok(circuit_,cudd_,next_free_cnf_var_);
 	BddSimulator bddSim(circuit_, cudd_, next_free_cnf_var_);
 
+	// the flip time-step is encoded with a fixed number of f vars shared by all test-cases
+	vector<BDD> f_vars;
+	int first_f_var = create_binary_encoded_f_vars(testcases, f_vars);
+	unsigned num_of_f_vars = f_vars.size();
+	int last_f_var = first_f_var + num_of_f_vars - 1;
+	var_order.apply(cudd_, first_cj_var, first_f_var, num_of_f_vars);
+
 	// for each testcase-step
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
+		current_testcase_ = tc_number; // where to continue if a BDD limit is exceeded
+		if (isGlobalBudgetExceeded()) // BDD operations cannot be interrupted, check per test-case
+		{
+			markUndetectedLatchesUnknown(l_list);
+			break;
+		}
 		BDD side_constraints = cudd_.bddOne();
 
 		sim_ok.initLatches();
@@ -1090,15 +1469,8 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase
 
 		TestCase& testcase = testcases[tc_number];
 
-		unsigned num_of_f_vars = ceil(log2(testcase.size() + 1));
-		int first_f_var = next_free_cnf_var_;
-		int last_f_var = first_f_var + num_of_f_vars - 1;
-		vector<BDD> f_vars;
-		f_vars.reserve(num_of_f_vars);
-		for (unsigned f_cnt = 0; f_cnt < num_of_f_vars; ++f_cnt)
-			f_vars.push_back(cudd_.bddVar(next_free_cnf_var_++));
-
 		TestCase real_cnf_inputs; // replaces all unknown input values in the test case with cnf literals
+		vector<int> open_input_vars; // the free input vars that are not quantified yet
 		for (unsigned timestep = 0; timestep < testcase.size(); timestep++)
 		{ // -------- BEGIN "for each timestep in testcase" --------------------------------------
 
@@ -1115,6 +1487,12 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase
 			// set input values according to TestCase to TRUE or FALSE or same open input literal:
 			bddSim.setBddInputValues(sim_ok.getInputValues());
 			real_cnf_inputs.push_back(sim_ok.getCurrentCnfInputLiterals());
+			const vector<int>& step_inputs = sim_ok.getCurrentCnfInputLiterals();
+			for (unsigned i = 0; i < step_inputs.size(); ++i)
+			{
+				if (step_inputs[i] != CNF_TRUE && step_inputs[i] != CNF_FALSE) // a '?' input
+					open_input_vars.push_back(step_inputs[i]);
+			}
 
 
 			//--------------------------------------------------------------------------------------
@@ -1185,84 +1563,51 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase
 
 			//--------------------------------------------------------------------------------------
 			// check satisfiability
-			BDD check = side_constraints & output_is_different_bdd;
-
+			// the conjunction and the projection onto the c vars are computed in one step
+			// (relational product), so the conjunction over all free inputs is never built
 			stopWatchStart();
-			while (!check.IsZero())
+			BDD non_c_vars = (side_constraints.Support() & output_is_different_bdd.Support())
+					.ExistAbstract(c_cube);
+			BDD c_projection = side_constraints.AndAbstract(output_is_different_bdd, non_c_vars);
+			bool is_sat = !c_projection.IsZero();
+			stopWatchStore(SATISFIABILITY);
+			if (is_sat)
 			{
-				stopWatchStore(SATISFIABILITY);
-
 				stopWatchStart();
-				check.PickOneCube(model); // store model
+				vector<vector<char> > c_cubes;
+				enumerate_c_cubes(c_projection, first_cj_var, last_cj_var, c_cubes);
 				stopWatchStore(STORE_MODEL);
 
 				stopWatchStart();
-				// find the one and only true c-signal in model
-				vector<unsigned> dontcare_c_bits;
-				unsigned cj = 0;
-				unsigned bit_index = num_of_c_vars - 1;
-				BDD blocking_cube = cudd_.bddOne();
-				for (int i = first_cj_var; i <= last_cj_var; i++)
-				{
-					if (model[i] == 1)
-					{
-						cj |= (1 << bit_index);
-						blocking_cube &= c_vars[num_of_c_vars - 1 - bit_index];
-					}
-					else if (model[i] == 0)
-					{
-						blocking_cube &= ~c_vars[num_of_c_vars - 1 - bit_index];
-					}
-					else // input is irrelevant
-					{
-						dontcare_c_bits.push_back(bit_index);
-					}
-					bit_index--;
-				}
-				vector<unsigned> vulnerable_cj_combinations;
-				if (dontcare_c_bits.size() == 0) // no bits are irrelevant for satisfiability
-				{
-					vulnerable_cj_combinations.push_back(cj); // use the concrete value
-				}
-				else // create all possible c combinations
-				{
-					for (unsigned concrete_vals = 0;
-							concrete_vals < pow(2, dontcare_c_bits.size()); concrete_vals++)
-					{
-						unsigned concrete_cj = cj;
-						for (unsigned i = 0; i < dontcare_c_bits.size(); i++)
-						{
-							if ((concrete_vals & (1 << i)) > 0) // bit set in combination?
-								concrete_cj |= (1 << dontcare_c_bits[i]); // set the bit
-						}
-						vulnerable_cj_combinations.push_back(concrete_cj);
-					}
-				}
-
-				// find the one and only true f-signal from model
-				int flip_timestep = 0;
-				bit_index = 0;
-				for (int i = first_f_var; i <= last_f_var; i++)
-				{
-					if (model[i] == 1)
-					{
-						flip_timestep |= (1 << (num_of_f_vars - 1 - bit_index));
-					}
-					bit_index++;
-				}
-//				cout << "flip timestep = " << flip_timestep << endl;
+				set<unsigned> vulnerable_codes;
+				decode_binary_c_cubes(c_cubes, vulnerable_codes);
 				stopWatchStore(PARSE_MODEL);
-				for (unsigned i = 0; i < vulnerable_cj_combinations.size(); i++)
+
+				for (set<unsigned>::iterator it = vulnerable_codes.begin();
+						it != vulnerable_codes.end(); ++it)
 				{
-					cj = vulnerable_cj_combinations[i];
-//					latch_to_BDD_signal[cj] = cudd.bddZero(); // NO, DON't do this!!
+					unsigned cj = *it;
+					if (cj >= code_to_latch.size())
+						continue; // unused code
 
 					if (Options::instance().isUseDiagnosticOutput())
 					{
+						// a counterexample for this latch, to find the flip time-step
+						(side_constraints & output_is_different_bdd & binary_conjunct(cj, c_vars))
+								.PickOneCube(model);
+						int flip_timestep = 0;
+						unsigned bit_index = 0;
+						for (int i = first_f_var; i <= last_f_var; i++)
+						{
+							if (model[i] == 1)
+								flip_timestep |= (1 << (num_of_f_vars - 1 - bit_index));
+							bit_index++;
+						}
+
 						ErrorTrace* trace = new ErrorTrace;
 
 						trace->error_timestep_ = timestep;
-						trace->latch_index_ = circuit_->latches[cj].lit;
+						trace->latch_index_ = code_to_latch[cj];
 						trace->flipped_timestep_ = flip_timestep;
 
 						//trace->input_trace_ = testcase;
@@ -1288,21 +1633,26 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase
 							real_input_values.push_back(real_input_vector);
 						}
 
-						ErrorTraceManager::instance().error_traces_.push_back(trace);
+						storeErrorTrace(trace);
 					}
 
-					detected_latches_.insert(circuit_->latches[cj].lit);
+					detected_latches_.insert(code_to_latch[cj]);
 				}
 
 				stopWatchStart();
-				side_constraints &= ~blocking_cube;
-
-				check = side_constraints & output_is_different_bdd;
+				side_constraints &= ~c_projection;
 				stopWatchStore(SIDE_CONSTRAINTS);
-
-				stopWatchStart(); // SATISFIABILITY
 			}
 
+			//--------------------------------------------------------------------------------------
+			// free inputs the next state does not depend on only occur in the side constraints:
+			// quantify them out early, so the BDDs do not grow with the number of '?' inputs
+			stopWatchStart();
+			BDD state_support = computeStateSupport(circuit_, cudd_, bddSim)
+					& computeStateSupport(circuit_, cudd_, sim_ok);
+			quantify_expired_input_vars(state_support, open_input_vars, side_constraints);
+			stopWatchStore(SIDE_CONSTRAINTS);
+
 		} // -- END "for each timestep in testcase" --
 	} // ------ END 'for each testcase' ---------------
 
@@ -1310,17 +1660,183 @@ void BddAnalysis::analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase
 }
 
 
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::setMemoryLimits()
+{
+	DdManager* manager = cudd_.getManager();
+	unsigned long max_mem_mb = Options::instance().getBddMaxMemory();
+	if (max_mem_mb > 0)
+		Cudd_SetMaxMemory(manager, max_mem_mb * 1024 * 1024);
+	unsigned max_nodes = Options::instance().getBddMaxNodes();
+	if (max_nodes > 0)
+		Cudd_SetMaxLive(manager, max_nodes);
+
+	// sifting is only started when the number of nodes exceeds the threshold
+	unsigned reorder_threshold = Options::instance().getBddReorderThreshold();
+	if (reorder_threshold > 0)
+	{
+		Cudd_AutodynEnable(manager, CUDD_REORDER_SIFT);
+		Cudd_SetNextReordering(manager, reorder_threshold);
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+// the fallback of several partitions (see analyzePartitioned()) must not run concurrently,
+// 'stla' writes to the ErrorTraceManager directly
+static pthread_mutex_t fallback_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::fallbackToSymbTimeLocation(vector<TestCase>& testcases)
+{
+	pthread_mutex_lock(&fallback_mutex);
+	Cudd_ClearErrorCode(cudd_.getManager());
+
+	// the test-cases before current_testcase_ are done for all latches, the BDD results are valid
+	vector<TestCase> remaining(testcases.begin() + current_testcase_, testcases.end());
+	int stla_mode = SymbTimeLocationAnalysis::STANDARD;
+	if (mode_ == C_F_BINARY_FREE_INPUTS)
+		stla_mode = SymbTimeLocationAnalysis::FREE_INPUTS;
+
+	SymbTimeLocationAnalysis stla(circuit_, num_err_latches_, stla_mode);
+	stla.disableJournal(); // the indices of 'remaining' are not the ones of the journal
+	stla.setLatchesToCheck(latch_subset_); // a partition only falls back for its own latches
+	stla.analyze(remaining);
+	const set<unsigned>& stla_detected = stla.getDetectedLatches();
+	L_LOG("'stla' analyzed " << remaining.size() << " test-cases, found " << stla_detected.size())
+	detected_latches_.insert(stla_detected.begin(), stla_detected.end());
+	const set<unsigned>& stla_unknown = stla.getUnknownLatches();
+	unknown_latches_.insert(stla_unknown.begin(), stla_unknown.end());
+	pthread_mutex_unlock(&fallback_mutex);
+}
+
+// -------------------------------------------------------------------------------------------
+vector<unsigned> BddAnalysis::getLatchesToCheck()
+{
+	if (!latch_subset_.empty())
+		return latch_subset_;
+	return Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::storeErrorTrace(ErrorTrace* trace)
+{
+	if (latch_subset_.empty())
+		ErrorTraceManager::instance().error_traces_.push_back(trace);
+	else // running in a thread of analyzePartitioned(), the traces are collected afterwards
+		partition_traces_.push_back(trace);
+}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the work of one thread of BddAnalysis::analyzePartitioned()
+struct BddPartition
+{
+	BddAnalysis* analysis_;
+	vector<TestCase>* testcases_;
+	pthread_t thread_;
+};
+
+// -------------------------------------------------------------------------------------------
+static void* analyzePartition(void* partition)
+{
+	BddPartition* p = static_cast<BddPartition*>(partition);
+	p->analysis_->analyze(*(p->testcases_));
+	return 0;
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::analyzePartitioned(vector<TestCase>& testcases, unsigned num_partitions)
+{
+	// neighbouring latches in this order share much of their fan-in, so contiguous groups keep
+	// the BDDs of each group small
+	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	BddVariableOrder var_order(circuit_, BddVariableOrder::FANIN_DFS);
+	var_order.orderLatches(l_list);
+
+	if (num_partitions > l_list.size())
+		num_partitions = l_list.size();
+	L_DBG("analyzing " << l_list.size() << " latches in " << num_partitions << " partitions")
+
+	// the managers are created here, the threads only use their own one
+	vector<BddPartition> partitions(num_partitions);
+	for (unsigned p = 0; p < num_partitions; ++p)
+	{
+		unsigned begin = (l_list.size() * p) / num_partitions;
+		unsigned end = (l_list.size() * (p + 1)) / num_partitions;
+		partitions[p].analysis_ = new BddAnalysis(circuit_, num_err_latches_, mode_);
+		partitions[p].analysis_->latch_subset_.assign(l_list.begin() + begin, l_list.begin() + end);
+		partitions[p].testcases_ = &testcases;
+	}
+
+	for (unsigned p = 0; p < num_partitions; ++p)
+	{
+		int rc = pthread_create(&partitions[p].thread_, 0, analyzePartition, &partitions[p]);
+		MASSERT(rc == 0, "could not create a thread for the BDD analysis")
+	}
+
+	for (unsigned p = 0; p < num_partitions; ++p)
+		pthread_join(partitions[p].thread_, 0);
+
+	// merge the results in the order of the partitions, so the output is deterministic
+	for (unsigned p = 0; p < num_partitions; ++p)
+	{
+		BddAnalysis* analysis = partitions[p].analysis_;
+		const set<unsigned>& detected = analysis->getDetectedLatches();
+		L_DBG("partition " << p << ": " << analysis->latch_subset_.size() << " latches, "
+				<< detected.size() << " detected")
+		detected_latches_.insert(detected.begin(), detected.end());
+		const set<unsigned>& unknown = analysis->getUnknownLatches();
+		unknown_latches_.insert(unknown.begin(), unknown.end());
+		vector<ErrorTrace*>& traces = ErrorTraceManager::instance().error_traces_;
+		traces.insert(traces.end(), analysis->partition_traces_.begin(),
+				analysis->partition_traces_.end());
+		if (useStatistics_)
+			mergeStatistics(*analysis);
+		delete analysis;
+	}
+}
+
 // -------------------------------------------------------------------------------------------
 BddAnalysis::~BddAnalysis()
 {
 
 }
 
+// -------------------------------------------------------------------------------------------
+/// @brief the names of BddAnalysis::Statistic, in the order of the enum
+static const char* const STAT_NAMES[] =
+{ "CREATE_C_SIGNALS", "SIM_ANDs", "SWITCH_NXT_ST", "OUT_IS_DIFF", "SATISFIABILITY",
+		"STORE_MODEL", "INIT_Latches", "SIDE_CONSTRAINTS", "MODIFY_LATCHES", "PARSE_MODEL" };
+
+// -------------------------------------------------------------------------------------------
+/// @brief the keys of the whole-run CUDD counters in the --bdd_stats file, in output order
+static const char* const MANAGER_KEYS[] =
+{ "cudd.vars", "cudd.peak_nodes", "cudd.peak_live_nodes", "cudd.memory_in_use",
+		"cudd.unique_slots", "cudd.unique_keys", "cudd.unique_dead", "cudd.cache_slots",
+		"cudd.cache_lookups", "cudd.cache_hits", "cudd.gc_count", "cudd.gc_ms", "cudd.reorderings",
+		"cudd.reorder_ms" };
+static const unsigned NUM_MANAGER_KEYS = sizeof(MANAGER_KEYS) / sizeof(MANAGER_KEYS[0]);
+
+// -------------------------------------------------------------------------------------------
+BddAnalysis::CuddCounters BddAnalysis::readCuddCounters()
+{
+	DdManager* manager = cudd_.getManager();
+	CuddCounters counters;
+	counters.gcs_ = Cudd_ReadGarbageCollections(manager);
+	counters.gc_time_ = Cudd_ReadGarbageCollectionTime(manager);
+	counters.reorder_time_ = Cudd_ReadReorderingTime(manager);
+	counters.cache_lookups_ = Cudd_ReadCacheLookUps(manager);
+	counters.cache_hits_ = Cudd_ReadCacheHits(manager);
+	return counters;
+}
+
+// -------------------------------------------------------------------------------------------
 void BddAnalysis::stopWatchStart()
 {
 	if (!useStatistics_)
 		return;
 
+	start_counters_ = readCuddCounters();
 	start_time_ = Stopwatch::start();
 }
 
@@ -1339,6 +1855,14 @@ void BddAnalysis::stopWatchStore(Statistic statistic)
 	{
 		accumulated_durations_[statistic] = duration;
 	}
+
+	CuddCounters now = readCuddCounters();
+	CuddCounters& sum = accumulated_cudd_counters_[statistic]; // zero-initialized if new
+	sum.gcs_ += now.gcs_ - start_counters_.gcs_;
+	sum.gc_time_ += now.gc_time_ - start_counters_.gc_time_;
+	sum.reorder_time_ += now.reorder_time_ - start_counters_.reorder_time_;
+	sum.cache_lookups_ += now.cache_lookups_ - start_counters_.cache_lookups_;
+	sum.cache_hits_ += now.cache_hits_ - start_counters_.cache_hits_;
 }
 
 void BddAnalysis::printStatistics(PointInTime begin)
@@ -1346,10 +1870,6 @@ void BddAnalysis::printStatistics(PointInTime begin)
 	if (!useStatistics_)
 		return;
 
-	const string stat_name[] =
-	{ "CREATE_C_SIGNALS", "SIM_ANDs", "SWITCH_NXT_ST", "OUT_IS_DIFF", "SATISFIABILITY",
-			"STORE_MODEL", "INIT_Latches", "SIDE_CONSTRAINTS", "MODIFY_LATCHES", "PARSE_MODEL" };
-
 	double total_time = Stopwatch::getCPUTimeMilliSec(begin);
 	double in_stats = 0.0;
 	L_DBG(endl << "--------------------------")
@@ -1357,8 +1877,79 @@ void BddAnalysis::printStatistics(PointInTime begin)
 	map<Statistic, double>::iterator it = accumulated_durations_.begin();
 	for (; it != accumulated_durations_.end(); ++it)
 	{
-		L_DBG(stat_name[it->first] <<" " << it->second);
+		L_DBG(STAT_NAMES[it->first] <<" " << it->second);
 		in_stats += it->second;
 	}
 	L_DBG("uncategorized " << (total_time - in_stats));
+
+	if (latch_subset_.empty()) // partitions (see analyzePartitioned()) do not write the file
+		writeStatistics(total_time);
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::addManagerCounters(map<string, double>& totals)
+{
+	DdManager* manager = cudd_.getManager();
+	const double values[] =
+	{ (double) cudd_.ReadSize(), (double) Cudd_ReadPeakNodeCount(manager),
+			(double) Cudd_ReadPeakLiveNodeCount(manager), (double) Cudd_ReadMemoryInUse(manager),
+			(double) Cudd_ReadSlots(manager), (double) Cudd_ReadKeys(manager),
+			(double) Cudd_ReadDead(manager), (double) Cudd_ReadCacheSlots(manager),
+			Cudd_ReadCacheLookUps(manager), Cudd_ReadCacheHits(manager),
+			(double) Cudd_ReadGarbageCollections(manager),
+			(double) Cudd_ReadGarbageCollectionTime(manager), (double) Cudd_ReadReorderings(manager),
+			(double) Cudd_ReadReorderingTime(manager) };
+	for (unsigned k = 0; k < NUM_MANAGER_KEYS; ++k)
+		totals[MANAGER_KEYS[k]] += values[k]; // zero-initialized if new
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::mergeStatistics(BddAnalysis& partition)
+{
+	partition.addManagerCounters(partition_manager_counters_);
+
+	map<Statistic, double>::iterator it = partition.accumulated_durations_.begin();
+	for (; it != partition.accumulated_durations_.end(); ++it)
+	{
+		accumulated_durations_[it->first] += it->second;
+		const CuddCounters& counters = partition.accumulated_cudd_counters_[it->first];
+		CuddCounters& sum = accumulated_cudd_counters_[it->first]; // zero-initialized if new
+		sum.gcs_ += counters.gcs_;
+		sum.gc_time_ += counters.gc_time_;
+		sum.reorder_time_ += counters.reorder_time_;
+		sum.cache_lookups_ += counters.cache_lookups_;
+		sum.cache_hits_ += counters.cache_hits_;
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+void BddAnalysis::writeStatistics(double total_time)
+{
+	const string& path = Options::instance().getBddStatsPath();
+	ofstream out_file(path.c_str());
+	MASSERT(out_file, "could not write BDD statistics file: " + path)
+
+	// one 'key value' pair per line
+	out_file << "total.cpu_ms " << total_time << endl;
+
+	// the main manager is idle if the latches were analyzed in partitions
+	map<string, double> manager_counters = partition_manager_counters_;
+	if (manager_counters.empty())
+		addManagerCounters(manager_counters);
+	for (unsigned k = 0; k < NUM_MANAGER_KEYS; ++k)
+		out_file << MANAGER_KEYS[k] << " " << (unsigned long) manager_counters[MANAGER_KEYS[k]] << endl;
+
+	map<Statistic, double>::iterator it = accumulated_durations_.begin();
+	for (; it != accumulated_durations_.end(); ++it)
+	{
+		const string phase = string("phase.") + STAT_NAMES[it->first];
+		const CuddCounters& counters = accumulated_cudd_counters_[it->first];
+		out_file << phase << ".cpu_ms " << it->second << endl;
+		out_file << phase << ".gc_count " << counters.gcs_ << endl;
+		out_file << phase << ".gc_ms " << counters.gc_time_ << endl;
+		out_file << phase << ".reorder_ms " << counters.reorder_time_ << endl;
+		out_file << phase << ".cache_lookups " << counters.cache_lookups_ << endl;
+		out_file << phase << ".cache_hits " << counters.cache_hits_ << endl;
+	}
+	out_file.close();
 }
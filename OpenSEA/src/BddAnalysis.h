@@ -38,6 +38,10 @@ extern "C" {
 
 #include "cuddObj.hh"
 
+class ErrorTrace;
+class AigSimulator;
+class BddSimulator2;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @class BddAnalysis
@@ -64,7 +68,8 @@ using BackEnd::analyze;
 
 	enum AnalysisMode
 	{
-		C_ONE_HOT_ENCODING = 0, C_CONSTR = 1, C_BINARY_ENCODING = 2, C_F_BINARY = 3, C_F_BINARY_FREE_INPUTS = 4
+		C_ONE_HOT_ENCODING = 0, C_CONSTR = 1, C_BINARY_ENCODING = 2, C_F_BINARY = 3, C_F_BINARY_FREE_INPUTS = 4,
+		C_F_BINARY_HYBRID = 5
 	};
 
 // -------------------------------------------------------------------------------------------
@@ -89,6 +94,29 @@ protected:
   void analyze_binary_enc_c_and_f_signals(vector<TestCase> &testcases);
   void analyze_binary_enc_c_and_f_signals_FREE_INPUTS(vector<TestCase> &testcases);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief continues a test-case of C_F_BINARY_HYBRID with the SAT solver
+///
+/// Called when the BDDs exceed --hybrid_nodes. The current state and the side constraints
+/// are translated into CNF (BddCnfBridge), and the remaining time-steps are analyzed with
+/// the SymbolicSimulator, using the same binary c and f encoding as the BDDs.
+///
+/// @param testcase the current test-case.
+/// @param first_timestep the first time-step which has not been analyzed with BDDs.
+/// @param sim_concrete_ok the fault-free simulation, in first_timestep.
+/// @param bddSim the BDD simulation, in first_timestep.
+/// @param side_constraints the side constraints of the BDD analysis.
+/// @param c_vars the c vars, the most significant bit first.
+/// @param f_vars the f vars, the most significant bit first.
+/// @param latches_to_check the latches which are flipped.
+/// @param latch_to_BDD_signal maps each latch to the BDD of its code.
+/// @param code_to_latch maps each code back to the latch.
+  void analyze_remaining_steps_with_sat(TestCase& testcase, unsigned first_timestep,
+      AigSimulator& sim_concrete_ok, BddSimulator2& bddSim, const BDD& side_constraints,
+      const vector<BDD>& c_vars, const vector<BDD>& f_vars, const set<int>& latches_to_check,
+      map<unsigned, BDD>& latch_to_BDD_signal, const vector<unsigned>& code_to_latch);
+
   bool useStatistics_;
   enum Statistic { CREATE_C_SIGNALS, SIM_ANDs, SWITCH_NXT_ST, OUT_IS_DIFF, SATISFIABILITY, STORE_MODEL, INIT_Latches, SIDE_CONSTRAINTS, MODIFY_LATCHES, PARSE_MODEL };
   map<Statistic, double> accumulated_durations_;
@@ -96,10 +124,222 @@ protected:
   void stopWatchStart();
   void stopWatchStore(Statistic statistic);
   void printStatistics(PointInTime begin);
-	void create_binary_encoded_c_BDDs(const vector<BDD>& c_vars,
-			map<unsigned, BDD>& latch_to_BDD_signal, set<int>& latches_to_check_);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief counters of the CUDD manager, accumulated per Statistic
+	struct CuddCounters
+	{
+		CuddCounters() : gcs_(0), gc_time_(0), reorder_time_(0), cache_lookups_(0), cache_hits_(0) {}
+		int gcs_;
+		long gc_time_;
+		long reorder_time_;
+		double cache_lookups_;
+		double cache_hits_;
+	};
+	CuddCounters readCuddCounters();
+	CuddCounters start_counters_;
+	map<Statistic, CuddCounters> accumulated_cudd_counters_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief writes the statistics to the --bdd_stats file, one 'key value' pair per line
+///
+/// The keys are total.*, cudd.* (whole run) and phase.<Statistic>.* (per phase). With
+/// --bdd_partitions, the counters are summed over the managers of all partitions.
+///
+/// @param total_time the CPU time of the whole analysis in milliseconds.
+	void writeStatistics(double total_time);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds the whole-run counters of the CUDD manager to totals ('cudd.*' keys)
+///
+/// @param totals the counters summed over all managers so far.
+	void addManagerCounters(map<string, double>& totals);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds the statistics of a partition (see analyzePartitioned()) to this instance
+///
+/// @param partition the finished partition.
+	void mergeStatistics(BddAnalysis& partition);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the CUDD counters summed over all partitions (empty if not partitioned)
+	map<string, double> partition_manager_counters_;
+// -------------------------------------------------------------------------------------------
+///
+/// @brief assigns a binary code of the c vars to each latch
+///
+/// @param c_vars the c vars, the most significant bit first.
+/// @param latches the latches to encode, the i-th latch gets the code i.
+/// @param latch_to_BDD_signal maps each latch to the BDD of its code.
+/// @param code_to_latch maps each code back to the latch.
+	void create_binary_encoded_c_BDDs(const vector<BDD>& c_vars, const vector<unsigned>& latches,
+			map<unsigned, BDD>& latch_to_BDD_signal, vector<unsigned>& code_to_latch);
 	BDD binary_conjunct(unsigned binary_encoding, const vector<BDD>& input_vars);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief creates the BDD variables for a binary encoded flip time-step
+///
+/// The variables are created once and shared by all test-cases, so the number of BDD
+/// variables does not grow with the number or the length of the test-cases.
+///
+/// @param testcases the test-cases to analyze (the longest one defines the number of bits).
+/// @param f_vars the created variables, the most significant bit first.
+/// @return the index of the first created variable.
+	int create_binary_encoded_f_vars(const vector<TestCase>& testcases, vector<BDD>& f_vars);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns a BDD variable index, recycled ones are preferred
+///
+/// @return an index which is not used by any live BDD.
+	int allocate_bdd_var();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief existentially quantifies the free input vars the state does not depend on any more
+///
+/// The outputs of later time-steps can not depend on such an input, so it only occurs in the
+/// side constraints, where it can be quantified early. The quantified variables are removed
+/// from input_vars.
+///
+/// @param state_support the cube of all variables the current state depends on.
+/// @param input_vars the free input vars that have not been quantified yet.
+/// @param side_constraints the side constraints of the current test-case.
+	void quantify_expired_input_vars(const BDD& state_support, vector<int>& input_vars,
+			BDD& side_constraints);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the conjunction of the BDD variables first_var to last_var
+///
+/// @param first_var the index of the first variable.
+/// @param last_var the index of the last variable.
+/// @return the positive cube of the variables.
+	BDD create_var_cube(int first_var, int last_var);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief existentially abstracts all variables except the c vars from check
+///
+/// The result is the set of all c assignments (i.e., flipped latches) for which some flip
+/// time-step and input values lead to a wrong output.
+///
+/// @param check the counterexamples.
+/// @param c_cube the positive cube of the c vars.
+/// @return the projection of check onto the c vars.
+	BDD project_on_c_vars(const BDD& check, const BDD& c_cube);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief enumerates the cubes of a BDD that depends on the c vars only
+///
+/// @param c_projection the result of project_on_c_vars().
+/// @param first_c_var the index of the first c var.
+/// @param last_c_var the index of the last c var.
+/// @param c_cubes the values of the c vars in each cube (0, 1 or 2 for don't care).
+	void enumerate_c_cubes(const BDD& c_projection, int first_c_var, int last_c_var,
+			vector<vector<char> >& c_cubes);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns all binary c codes covered by the given cubes
+///
+/// @param c_cubes the result of enumerate_c_cubes() for binary encoded c vars.
+/// @param codes the covered codes.
+	void decode_binary_c_cubes(const vector<vector<char> >& c_cubes, set<unsigned>& codes);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief gives the f vars of a finished test-case back to the pool of free variables
+///
+/// @param f_inputs the variables to recycle.
+	void release_f_vars(const vector<int>& f_inputs);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief recycles the f vars the state does not depend on any more
+///
+/// A flip in such a time-step can not influence any future output. The expired variables are
+/// existentially quantified out of the side constraints, removed from f_inputs and
+/// f_prime_bdd and given back to the pool of free variables. This keeps the number of BDD
+/// variables (cudd_.ReadSize()) bounded.
+///
+/// @param state_support the cube of all variables the current state depends on.
+/// @param f_inputs the f vars of the current test-case.
+/// @param f_prime_bdd the BDDs of the f vars of the current test-case.
+/// @param side_constraints the side constraints of the current test-case.
+	void release_expired_f_vars(const BDD& state_support, vector<int>& f_inputs,
+			vector<BDD>& f_prime_bdd, BDD& side_constraints);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the pool of recycled BDD variable indices
+	vector<int> free_bdd_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief applies --bdd_max_mem, --bdd_max_nodes and --bdd_reorder_at to the BDD manager
+///
+/// If a limit is exceeded, CUDD calls the error handler of the Cudd class, which throws.
+	void setMemoryLimits();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief analyzes the remaining test-cases with 'stla' after a BDD limit was exceeded
+///
+/// All test-cases before current_testcase_ have been analyzed completely with BDDs, so only
+/// current_testcase_ and the following ones are passed to SymbTimeLocationAnalysis.
+///
+/// @param testcases all test-cases of this analysis.
+	void fallbackToSymbTimeLocation(vector<TestCase>& testcases);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the index of the test-case that is currently analyzed with BDDs
+	unsigned current_testcase_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the latches to analyze: latch_subset_, or all not excluded latches
+///
+/// @return the latches to analyze.
+	vector<unsigned> getLatchesToCheck();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief stores an error trace in the ErrorTraceManager, or in partition_traces_
+///
+/// @param trace the error trace to store.
+	void storeErrorTrace(ErrorTrace* trace);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief analyzes disjoint groups of latches in parallel (see --bdd_partitions)
+///
+/// CUDD managers are not thread-safe, so each group is analyzed by its own BddAnalysis
+/// instance (own Cudd manager, BddSimulator2 and c encoding) in its own thread. Smaller
+/// groups need fewer c vars, so the BDDs are smaller. The detected latches are merged.
+///
+/// @param testcases the test-cases to analyze.
+/// @param num_partitions the number of groups (and threads).
+	void analyzePartitioned(vector<TestCase>& testcases, unsigned num_partitions);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the latches of this partition, empty if all latches are analyzed
+	vector<unsigned> latch_subset_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the error traces found in this partition (see analyzePartitioned())
+	vector<ErrorTrace*> partition_traces_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
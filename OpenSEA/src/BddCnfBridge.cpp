@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file BddCnfBridge.cpp
+/// @brief Contains the definition of the class BddCnfBridge.
+// -------------------------------------------------------------------------------------------
+
+#include "BddCnfBridge.h"
+#include "SatSolver.h"
+
+// -------------------------------------------------------------------------------------------
+BddCnfBridge::BddCnfBridge(SatSolver* solver, int& next_free_cnf_var) :
+		solver_(solver), next_free_cnf_var_(next_free_cnf_var)
+{
+}
+
+// -------------------------------------------------------------------------------------------
+BddCnfBridge::~BddCnfBridge()
+{
+	// nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+void BddCnfBridge::setVarLiteral(unsigned bdd_var, int cnf_lit)
+{
+	var_to_lit_[bdd_var] = cnf_lit;
+}
+
+// -------------------------------------------------------------------------------------------
+int BddCnfBridge::encode(const BDD& bdd)
+{
+	encoded_.push_back(bdd);
+	return encodeNode(bdd.getNode());
+}
+
+// -------------------------------------------------------------------------------------------
+int BddCnfBridge::encodeNode(DdNode* node)
+{
+	DdNode* regular = Cudd_Regular(node);
+	int lit;
+	if (Cudd_IsConstant(regular))
+	{
+		lit = CNF_TRUE; // the only constant of a BDD is one, zero is its complement
+	}
+	else
+	{
+		map<DdNode*, int>::iterator it = node_to_lit_.find(regular);
+		if (it != node_to_lit_.end())
+		{
+			lit = it->second;
+		}
+		else
+		{
+			int then_lit = encodeNode(Cudd_T(regular));
+			int else_lit = encodeNode(Cudd_E(regular));
+			map<unsigned, int>::iterator var_it = var_to_lit_.find(Cudd_NodeReadIndex(regular));
+			MASSERT(var_it != var_to_lit_.end(), "BDD variable without CNF literal")
+			int var_lit = var_it->second;
+
+			// lit <-> (var_lit ? then_lit : else_lit)
+			lit = next_free_cnf_var_++;
+			addSimplifiedClause(-lit, -var_lit, then_lit);
+			addSimplifiedClause(-lit, var_lit, else_lit);
+			addSimplifiedClause(lit, -var_lit, -then_lit);
+			addSimplifiedClause(lit, var_lit, -else_lit);
+			node_to_lit_[regular] = lit;
+		}
+	}
+	return Cudd_IsComplement(node) ? -lit : lit;
+}
+
+// -------------------------------------------------------------------------------------------
+void BddCnfBridge::addSimplifiedClause(int a, int b, int c)
+{
+	if (a == CNF_TRUE || b == CNF_TRUE || c == CNF_TRUE) // satisfied
+		return;
+	vector<int> clause;
+	if (a != CNF_FALSE)
+		clause.push_back(a);
+	if (b != CNF_FALSE)
+		clause.push_back(b);
+	if (c != CNF_FALSE)
+		clause.push_back(c);
+	solver_->incAddClause(clause);
+}
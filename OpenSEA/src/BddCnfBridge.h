@@ -0,0 +1,121 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file BddCnfBridge.h
+/// @brief Contains the declaration of the class BddCnfBridge.
+// -------------------------------------------------------------------------------------------
+
+#ifndef BddCnfBridge_H__
+#define BddCnfBridge_H__
+
+#include "defines.h"
+
+extern "C" {
+#include "cudd.h"
+};
+
+#include "cuddObj.hh"
+
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class BddCnfBridge
+/// @brief Translates BDDs into clauses of a SAT solver (Tseitin encoding).
+///
+/// Every BDD node gets one fresh CNF variable which is equivalent to the node. The nodes are
+/// cached, so BDDs which share nodes (e.g., the next-state functions of a circuit) share
+/// their clauses as well. The BDD variables must be mapped to CNF literals with
+/// setVarLiteral() before they are encoded.
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class BddCnfBridge
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param solver the solver to add the clauses to (in an incremental session).
+/// @param next_free_cnf_var the next free CNF variable, will be increased.
+  BddCnfBridge(SatSolver* solver, int& next_free_cnf_var);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~BddCnfBridge();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief defines the CNF literal of a BDD variable
+///
+/// @param bdd_var the index of the BDD variable.
+/// @param cnf_lit the CNF literal (may also be CNF_TRUE or CNF_FALSE).
+  void setVarLiteral(unsigned bdd_var, int cnf_lit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns a CNF literal which is equivalent to the BDD
+///
+/// @param bdd the BDD to encode. All its variables must have a literal (setVarLiteral()).
+/// @return the literal, CNF_TRUE or CNF_FALSE for constants.
+  int encode(const BDD& bdd);
+
+protected:
+
+  int encodeNode(DdNode* node);
+  void addSimplifiedClause(int a, int b, int c);
+
+  SatSolver* solver_;
+  int& next_free_cnf_var_;
+  map<unsigned, int> var_to_lit_;
+  map<DdNode*, int> node_to_lit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the encoded BDDs, referenced so that the cached nodes can not be freed and reused
+  vector<BDD> encoded_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  BddCnfBridge(const BddCnfBridge &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  BddCnfBridge& operator=(const BddCnfBridge &other);
+
+};
+
+#endif // BddCnfBridge_H__
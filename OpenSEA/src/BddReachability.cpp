@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file BddReachability.cpp
+/// @brief Contains the definition of the class BddReachability.
+// -------------------------------------------------------------------------------------------
+
+#include "BddReachability.h"
+#include "BddCnfBridge.h"
+#include "Logger.h"
+#include "SatSolver.h"
+
+extern "C"
+{
+#include "aiger.h"
+}
+
+// -------------------------------------------------------------------------------------------
+BddReachability::BddReachability(aiger* circuit) :
+		circuit_(circuit), exact_(true), num_iterations_(0)
+{
+	MASSERT(circuit_->num_outputs > 0, "the circuit has no alarm output")
+	buildTransitionRelation();
+}
+
+// -------------------------------------------------------------------------------------------
+BddReachability::~BddReachability()
+{
+	// nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+void BddReachability::buildTransitionRelation()
+{
+	unsigned num_latches = circuit_->num_latches;
+	for (unsigned l = 0; l < num_latches; ++l)
+	{
+		state_vars_.push_back(cudd_.bddVar(2 * l));
+		next_state_vars_.push_back(cudd_.bddVar(2 * l + 1));
+	}
+	for (unsigned i = 0; i < circuit_->num_inputs; ++i)
+		input_vars_.push_back(cudd_.bddVar(2 * num_latches + i));
+
+	// simulate the AND gates once with open inputs and open state
+	vector<BDD> results(circuit_->maxvar + 1, cudd_.bddZero());
+	for (unsigned l = 0; l < num_latches; ++l)
+		results[circuit_->latches[l].lit >> 1] = state_vars_[l];
+	for (unsigned i = 0; i < circuit_->num_inputs; ++i)
+		results[circuit_->inputs[i].lit >> 1] = input_vars_[i];
+	for (unsigned a = 0; a < circuit_->num_ands; ++a)
+	{
+		const aiger_and& and_gate = circuit_->ands[a];
+		results[and_gate.lhs >> 1] = readValue(results, and_gate.rhs0)
+				& readValue(results, and_gate.rhs1);
+	}
+
+	initial_states_ = cudd_.bddOne();
+	for (unsigned l = 0; l < num_latches; ++l)
+	{
+		transition_parts_.push_back(
+				next_state_vars_[l].Xnor(readValue(results, circuit_->latches[l].next)));
+
+		// a reset value which is neither 0 nor 1 means that the latch is uninitialized
+		if (circuit_->latches[l].reset == AIG_FALSE)
+			initial_states_ &= ~state_vars_[l];
+		else if (circuit_->latches[l].reset == AIG_TRUE)
+			initial_states_ &= state_vars_[l];
+	}
+	alarm_ = readValue(results, circuit_->outputs[circuit_->num_outputs - 1].lit);
+
+	// each current-state and input variable is quantified after the last part it occurs in
+	vector<BDD> supports;
+	for (unsigned l = 0; l < num_latches; ++l)
+		supports.push_back(transition_parts_[l].Support());
+
+	vector<BDD> to_quantify(state_vars_);
+	to_quantify.insert(to_quantify.end(), input_vars_.begin(), input_vars_.end());
+	quantify_cubes_.assign(num_latches + 1, cudd_.bddOne());
+	for (unsigned v = 0; v < to_quantify.size(); ++v)
+	{
+		unsigned last_part = num_latches; // occurs in no part
+		for (unsigned l = num_latches; l > 0; --l)
+		{
+			if (supports[l - 1] <= to_quantify[v])
+			{
+				last_part = l - 1;
+				break;
+			}
+		}
+		quantify_cubes_[last_part] &= to_quantify[v];
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+BDD BddReachability::readValue(const vector<BDD>& results, unsigned aig_lit)
+{
+	return aig_lit & 1 ? ~results[aig_lit >> 1] : results[aig_lit >> 1];
+}
+
+// -------------------------------------------------------------------------------------------
+BDD BddReachability::computeImage(const BDD& states)
+{
+	BDD product = (states & ~alarm_).ExistAbstract(quantify_cubes_.back());
+	for (unsigned l = 0; l < transition_parts_.size(); ++l)
+		product = product.AndAbstract(transition_parts_[l], quantify_cubes_[l]);
+	return product.SwapVariables(next_state_vars_, state_vars_);
+}
+
+// -------------------------------------------------------------------------------------------
+void BddReachability::compute(unsigned max_nodes)
+{
+	exact_ = true;
+	num_iterations_ = 0;
+	reachable_states_ = initial_states_;
+	BDD frontier = initial_states_;
+	while (!frontier.IsZero())
+	{
+		BDD previous = reachable_states_;
+		reachable_states_ |= computeImage(frontier);
+		num_iterations_++;
+
+		if (max_nodes > 0 && (unsigned) reachable_states_.nodeCount() > max_nodes)
+		{
+			// only a superset of the reachable states keeps the SAT constraint sound
+			reachable_states_ = reachable_states_.RemapOverApprox(circuit_->num_latches, max_nodes);
+			exact_ = false;
+		}
+		frontier = reachable_states_ & ~previous;
+	}
+	L_DBG("reachable states: " << num_iterations_ << " iterations, "
+			<< reachable_states_.nodeCount() << " nodes" << (exact_ ? "" : " (over-approximated)"))
+}
+
+// -------------------------------------------------------------------------------------------
+bool BddReachability::isExact() const
+{
+	return exact_;
+}
+
+// -------------------------------------------------------------------------------------------
+unsigned BddReachability::getNumIterations() const
+{
+	return num_iterations_;
+}
+
+// -------------------------------------------------------------------------------------------
+void BddReachability::addReachableStatesConstraint(SatSolver* solver,
+		const vector<int>& state_lits, int& next_free_cnf_var)
+{
+	MASSERT(state_lits.size() == circuit_->num_latches, "one literal per latch expected")
+	BddCnfBridge bridge(solver, next_free_cnf_var);
+	for (unsigned l = 0; l < state_lits.size(); ++l)
+		bridge.setVarLiteral(2 * l, state_lits[l]);
+
+	int root = bridge.encode(reachable_states_);
+	if (root == CNF_TRUE) // all states are reachable
+		return;
+	MASSERT(root != CNF_FALSE, "no state is reachable")
+	solver->incAddUnitClause(root);
+}
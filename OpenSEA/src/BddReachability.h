@@ -0,0 +1,181 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file BddReachability.h
+/// @brief Contains the declaration of the class BddReachability.
+// -------------------------------------------------------------------------------------------
+
+#ifndef BddReachability_H__
+#define BddReachability_H__
+
+#include "defines.h"
+
+extern "C" {
+#include "cudd.h"
+};
+
+#include "cuddObj.hh"
+
+struct aiger;
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class BddReachability
+/// @brief Computes the states of a circuit which are reachable without raising the alarm.
+///
+/// The reachable states are computed with a forward fix-point over BDDs. The transition
+/// relation is kept partitioned (one conjunct per latch) and the current-state and input
+/// variables are quantified as early as possible during the image computation.
+/// If the BDD of the reachable states exceeds a node limit, it is over-approximated, so the
+/// result is always a superset of the reachable states. The result can be added to a SAT
+/// solver as a constraint on the state variables.
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class BddReachability
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param circuit the circuit to analyze. The alarm output must be the last output.
+  BddReachability(aiger* circuit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~BddReachability();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief computes the (over-approximated) set of reachable states
+///
+/// @param max_nodes the node limit for the set of reachable states, 0 means no limit.
+  void compute(unsigned max_nodes);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns true if the result is exact, false if it was over-approximated
+///
+/// @return true if the node limit was never exceeded.
+  bool isExact() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the number of image computations until the fix-point was reached
+///
+/// @return the number of iterations of compute().
+  unsigned getNumIterations() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds the constraint 'the state is reachable' to a SAT solver
+///
+/// The BDD is translated into clauses with one fresh variable per BDD node.
+///
+/// @param solver the solver (in an incremental session).
+/// @param state_lits the CNF literals of the latches, in the order of circuit->latches.
+/// @param next_free_cnf_var the next free CNF variable, will be increased.
+  void addReachableStatesConstraint(SatSolver* solver, const vector<int>& state_lits,
+      int& next_free_cnf_var);
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief builds the next-state functions and the alarm function over the BDD variables
+  void buildTransitionRelation();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief computes the states reachable in one step without raising the alarm
+///
+/// @param states a set of states over the current-state variables.
+/// @return the successor states over the current-state variables.
+  BDD computeImage(const BDD& states);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the value of an AIG literal in the BDD results of the last simulation
+///
+/// @param results the BDD of each AIG variable.
+/// @param aig_lit the AIG literal.
+/// @return the BDD of aig_lit.
+  static BDD readValue(const vector<BDD>& results, unsigned aig_lit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the circuit to analyze
+  aiger* circuit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the BDD manager. The variable of latch j is 2j, its next-state variable 2j+1, the
+/// inputs follow afterwards.
+  Cudd cudd_;
+
+  vector<BDD> state_vars_;
+  vector<BDD> next_state_vars_;
+  vector<BDD> input_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief one conjunct per latch: next_state_vars_[j] <-> next-state function of latch j
+  vector<BDD> transition_parts_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief quantify_cubes_[j] are the variables which can be quantified after conjoining
+/// transition_parts_[j], quantify_cubes_[num_latches] the ones that occur in no part
+  vector<BDD> quantify_cubes_;
+
+  BDD alarm_;
+  BDD initial_states_;
+  BDD reachable_states_;
+  bool exact_;
+  unsigned num_iterations_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  BddReachability(const BddReachability &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  BddReachability& operator=(const BddReachability &other);
+
+};
+
+#endif // BddReachability_H__
@@ -0,0 +1,157 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file BddVariableOrder.cpp
+/// @brief Contains the definition of the class BddVariableOrder.
+// -------------------------------------------------------------------------------------------
+
+#include "BddVariableOrder.h"
+#include "Logger.h"
+
+extern "C"
+{
+#include "aiger.h"
+}
+
+// -------------------------------------------------------------------------------------------
+/// @brief Compares latches by their rank in the DFS order.
+struct LatchRankCompare
+{
+  const map<unsigned, unsigned>& rank_;
+  LatchRankCompare(const map<unsigned, unsigned>& rank) : rank_(rank) {}
+  bool operator()(unsigned a, unsigned b) const
+  {
+    return rank_.find(a)->second < rank_.find(b)->second;
+  }
+};
+
+// -------------------------------------------------------------------------------------------
+BddVariableOrder::BddVariableOrder(aiger* circuit, int heuristic) :
+		circuit_(circuit), heuristic_(heuristic)
+{
+	MASSERT(heuristic >= CREATION && heuristic <= FANIN_DFS_F_FIRST,
+			"unknown BDD variable order heuristic")
+	if (heuristic_ != CREATION)
+		computeLatchRanks();
+}
+
+// -------------------------------------------------------------------------------------------
+BddVariableOrder::~BddVariableOrder()
+{
+	// nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+void BddVariableOrder::orderLatches(vector<unsigned>& latches) const
+{
+	if (heuristic_ == CREATION)
+		return;
+	// stable: keeps the creation order for latches without a rank difference
+	stable_sort(latches.begin(), latches.end(), LatchRankCompare(latch_rank_));
+}
+
+// -------------------------------------------------------------------------------------------
+void BddVariableOrder::apply(Cudd& cudd, int first_c_var, int first_f_var,
+		unsigned num_f_vars) const
+{
+	if (heuristic_ != FANIN_DFS_F_FIRST || num_f_vars == 0)
+		return;
+
+	// the current order (variable index for each level)
+	int size = cudd.ReadSize();
+	vector<int> index_at_level(size);
+	for (int index = 0; index < size; ++index)
+		index_at_level[cudd.ReadPerm(index)] = index;
+
+	// move the f variables (as one group) to the level of the first c variable
+	int c_level = cudd.ReadPerm(first_c_var);
+	vector<int> permutation;
+	permutation.reserve(size);
+	for (int level = 0; level < size; ++level)
+	{
+		int index = index_at_level[level];
+		if (level == c_level)
+		{
+			for (unsigned f_cnt = 0; f_cnt < num_f_vars; ++f_cnt)
+				permutation.push_back(first_f_var + f_cnt);
+		}
+		if (index < first_f_var || index >= first_f_var + static_cast<int>(num_f_vars))
+			permutation.push_back(index);
+	}
+	cudd.ShuffleHeap(&permutation[0]);
+}
+
+// -------------------------------------------------------------------------------------------
+string BddVariableOrder::getName(int heuristic)
+{
+	if (heuristic == CREATION)
+		return "creation";
+	if (heuristic == FANIN_DFS)
+		return "fanin_dfs";
+	if (heuristic == FANIN_DFS_F_FIRST)
+		return "fanin_dfs_f_first";
+	return "unknown";
+}
+
+// -------------------------------------------------------------------------------------------
+void BddVariableOrder::computeLatchRanks()
+{
+	vector<int> and_of_var(circuit_->maxvar + 1, -1);
+	for (unsigned b = 0; b < circuit_->num_ands; ++b)
+		and_of_var[circuit_->ands[b].lhs >> 1] = b;
+	vector<int> latch_of_var(circuit_->maxvar + 1, -1);
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+		latch_of_var[circuit_->latches[l].lit >> 1] = l;
+
+	// depth-first search, starting at the outputs (the alarm output last, as it depends on
+	// the protection logic only)
+	vector<bool> visited(circuit_->maxvar + 1, false);
+	vector<unsigned> stack;
+	for (unsigned o = circuit_->num_outputs; o-- > 0;)
+		stack.push_back(circuit_->outputs[o].lit >> 1);
+
+	unsigned next_rank = 0;
+	while (!stack.empty())
+	{
+		unsigned var = stack.back();
+		stack.pop_back();
+		if (visited[var])
+			continue;
+		visited[var] = true;
+
+		if (and_of_var[var] >= 0)
+		{
+			stack.push_back(circuit_->ands[and_of_var[var]].rhs1 >> 1);
+			stack.push_back(circuit_->ands[and_of_var[var]].rhs0 >> 1);
+		}
+		else if (latch_of_var[var] >= 0)
+		{
+			latch_rank_[circuit_->latches[latch_of_var[var]].lit] = next_rank++;
+			stack.push_back(circuit_->latches[latch_of_var[var]].next >> 1);
+		}
+	}
+
+	// latches which can not reach an output come last
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		if (latch_rank_.find(circuit_->latches[l].lit) == latch_rank_.end())
+			latch_rank_[circuit_->latches[l].lit] = next_rank++;
+	}
+}
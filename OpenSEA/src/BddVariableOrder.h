@@ -0,0 +1,145 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file BddVariableOrder.h
+/// @brief Contains the declaration of the class BddVariableOrder.
+// -------------------------------------------------------------------------------------------
+
+#ifndef BddVariableOrder_H__
+#define BddVariableOrder_H__
+
+#include "defines.h"
+
+extern "C" {
+#include "cudd.h"
+};
+
+#include "cuddObj.hh"
+
+struct aiger;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class BddVariableOrder
+/// @brief Static variable order heuristics for the BDD back-end.
+///
+/// Dynamic reordering does not pay off for the BDD back-end, so the variables are created in a
+/// fixed order. This class computes a better initial order from the circuit topology:
+/// - The latches are ranked by a depth-first search over the fan-in of the outputs and of the
+///   next-state functions. Latches which influence each other are close in this ranking, so
+///   their selection (c) variables (one-hot) or codes (binary encoding) are close as well.
+/// - Optionally, the flip time-step (f) variables are moved on top of the c variables (via
+///   Cudd::ShuffleHeap) as one group.
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class BddVariableOrder
+{
+public:
+
+  enum Heuristic
+  {
+    CREATION = 0, FANIN_DFS = 1, FANIN_DFS_F_FIRST = 2
+  };
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param circuit the circuit to analyze.
+/// @param heuristic the heuristic to use (see Heuristic).
+  BddVariableOrder(aiger* circuit, int heuristic);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~BddVariableOrder();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief sorts latches such that the c variables are created in a good order
+///
+/// @param latches the AIG literals of the latches, will be reordered (unchanged for CREATION).
+  void orderLatches(vector<unsigned>& latches) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief moves the f variables on top of the c variables (only for FANIN_DFS_F_FIRST)
+///
+/// @param cudd the BDD manager, all c and f variables must already exist.
+/// @param first_c_var the index of the first c variable.
+/// @param first_f_var the index of the first f variable.
+/// @param num_f_vars the number of f variables (which are consecutive).
+  void apply(Cudd& cudd, int first_c_var, int first_f_var, unsigned num_f_vars) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns a name for a heuristic (for log messages and benchmarks)
+///
+/// @param heuristic the heuristic.
+/// @return the name.
+  static string getName(int heuristic);
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief ranks the latches by a depth-first search over the fan-in of the outputs
+  void computeLatchRanks();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the circuit to analyze
+  aiger* circuit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the selected heuristic
+  int heuristic_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief maps a latch literal to its position in the DFS order
+  map<unsigned, unsigned> latch_rank_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  BddVariableOrder(const BddVariableOrder &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  BddVariableOrder& operator=(const BddVariableOrder &other);
+
+};
+
+#endif // BddVariableOrder_H__
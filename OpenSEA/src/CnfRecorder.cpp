@@ -0,0 +1,192 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file CnfRecorder.cpp
+/// @brief Contains the definition of the class CnfRecorder.
+// -------------------------------------------------------------------------------------------
+
+#include "CnfRecorder.h"
+
+// -------------------------------------------------------------------------------------------
+CnfRecorder::CnfRecorder() :
+    SatSolver(false, false)
+{
+  // nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+CnfRecorder::~CnfRecorder()
+{
+  // nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::replayInto(SatSolver* solver, bool use_push) const
+{
+  solver->startIncrementalSession(vars_to_keep_, use_push);
+  solver->incAddCNF(cnf_);
+}
+
+// -------------------------------------------------------------------------------------------
+const CNF& CnfRecorder::getCNF() const
+{
+  return cnf_;
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<int>& CnfRecorder::getVarsToKeep() const
+{
+  return vars_to_keep_;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CnfRecorder::isSat(const CNF &cnf)
+{
+  MASSERT(false, "CnfRecorder cannot solve.");
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CnfRecorder::isSatModelOrCore(const CNF &cnf, const vector<int> &assumptions,
+                                   const vector<int> &vars_of_interest,
+                                   vector<int> &model_or_core)
+{
+  MASSERT(false, "CnfRecorder cannot solve.");
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CnfRecorder::incIsSat()
+{
+  MASSERT(false, "CnfRecorder cannot solve.");
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CnfRecorder::incIsSat(const vector<int> &assumptions)
+{
+  MASSERT(false, "CnfRecorder cannot solve.");
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CnfRecorder::incIsSatModelOrCore(const vector<int> &assumptions,
+                                      const vector<int> &vars_of_interest,
+                                      vector<int> &model_or_core)
+{
+  MASSERT(false, "CnfRecorder cannot solve.");
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+bool CnfRecorder::incIsSatModelOrCore(const vector<int> &core_assumptions,
+                                      const vector<int> &more_assumptions,
+                                      const vector<int> &vars_of_interest,
+                                      vector<int> &model_or_core)
+{
+  MASSERT(false, "CnfRecorder cannot solve.");
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incPush()
+{
+  MASSERT(false, "CnfRecorder does not support push and pop.");
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incPop()
+{
+  MASSERT(false, "CnfRecorder does not support push and pop.");
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::startIncrementalSession(const vector<int> &vars_to_keep, bool use_push)
+{
+  cnf_.clear();
+  vars_to_keep_ = vars_to_keep;
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::addVarsToKeep(const vector<int> &vars_to_keep)
+{
+  vars_to_keep_.insert(vars_to_keep_.end(), vars_to_keep.begin(), vars_to_keep.end());
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::addVarToKeep(int var_to_keep)
+{
+  vars_to_keep_.push_back(var_to_keep);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::clearIncrementalSession()
+{
+  cnf_.clear();
+  vars_to_keep_.clear();
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAddCNF(const CNF &cnf)
+{
+  cnf_.addCNF(cnf);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAddClause(const vector<int> &clause)
+{
+  cnf_.addClause(clause);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAddUnitClause(int lit)
+{
+  cnf_.add1LitClause(lit);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAdd2LitClause(int lit1, int lit2)
+{
+  cnf_.add2LitClause(lit1, lit2);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAdd3LitClause(int lit1, int lit2, int lit3)
+{
+  cnf_.add3LitClause(lit1, lit2, lit3);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAdd4LitClause(int lit1, int lit2, int lit3, int lit4)
+{
+  cnf_.add4LitClause(lit1, lit2, lit3, lit4);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAddCube(const vector<int> &cube)
+{
+  cnf_.addCube(cube);
+}
+
+// -------------------------------------------------------------------------------------------
+void CnfRecorder::incAddNegCubeAsClause(const vector<int> &cube)
+{
+  cnf_.addNegCubeAsClause(cube);
+}
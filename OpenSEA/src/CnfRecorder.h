@@ -0,0 +1,147 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file CnfRecorder.h
+/// @brief Contains the declaration of the class CnfRecorder.
+// -------------------------------------------------------------------------------------------
+
+#ifndef CnfRecorder_H__
+#define CnfRecorder_H__
+
+#include "defines.h"
+#include "SatSolver.h"
+#include "CNF.h"
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class CnfRecorder
+/// @brief A SatSolver which does not solve, but records the clauses of an incremental session.
+///
+/// This allows to build a formula once (e.g., with a SymbolicSimulator) and to load it into
+/// several real SatSolver instances afterwards (e.g., one per thread), see replayInto().
+/// All methods which would require solving abort the program.
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class CnfRecorder : public SatSolver
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+  CnfRecorder();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~CnfRecorder();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Starts a new incremental session of another solver with the recorded clauses
+///
+/// @param solver the solver. Its current incremental session is closed.
+/// @param use_push passed to SatSolver::startIncrementalSession().
+  void replayInto(SatSolver* solver, bool use_push = true) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the recorded clauses
+  const CNF& getCNF() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the recorded variables to keep
+  const vector<int>& getVarsToKeep() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Solving is not supported, these methods abort the program.
+  virtual bool isSat(const CNF &cnf);
+  virtual bool isSatModelOrCore(const CNF &cnf,
+                        const vector<int> &assumptions,
+                        const vector<int> &vars_of_interest,
+                        vector<int> &model_or_core);
+  virtual bool incIsSat();
+  virtual bool incIsSat(const vector<int> &assumptions);
+  virtual bool incIsSatModelOrCore(const vector<int> &assumptions,
+                                   const vector<int> &vars_of_interest,
+                                   vector<int> &model_or_core);
+  virtual bool incIsSatModelOrCore(const vector<int> &core_assumptions,
+                                   const vector<int> &more_assumptions,
+                                   const vector<int> &vars_of_interest,
+                                   vector<int> &model_or_core);
+  virtual void incPush();
+  virtual void incPop();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Records the clauses and variables, see SatSolver for the documentation.
+  virtual void startIncrementalSession(const vector<int> &vars_to_keep,
+                                       bool use_push = true);
+  virtual void addVarsToKeep(const vector<int> &vars_to_keep);
+  virtual void addVarToKeep(int var_to_keep);
+  virtual void clearIncrementalSession();
+  virtual void incAddCNF(const CNF &cnf);
+  virtual void incAddClause(const vector<int> &clause);
+  virtual void incAddUnitClause(int lit);
+  virtual void incAdd2LitClause(int lit1, int lit2);
+  virtual void incAdd3LitClause(int lit1, int lit2, int lit3);
+  virtual void incAdd4LitClause(int lit1, int lit2, int lit3, int lit4);
+  virtual void incAddCube(const vector<int> &cube);
+  virtual void incAddNegCubeAsClause(const vector<int> &cube);
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The recorded clauses.
+  CNF cnf_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The recorded variables to keep.
+  vector<int> vars_to_keep_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  CnfRecorder(const CnfRecorder &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  CnfRecorder& operator=(const CnfRecorder &other);
+
+};
+
+#endif // CnfRecorder_H__
@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file ConeOfInfluence.cpp
+/// @brief Contains the definition of the class ConeOfInfluence.
+// -------------------------------------------------------------------------------------------
+
+#include "ConeOfInfluence.h"
+
+extern "C"
+{
+#include "aiger.h"
+}
+
+// -------------------------------------------------------------------------------------------
+ConeOfInfluence::ConeOfInfluence(aiger* circuit) :
+		circuit_(circuit), num_ands_in_mask_(0)
+{
+	// backward cone: the AND gates are topologically ordered, so a reverse sweep suffices
+	vector<bool> var_needed(circuit_->maxvar + 1, false);
+	for (unsigned o = 0; o < circuit_->num_outputs; ++o)
+		var_needed[circuit_->outputs[o].lit >> 1] = true;
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+		var_needed[circuit_->latches[l].next >> 1] = true;
+
+	backward_cone_.resize(circuit_->num_ands, false);
+	for (unsigned b = circuit_->num_ands; b-- > 0;)
+	{
+		if (!var_needed[circuit_->ands[b].lhs >> 1])
+			continue;
+		backward_cone_[b] = true;
+		var_needed[circuit_->ands[b].rhs0 >> 1] = true;
+		var_needed[circuit_->ands[b].rhs1 >> 1] = true;
+	}
+
+	tainted_latches_.resize(circuit_->num_latches, false);
+	and_mask_.resize(circuit_->num_ands, false);
+}
+
+// -------------------------------------------------------------------------------------------
+ConeOfInfluence::~ConeOfInfluence()
+{
+	// nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+void ConeOfInfluence::setFlippedLatch(unsigned latch_aig)
+{
+	tainted_latches_.assign(circuit_->num_latches, false);
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		if (circuit_->latches[l].lit == latch_aig)
+			tainted_latches_[l] = true;
+	}
+	computeForwardCone();
+}
+
+// -------------------------------------------------------------------------------------------
+bool ConeOfInfluence::extendToNextStep()
+{
+	bool has_grown = false;
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		if (!tainted_latches_[l] && var_in_forward_cone_[circuit_->latches[l].next >> 1])
+		{
+			tainted_latches_[l] = true;
+			has_grown = true;
+		}
+	}
+
+	if (has_grown)
+		computeForwardCone();
+	return has_grown;
+}
+
+// -------------------------------------------------------------------------------------------
+void ConeOfInfluence::computeForwardCone()
+{
+	var_in_forward_cone_.assign(circuit_->maxvar + 1, false);
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		if (tainted_latches_[l])
+			var_in_forward_cone_[circuit_->latches[l].lit >> 1] = true;
+	}
+
+	num_ands_in_mask_ = 0;
+	for (unsigned b = 0; b < circuit_->num_ands; ++b)
+	{
+		bool in_cone = var_in_forward_cone_[circuit_->ands[b].rhs0 >> 1]
+				|| var_in_forward_cone_[circuit_->ands[b].rhs1 >> 1];
+		var_in_forward_cone_[circuit_->ands[b].lhs >> 1] = in_cone;
+		and_mask_[b] = in_cone && backward_cone_[b];
+		if (and_mask_[b])
+			num_ands_in_mask_++;
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<bool>& ConeOfInfluence::getAndMask() const
+{
+	return and_mask_;
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<bool>& ConeOfInfluence::getBackwardConeMask() const
+{
+	return backward_cone_;
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<bool>& ConeOfInfluence::getTaintedLatches() const
+{
+	return tainted_latches_;
+}
+
+// -------------------------------------------------------------------------------------------
+unsigned ConeOfInfluence::getNumAndsInMask() const
+{
+	return num_ands_in_mask_;
+}
@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file ConeOfInfluence.h
+/// @brief Contains the declaration of the class ConeOfInfluence.
+// -------------------------------------------------------------------------------------------
+
+#ifndef ConeOfInfluence_H__
+#define ConeOfInfluence_H__
+
+#include "defines.h"
+
+struct aiger;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class ConeOfInfluence
+/// @brief Computes per-latch masks of the AND gates which have to be encoded.
+///
+/// A bit-flip in a latch can only change AND gates in the (sequential) forward cone of this
+/// latch, and only AND gates in the backward cone of the outputs (including the alarm
+/// output) and next-state functions can be observed at all. The mask returned by
+/// getAndMask() is the intersection of both cones. All other AND gates of a faulty copy of
+/// the circuit have the same value as in the fault-free copy, so a SymbolicSimulator can
+/// skip them (see SymbolicSimulator::setAndMask()).
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class ConeOfInfluence
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor. Computes the backward cone of the outputs and next-state functions.
+///
+/// @param circuit the circuit to analyze
+  ConeOfInfluence(aiger* circuit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~ConeOfInfluence();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief (re)starts the cone computation for a newly flipped latch
+///
+/// @param latch_aig the aiger literal of the flipped latch
+  void setFlippedLatch(unsigned latch_aig);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief extends the cone by one time-step: all latches whose next-state function is in
+/// the current forward cone become part of the cone as well.
+///
+/// @return true if the cone has grown
+  bool extendToNextStep();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the mask of AND gates (index = position in circuit->ands) to encode
+///
+/// @return the forward cone of the flipped latch(es) intersected with the backward cone
+  const vector<bool>& getAndMask() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the mask of AND gates in the backward cone of outputs and next states
+///
+/// @return the backward cone mask (independent of any flipped latch)
+  const vector<bool>& getBackwardConeMask() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the latches (index) which may hold a different value than in the
+/// fault-free circuit, i.e., the flipped latch and all latches the cone has been extended to
+///
+/// @return the tainted latches, index = position in circuit->latches
+  const vector<bool>& getTaintedLatches() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the number of AND gates in the current mask
+///
+/// @return the number of AND gates set in getAndMask()
+  unsigned getNumAndsInMask() const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief recomputes and_mask_ from the currently tainted latches
+  void computeForwardCone();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The circuit to analyze
+  aiger* circuit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief AND gates in the backward cone of the outputs and next-state functions
+  vector<bool> backward_cone_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the current mask: forward cone of the tainted latches AND backward cone
+  vector<bool> and_mask_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief maps aiger variables to true if they are in the current forward cone
+  vector<bool> var_in_forward_cone_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief latches (index) which may hold a different value than in the fault-free circuit
+  vector<bool> tainted_latches_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the number of AND gates set in and_mask_
+  unsigned num_ands_in_mask_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  ConeOfInfluence(const ConeOfInfluence &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  ConeOfInfluence& operator=(const ConeOfInfluence &other);
+
+};
+
+#endif // ConeOfInfluence_H__
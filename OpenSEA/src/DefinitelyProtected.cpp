@@ -26,15 +26,20 @@
 #include "DefinitelyProtected.h"
 
 #include "CnfUtils.h"
+#include "CnfRecorder.h"
 #include "SatSolver.h"
 #include "AigSimulator.h"
+#include "BddReachability.h"
 #include "SymbolicSimulator.h"
 #include "Options.h"
 #include "Utils.h"
 #include "Logger.h"
 #include "AndCacheMap.h"
+#include "AndCacheFor2Simulators.h"
 #include "SatAssignmentParser.h"
 
+#include <pthread.h>
+
 extern "C"
 {
 #include "aiger.h"
@@ -42,7 +47,7 @@ extern "C"
 
 // -------------------------------------------------------------------------------------------
 DefinitelyProtected::DefinitelyProtected(aiger* circuit, int num_err_latches, int mode) :
-		BackEnd(circuit, num_err_latches, mode)
+		BackEnd(circuit, num_err_latches, mode), coi_(circuit), reachability_(0)
 {
 	circuit_ = circuit;
 	num_err_latches_ = num_err_latches;
@@ -53,12 +58,23 @@ DefinitelyProtected::DefinitelyProtected(aiger* circuit, int num_err_latches, in
 // -------------------------------------------------------------------------------------------
 DefinitelyProtected::~DefinitelyProtected()
 {
+	delete reachability_;
 }
 
 void DefinitelyProtected::analyze()
 {
 	detected_latches_.clear();
 
+	delete reachability_;
+	reachability_ = 0;
+	if (Options::instance().isDpReachability())
+	{
+		reachability_ = new BddReachability(circuit_);
+		reachability_->compute(Options::instance().getDpReachabilityMaxNodes());
+		L_LOG("reachable states computed in " << reachability_->getNumIterations()
+				<< " iterations" << (reachability_->isExact() ? "" : " (over-approximated)"))
+	}
+
 	if (mode_ == DefinitelyProtected::STANDARD)
 		findDefinitelyProtected_1step_deprecated();
 	else if (mode_ == 1)
@@ -69,16 +85,94 @@ void DefinitelyProtected::analyze()
 		findDefinitelyProtected_kstep_single_latch();
 	else if (mode_ == 4)
 		findDefinitelyProtected_kstep_simultaneously();
+	else if (mode_ == 5)
+		findDefinitelyProtected_kinduction();
 	else
 		MASSERT(false, "unknown mode!");
 
 }
 
+void DefinitelyProtected::constrainToReachableStates(SatSolver* solver,
+		SymbolicSimulator& sim_symb, int& next_free_cnf_var)
+{
+	if (reachability_ == 0)
+		return;
+
+	vector<int> state_lits;
+	state_lits.reserve(circuit_->num_latches);
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+		state_lits.push_back(sim_symb.getResultValue(circuit_->latches[l].lit >> 1));
+	reachability_->addReachableStatesConstraint(solver, state_lits, next_free_cnf_var);
+}
+
+int DefinitelyProtected::createOutputsDifferentLiteral(SatSolver* solver,
+		SymbolicSimulator& sim_a, SymbolicSimulator& sim_b, int& next_free_cnf_var)
+{
+	vector<int> outputs_a = sim_a.getOutputValues();
+	vector<int> outputs_b = sim_b.getOutputValues();
+
+	// exclude alarm output
+	outputs_a.pop_back();
+	outputs_b.pop_back();
+
+	int outputs_different = next_free_cnf_var++;
+	solver->addVarToKeep(outputs_different);
+	vector<int> different_clause;
+	different_clause.push_back(-outputs_different);
+	CnfUtils::generateVectorIsDifferentClause(outputs_a, outputs_b, different_clause,
+			next_free_cnf_var, solver);
+	solver->incAddClause(different_clause);
+
+	// and the other direction: any single difference implies outputs_different
+	for (unsigned i = 1; i < different_clause.size(); i++)
+		solver->incAdd2LitClause(outputs_different, -different_clause[i]);
+
+	return outputs_different;
+}
+
+bool DefinitelyProtected::addSimplePathConstraints(SatSolver* solver,
+		const vector<vector<int> >& states, const vector<int>& model, int& next_free_cnf_var)
+{
+	set<int> true_lits(model.begin(), model.end());
+
+	// evaluate the states under the model
+	vector<vector<bool> > values(states.size());
+	for (unsigned s = 0; s < states.size(); ++s)
+	{
+		values[s].reserve(states[s].size());
+		for (unsigned l = 0; l < states[s].size(); ++l)
+		{
+			int lit = states[s][l];
+			values[s].push_back(lit == CNF_TRUE || (lit != CNF_FALSE && true_lits.count(lit) != 0));
+		}
+	}
+
+	bool added = false;
+	for (unsigned i = 0; i < states.size(); ++i)
+	{
+		for (unsigned j = i + 1; j < states.size(); ++j)
+		{
+			if (values[i] != values[j])
+				continue;
+
+			vector<int> state_i = states[i];
+			vector<int> state_j = states[j];
+			vector<int> states_different;
+			CnfUtils::generateVectorIsDifferentClause(state_i, state_j, states_different,
+					next_free_cnf_var, solver);
+			solver->incAddClause(states_different);
+			added = true;
+		}
+	}
+	return added;
+}
+
 void DefinitelyProtected::computeInitialTransitionRelation(SatSolver* solver,
-		SymbolicSimulator& sim_symb, unsigned num_steps)
+		SymbolicSimulator& sim_symb, unsigned num_steps, int& next_free_cnf_var)
 {
 	// first time steps T(x,i,o,a,x') & -a
 	sim_symb.setStateValuesOpen();
+	constrainToReachableStates(solver, sim_symb, next_free_cnf_var);
 	for (unsigned s_cnt = 0; s_cnt < num_steps; s_cnt++)
 	{
 		sim_symb.setInputValuesOpen();
@@ -104,9 +198,10 @@ void DefinitelyProtected::findDefinitelyProtected_1step_deprecated()
 
 		// first time steps T(x,i,o,a,x') & -a
 		unsigned num_initial_steps = Options::instance().getDefinitevelyProtectedNumInitialSteps();
-		computeInitialTransitionRelation(solver_, sim_symb, num_initial_steps);
+		computeInitialTransitionRelation(solver_, sim_symb, num_initial_steps, next_free_cnf_var);
 
-		test_single_latch(solver_, sim_symb, next_free_cnf_var, latches_to_check[l_cnt]);
+		test_single_latch(solver_, sim_symb, next_free_cnf_var, latches_to_check[l_cnt], coi_,
+				detected_latches_, unknown_latches_);
 
 		delete solver_;
 	}
@@ -115,6 +210,15 @@ void DefinitelyProtected::findDefinitelyProtected_1step_deprecated()
 
 void DefinitelyProtected::findDefinitelyProtected_1step_single()
 {
+	if (Options::instance().getDpThreads() > 1)
+	{
+		vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_,
+				num_err_latches_);
+		scheduleLatches(latches_to_check);
+		findDefinitelyProtected_1step_parallel(latches_to_check);
+		return;
+	}
+
 	int next_free_cnf_var = 2;
 	SatSolver* solver = Options::instance().getSATSolver();
 	vector<int> vars_to_keep; // empty
@@ -123,7 +227,7 @@ void DefinitelyProtected::findDefinitelyProtected_1step_single()
 
 	// first time steps T(x,i,o,a,x') & -a
 	unsigned num_initial_steps = Options::instance().getDefinitevelyProtectedNumInitialSteps();
-	computeInitialTransitionRelation(solver, sim_symb, num_initial_steps);
+	computeInitialTransitionRelation(solver, sim_symb, num_initial_steps, next_free_cnf_var);
 
 	// store solver session
 	int next_free_cnf_var_after_first_step = next_free_cnf_var;
@@ -133,9 +237,17 @@ void DefinitelyProtected::findDefinitelyProtected_1step_single()
 	// ---------------- BEGIN 'for each latch' -------------------------
 	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_,
 			num_err_latches_);
+	scheduleLatches(latches_to_check);
 	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
 	{
-		test_single_latch(solver, sim_symb, next_free_cnf_var, latches_to_check[l_cnt]);
+		if (isGlobalBudgetExceeded())
+		{
+			markLatchUnknown(latches_to_check[l_cnt]);
+			continue;
+		}
+		startLatchBudget(solver);
+		test_single_latch(solver, sim_symb, next_free_cnf_var, latches_to_check[l_cnt], coi_,
+				detected_latches_, unknown_latches_);
 
 		// reset solver session
 		solver->incPop();
@@ -148,9 +260,119 @@ void DefinitelyProtected::findDefinitelyProtected_1step_single()
 
 }
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the work of one thread of DefinitelyProtected::findDefinitelyProtected_1step_parallel()
+struct DpBatch
+{
+	DefinitelyProtected* analysis_;
+	SatSolver* solver_;
+	const CnfRecorder* initial_relation_;
+	const vector<int>* initial_results_;
+	int next_free_cnf_var_;
+	vector<unsigned> latches_;
+	set<unsigned> detected_;
+	set<unsigned> unknown_;
+	pthread_t thread_;
+};
+
+// -------------------------------------------------------------------------------------------
+static void* checkBatch(void* batch)
+{
+	DpBatch* b = static_cast<DpBatch*>(batch);
+	b->analysis_->checkLatchBatch(b->solver_, *(b->initial_relation_), *(b->initial_results_),
+			b->next_free_cnf_var_, b->latches_, b->detected_, b->unknown_);
+	return 0;
+}
+
+void DefinitelyProtected::findDefinitelyProtected_1step_parallel(
+		const vector<unsigned>& latches_to_check)
+{
+	// first time steps T(x,i,o,a,x') & -a, recorded once for all threads
+	int next_free_cnf_var = 2;
+	CnfRecorder initial_relation;
+	vector<int> vars_to_keep; // empty
+	initial_relation.startIncrementalSession(vars_to_keep);
+	SymbolicSimulator sim_symb(circuit_, &initial_relation, next_free_cnf_var);
+	unsigned num_initial_steps = Options::instance().getDefinitevelyProtectedNumInitialSteps();
+	computeInitialTransitionRelation(&initial_relation, sim_symb, num_initial_steps,
+			next_free_cnf_var);
+	vector<int> initial_results = sim_symb.getResults();
+
+	// round robin, so every thread gets easy and hard latches of the schedule
+	unsigned num_threads = Options::instance().getDpThreads();
+	if (num_threads > latches_to_check.size())
+		num_threads = latches_to_check.size();
+	vector<DpBatch> batches(num_threads);
+	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
+		batches[l_cnt % num_threads].latches_.push_back(latches_to_check[l_cnt]);
+
+	for (unsigned t = 0; t < num_threads; ++t)
+	{
+		batches[t].analysis_ = this;
+		batches[t].solver_ = Options::instance().getSATSolver();
+		batches[t].initial_relation_ = &initial_relation;
+		batches[t].initial_results_ = &initial_results;
+		batches[t].next_free_cnf_var_ = next_free_cnf_var;
+		int rc = pthread_create(&batches[t].thread_, 0, checkBatch, &batches[t]);
+		MASSERT(rc == 0, "could not create a thread for the dp analysis")
+	}
+
+	for (unsigned t = 0; t < num_threads; ++t)
+		pthread_join(batches[t].thread_, 0);
+
+	// merge the results, the sets keep the output independent of the thread timing
+	for (unsigned t = 0; t < num_threads; ++t)
+	{
+		detected_latches_.insert(batches[t].detected_.begin(), batches[t].detected_.end());
+		delete batches[t].solver_;
+	}
+	for (unsigned t = 0; t < num_threads; ++t)
+	{
+		set<unsigned>::iterator it;
+		for (it = batches[t].unknown_.begin(); it != batches[t].unknown_.end(); ++it)
+			markLatchUnknown(*it);
+	}
+}
+
+void DefinitelyProtected::checkLatchBatch(SatSolver* solver, const CnfRecorder& initial_relation,
+		const vector<int>& initial_results, int next_free_cnf_var,
+		const vector<unsigned>& latches, set<unsigned>& detected, set<unsigned>& unknown)
+{
+	initial_relation.replayInto(solver);
+	solver->incPush();
+
+	int next_free_cnf_var_after_first_step = next_free_cnf_var;
+	vector<int> results = initial_results;
+	SymbolicSimulator sim_symb(circuit_, solver, next_free_cnf_var);
+	sim_symb.setResults(results);
+	ConeOfInfluence coi(circuit_);
+
+	for (unsigned l_cnt = 0; l_cnt < latches.size(); ++l_cnt)
+	{
+		if (isGlobalBudgetExceeded())
+		{
+			unknown.insert(latches[l_cnt]);
+			continue;
+		}
+		// not startLatchBudget(), its stopwatch is shared by all threads
+		solver->setConflictLimit(Options::instance().getConflictLimit());
+		test_single_latch(solver, sim_symb, next_free_cnf_var, latches[l_cnt], coi, detected,
+				unknown);
+
+		// reset solver session
+		solver->incPop();
+		solver->incPush();
+		next_free_cnf_var = next_free_cnf_var_after_first_step;
+		results = initial_results;
+		sim_symb.setResults(results);
+	}
+}
+
 
 void DefinitelyProtected::test_single_latch(SatSolver* solver, SymbolicSimulator& sim_symb,
-		int& next_free_cnf_var, unsigned latch_aig)
+		int& next_free_cnf_var, unsigned latch_aig, ConeOfInfluence& coi,
+		set<unsigned>& detected, set<unsigned>& unknown)
 {
 	sim_symb.simulateOneTimeStep();
 	vector<int> next_state_normal = sim_symb.getNextLatchValues();
@@ -158,9 +380,13 @@ void DefinitelyProtected::test_single_latch(SatSolver* solver, SymbolicSimulator
 
 	int component_cnf = latch_aig >> 1;
 
-	// compute faulty transition relation
+	// compute faulty transition relation (AND gates outside the cone of influence keep
+	// their fault-free values)
+	coi.setFlippedLatch(latch_aig);
 	sim_symb.setResultValue(component_cnf, -sim_symb.getResultValue(component_cnf)); // flip latch
+	sim_symb.setAndMask(&coi.getAndMask());
 	sim_symb.simulateOneTimeStep();
+	sim_symb.setAndMask(0);
 
 	vector<int> next_state_flip = sim_symb.getNextLatchValues();
 	vector<int> outputs_flip = sim_symb.getOutputValues();
@@ -187,9 +413,16 @@ void DefinitelyProtected::test_single_latch(SatSolver* solver, SymbolicSimulator
 	vector<int> no_assumptions;
 	vector<int> model;
 
-	if (solver->incIsSatModelOrCore(no_assumptions, no_assumptions, model) == false)
+	bool sat = solver->incIsSatModelOrCore(no_assumptions, no_assumptions, model);
+	if (solver->isLastResultUnknown())
 	{
-		detected_latches_.insert(latch_aig);
+		if (detected.find(latch_aig) == detected.end())
+			unknown.insert(latch_aig);
+		L_DBG("UNKNOWN " << latch_aig << " (conflict limit exceeded)")
+	}
+	else if (sat == false)
+	{
+		detected.insert(latch_aig);
 		L_DBG("Definitely protected latch "<< latch_aig << " found. (UNSAT)");
 	}
 	else
@@ -211,15 +444,20 @@ void DefinitelyProtected::findDefinitelyProtected_1step_simultaneously()
 
 	// first time steps T(x,i,o,a,x') & -a
 	unsigned num_initial_steps = Options::instance().getDefinitevelyProtectedNumInitialSteps();
-	computeInitialTransitionRelation(solver, sim_symb, num_initial_steps);
+	computeInitialTransitionRelation(solver, sim_symb, num_initial_steps, next_free_cnf_var);
 
 	vector<int> next_state_normal = sim_symb.getNextLatchValues();
 	vector<int> outpus_normal = sim_symb.getOutputValues();
 
+	// the state and inputs of the checked step, to test counterexamples concretely
+	vector<int> state_lits = sim_symb.getLatchValues();
+	vector<int> input_lits = sim_symb.getInputValues();
+
 	// set up ci signals
 	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_,
 			num_err_latches_);
 	map<int, int> cj_to_latch; // maps cj-literals(cnf) to corresponding latch-literals(aig)
+	map<unsigned, int> latch_to_cj;
 	vector<int> c_vars;
 
 	// T_err(x,i,c,o,a,x') & -a:
@@ -231,24 +469,10 @@ void DefinitelyProtected::findDefinitelyProtected_1step_simultaneously()
 		c_vars.push_back(cj);
 		solver->addVarToKeep(cj);
 		cj_to_latch[cj] = latches_to_check[l_cnt];
+		latch_to_cj[latches_to_check[l_cnt]] = cj;
 
 		// add multiplexer to flip the latch
-		int old_value = sim_symb.getResultValue(latch_cnf);
-		if (old_value == CNF_TRUE) // old value is true
-			sim_symb.setResultValue(latch_cnf, -cj);
-		else if (old_value == CNF_FALSE) // old value is false
-			sim_symb.setResultValue(latch_cnf, cj);
-		else
-		{
-			int new_value = next_free_cnf_var++;
-			solver->addVarToKeep(new_value);
-			// new_value == cj ? -old_value : old_value
-			solver->incAdd3LitClause(cj, old_value, -new_value);
-			solver->incAdd3LitClause(cj, -old_value, new_value);
-			solver->incAdd3LitClause(-cj, old_value, new_value);
-			solver->incAdd3LitClause(-cj, -old_value, -new_value);
-			sim_symb.setResultValue(latch_cnf, new_value);
-		}
+		sim_symb.flipLatchIf(latch_cnf, cj);
 
 	}
 
@@ -289,7 +513,15 @@ void DefinitelyProtected::findDefinitelyProtected_1step_simultaneously()
 	vector<int> no_assumptions; // empty
 	vector<int> model;
 	parser.addVectorOfInterest(c_vars, "c_vars");
-	while (solver->incIsSatModelOrCore(no_assumptions, parser.getVarsOfInterrest(), model))
+	vector<int> vars_of_interest = parser.getVarsOfInterrest();
+	for (unsigned cnt = 0; cnt < state_lits.size(); ++cnt)
+		vars_of_interest.push_back(abs(state_lits[cnt]));
+	for (unsigned cnt = 0; cnt < input_lits.size(); ++cnt)
+		vars_of_interest.push_back(abs(input_lits[cnt]));
+
+	// every SAT call refutes the selected latch and, by simulating its counterexample, all other
+	// latches with the same state and input. The final UNSAT call proves all remaining latches.
+	while (solver->incIsSatModelOrCore(no_assumptions, vars_of_interest, model))
 	{
 		if (Logger::instance().isEnabled(Logger::DBG))
 			parser.parseAssignment(model);
@@ -299,11 +531,71 @@ void DefinitelyProtected::findDefinitelyProtected_1step_simultaneously()
 
 		solver->incAddUnitClause(-c_selected);
 		detected_latches_.erase(cj_to_latch[c_selected]);
+
+		vector<unsigned> candidates(detected_latches_.begin(), detected_latches_.end());
+		vector<unsigned> unprotected;
+		findUnprotectedBySimulation(model, state_lits, input_lits, candidates, unprotected);
+		for (unsigned cnt = 0; cnt < unprotected.size(); ++cnt)
+		{
+			solver->incAddUnitClause(-latch_to_cj[unprotected[cnt]]);
+			detected_latches_.erase(unprotected[cnt]);
+		}
+		L_DBG("SAT: " << (unprotected.size() + 1) << " latches refuted by one counterexample")
 	}
 
 	delete solver;
 }
 
+void DefinitelyProtected::findUnprotectedBySimulation(const vector<int>& model,
+		const vector<int>& state_lits, const vector<int>& input_lits,
+		const vector<unsigned>& candidates, vector<unsigned>& unprotected)
+{
+	set<int> true_lits(model.begin(), model.end());
+	vector<int> state(state_lits.size());
+	for (unsigned cnt = 0; cnt < state_lits.size(); ++cnt)
+	{
+		int lit = state_lits[cnt];
+		bool value = lit == CNF_TRUE || (lit != CNF_FALSE && true_lits.count(lit) != 0);
+		state[cnt] = value ? AIG_TRUE : AIG_FALSE;
+	}
+	vector<int> inputs(input_lits.size());
+	for (unsigned cnt = 0; cnt < input_lits.size(); ++cnt)
+	{
+		int lit = input_lits[cnt];
+		bool value = lit == CNF_TRUE || (lit != CNF_FALSE && true_lits.count(lit) != 0);
+		inputs[cnt] = value ? AIG_TRUE : AIG_FALSE;
+	}
+
+	map<unsigned, unsigned> latch_to_index;
+	for (unsigned cnt = 0; cnt < circuit_->num_latches; ++cnt)
+		latch_to_index[circuit_->latches[cnt].lit] = cnt;
+
+	AigSimulator sim(circuit_);
+	sim.simulateOneTimeStep(inputs, state);
+	vector<int> outputs_ok = sim.getOutputs();
+	vector<int> next_state_ok = sim.getNextLatchValues();
+	outputs_ok.pop_back(); // exclude alarm output
+	next_state_ok.erase(next_state_ok.end() - num_err_latches_, next_state_ok.end());
+
+	for (unsigned l_cnt = 0; l_cnt < candidates.size(); ++l_cnt)
+	{
+		unsigned index = latch_to_index[candidates[l_cnt]];
+		state[index] = aiger_not(state[index]);
+		sim.simulateOneTimeStep(inputs, state);
+		state[index] = aiger_not(state[index]);
+
+		vector<int> outputs_flip = sim.getOutputs();
+		if (outputs_flip.back() == AIG_TRUE) // alarm raised
+			continue;
+		outputs_flip.pop_back();
+		vector<int> next_state_flip = sim.getNextLatchValues();
+		next_state_flip.erase(next_state_flip.end() - num_err_latches_, next_state_flip.end());
+
+		if (outputs_flip != outputs_ok || next_state_flip != next_state_ok)
+			unprotected.push_back(candidates[l_cnt]);
+	}
+}
+
 void DefinitelyProtected::findDefinitelyProtected_kstep_single_latch()
 {
 	unsigned k_steps = Options::instance().getDefinitivelyProtectedKSteps();
@@ -316,7 +608,7 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_single_latch()
 	SymbolicSimulator sim_ok(circuit_, solver, next_free_cnf_var);
 
 	// first time steps T(x,i,o,a,x') & -a
-	computeInitialTransitionRelation(solver, sim_ok, num_initial_steps + 1);
+	computeInitialTransitionRelation(solver, sim_ok, num_initial_steps + 1, next_free_cnf_var);
 
 	int final_nxt_state_diff_enable = next_free_cnf_var++;
 
@@ -328,8 +620,16 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_single_latch()
 	// ---------------- BEGIN 'for each latch' -------------------------
 	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_,
 			num_err_latches_);
+	scheduleLatches(latches_to_check);
 	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
 	{
+		if (isGlobalBudgetExceeded())
+		{
+			markLatchUnknown(latches_to_check[l_cnt]);
+			continue;
+		}
+		startLatchBudget(solver);
+
 		vector<int> alarms_in_flipped_version_at_step_i; // maps i -> alarm signal of faulty verstion at step i
 		vector<int> output_different_at_step_i; // maps i -> different_at_i
 
@@ -337,6 +637,17 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_single_latch()
 		unsigned latch_aig = latches_to_check[l_cnt];
 		int component_cnf = latch_aig >> 1;
 
+		// AND gates outside the cone of influence get the values of the fault-free copy, and so
+		// do the gates inside whose inputs do not differ from the fault-free copy
+		coi_.setFlippedLatch(latch_aig);
+		AndCacheFor2Simulators cache(sim_ok.getResults(), sim_faulty.getResults(), solver,
+				next_free_cnf_var);
+		if (Options::instance().isDpShareGates())
+		{
+			sim_faulty.setAndMask(&coi_.getAndMask(), &sim_ok.getResults());
+			sim_faulty.setCache(&cache);
+		}
+
 		for (unsigned i = 0; i < k_steps; i++)
 		{
 			// set same open input values for both copies
@@ -350,6 +661,7 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_single_latch()
 				sim_faulty.setResultValue(component_cnf, -sim_faulty.getResultValue(component_cnf));
 			}
 			sim_faulty.simulateOneTimeStep();		// T_err(x_e,i,o_e,a_e,x'e)
+			coi_.extendToNextStep();
 
 			// store a_e
 			alarms_in_flipped_version_at_step_i.push_back(sim_faulty.getAlarmValue());
@@ -402,6 +714,9 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_single_latch()
 
 		}
 
+		L_DBG(cache.getNumSharedGates() << " AND gates shared with the fault-free copy, "
+				<< cache.getNumDifferentGates() << " in the difference cone")
+
 		// maps a literal that is true if there was no alarm set to true until time step k
 		vector<int> no_alarm_until;
 		no_alarm_until.push_back(-alarms_in_flipped_version_at_step_i[0]); // i=0: not a_0
@@ -461,6 +776,11 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_single_latch()
 		{
 			L_DBG("SAT " << latch_aig << "(not k-step protected)")
 		}
+		else if (solver->isLastResultUnknown())
+		{
+			markLatchUnknown(latch_aig);
+			L_DBG("UNKNOWN " << latch_aig << " (conflict limit exceeded)")
+		}
 		else
 		{
 			detected_latches_.insert(latch_aig);
@@ -489,6 +809,7 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_simultaneously()
 	SymbolicSimulator sim_ok(circuit_, solver, next_free_cnf_var);
 
 	sim_ok.setStateValuesOpen();
+	constrainToReachableStates(solver, sim_ok, next_free_cnf_var);
 	sim_ok.setInputValuesOpen();
 	sim_ok.simulateOneTimeStep();
 	solver->incAddUnitClause(-sim_ok.getAlarmValue());
@@ -536,22 +857,7 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_simultaneously()
 				cj_to_latch[cj] = latches_to_check[l_cnt];
 
 				// add multiplexer to flip the latch
-				int old_value = sim_faulty.getResultValue(latch_cnf);
-				if (old_value == CNF_TRUE) // old value is true
-					sim_faulty.setResultValue(latch_cnf, -cj);
-				else if (old_value == CNF_FALSE) // old value is false
-					sim_faulty.setResultValue(latch_cnf, cj);
-				else
-				{
-					int new_value = next_free_cnf_var++;
-					sim_faulty.setResultValue(latch_cnf, new_value);
-					solver->addVarToKeep(new_value);
-					// new_value == cj ? -old_value : old_value
-					solver->incAdd3LitClause(cj, old_value, -new_value);
-					solver->incAdd3LitClause(cj, -old_value, new_value);
-					solver->incAdd3LitClause(-cj, old_value, new_value);
-					solver->incAdd3LitClause(-cj, -old_value, -new_value);
-				}
+				sim_faulty.flipLatchIf(latch_cnf, cj);
 
 			}
 
@@ -694,11 +1000,218 @@ void DefinitelyProtected::findDefinitelyProtected_kstep_simultaneously()
 	delete solver;
 }
 
+void DefinitelyProtected::findDefinitelyProtected_kinduction()
+{
+	unsigned max_k = Options::instance().getKInductionMaxDepth();
+	unsigned num_initial_steps = Options::instance().getDefinitevelyProtectedNumInitialSteps();
+
+	// ---------------- BEGIN 'for each latch' -------------------------
+	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_,
+			num_err_latches_);
+	scheduleLatches(latches_to_check);
+	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
+	{
+		unsigned latch_aig = latches_to_check[l_cnt];
+		if (isGlobalBudgetExceeded())
+		{
+			markLatchUnknown(latch_aig);
+			continue;
+		}
+		int component_cnf = latch_aig >> 1;
+
+		// the step case starts in an arbitrary state, but all latches outside the closed cone of
+		// influence of the flipped latch are still equal in both copies
+		coi_.setFlippedLatch(latch_aig);
+		while (coi_.extendToNextStep())
+			;
+		vector<bool> closed_and_mask = coi_.getAndMask();
+		vector<bool> tainted_latches = coi_.getTaintedLatches();
+		coi_.setFlippedLatch(latch_aig);
+
+		// base case: first time steps T(x,i,o,a,x') & -a, then flip and unroll both copies
+		int base_next_free_cnf_var = 2;
+		SatSolver* base_solver = Options::instance().getSATSolver();
+		vector<int> vars_to_keep; // empty
+		base_solver->startIncrementalSession(vars_to_keep);
+		startLatchBudget(base_solver);
+		SymbolicSimulator base_ok(circuit_, base_solver, base_next_free_cnf_var);
+		computeInitialTransitionRelation(base_solver, base_ok, num_initial_steps + 1,
+				base_next_free_cnf_var);
+		SymbolicSimulator base_faulty(circuit_, base_solver, base_next_free_cnf_var);
+		AndCacheFor2Simulators base_cache(base_ok.getResults(), base_faulty.getResults(),
+				base_solver, base_next_free_cnf_var);
+		if (Options::instance().isDpShareGates())
+		{
+			base_faulty.setAndMask(&coi_.getAndMask(), &base_ok.getResults());
+			base_faulty.setCache(&base_cache);
+		}
+
+		// step case: open state (x, x_e), x_e differs from x only in the tainted latches
+		int step_next_free_cnf_var = 2;
+		SatSolver* step_solver = Options::instance().getSATSolver();
+		step_solver->startIncrementalSession(vars_to_keep);
+		step_solver->setConflictLimit(Options::instance().getConflictLimit());
+		SymbolicSimulator step_ok(circuit_, step_solver, step_next_free_cnf_var);
+		SymbolicSimulator step_faulty(circuit_, step_solver, step_next_free_cnf_var);
+		step_ok.setStateValuesOpen();
+		constrainToReachableStates(step_solver, step_ok, step_next_free_cnf_var);
+		step_faulty.setResults(step_ok.getResults());
+		for (unsigned l = 0; l < circuit_->num_latches; ++l)
+		{
+			if (tainted_latches[l])
+				step_faulty.setResultValue(circuit_->latches[l].lit >> 1, step_next_free_cnf_var++);
+		}
+		AndCacheFor2Simulators step_cache(step_ok.getResults(), step_faulty.getResults(),
+				step_solver, step_next_free_cnf_var);
+		if (Options::instance().isDpShareGates())
+		{
+			step_faulty.setAndMask(&closed_and_mask, &step_ok.getResults());
+			step_faulty.setCache(&step_cache);
+		}
+
+		// the states (x, x_e) of the step case per step, and their variables
+		vector<vector<int> > step_states;
+		vector<int> step_state_vars;
+
+		int step_alarm = 0;
+		int step_outputs_different = 0;
+		bool decided = false;
+		for (unsigned k = 1; k <= max_k; k++)
+		{
+			if (isBudgetExceeded())
+				break;
+
+			// ---------- base case: error in step k-1? ----------
+			if (k > 1)
+			{
+				base_ok.switchToNextState();
+				base_faulty.switchToNextState();
+			}
+			base_ok.setInputValuesOpen();
+			base_faulty.setCnfInputValues(base_ok.getInputValues());
+			base_ok.simulateOneTimeStep();
+			if (k == 1) // flip in first step
+			{
+				base_faulty.setResults(base_ok.getResults());
+				base_faulty.setResultValue(component_cnf, -base_faulty.getResultValue(component_cnf));
+			}
+			base_faulty.simulateOneTimeStep();
+			coi_.extendToNextStep();
+			base_solver->incAddUnitClause(-base_ok.getAlarmValue()); // -a
+
+			// error -> (-a_e & o != o_e), no alarm in the previous steps is asserted already
+			int base_alarm = base_faulty.getAlarmValue();
+			int base_error = base_next_free_cnf_var++;
+			base_solver->addVarToKeep(base_error);
+			base_solver->incAdd2LitClause(-base_error, -base_alarm);
+			base_solver->incAdd2LitClause(-base_error,
+					createOutputsDifferentLiteral(base_solver, base_ok, base_faulty,
+							base_next_free_cnf_var));
+
+			vector<int> base_assumptions;
+			base_assumptions.push_back(base_error);
+			if (base_solver->incIsSat(base_assumptions))
+			{
+				L_DBG("SAT " << latch_aig << " (not protected, error in step " << k - 1 << ")")
+				decided = true;
+				break;
+			}
+			if (base_solver->isLastResultUnknown())
+				break;
+
+			// an error in a later step requires that the alarm has not been raised so far
+			base_solver->incAddUnitClause(-base_alarm);
+
+			// ---------- step case: k error-free steps followed by an error? ----------
+			for (unsigned s = (k == 1 ? 0 : k); s <= k; ++s)
+			{
+				if (s > 0)
+				{
+					// the previous step becomes one of the error-free steps
+					step_solver->incAddUnitClause(-step_alarm);
+					step_solver->incAddUnitClause(-step_outputs_different);
+					step_ok.switchToNextState();
+					step_faulty.switchToNextState();
+				}
+
+				vector<int> state;
+				for (unsigned l = 0; l < circuit_->num_latches; ++l)
+					state.push_back(step_ok.getResultValue(circuit_->latches[l].lit >> 1));
+				for (unsigned l = 0; l < circuit_->num_latches; ++l)
+				{
+					if (tainted_latches[l])
+						state.push_back(step_faulty.getResultValue(circuit_->latches[l].lit >> 1));
+				}
+				for (unsigned l = 0; l < state.size(); ++l)
+				{
+					if (abs(state[l]) > 1)
+					{
+						step_solver->addVarToKeep(abs(state[l]));
+						step_state_vars.push_back(abs(state[l]));
+					}
+				}
+				step_states.push_back(state);
+
+				step_ok.setInputValuesOpen();
+				step_faulty.setCnfInputValues(step_ok.getInputValues());
+				step_ok.simulateOneTimeStep();
+				step_faulty.simulateOneTimeStep();
+				step_solver->incAddUnitClause(-step_ok.getAlarmValue()); // -a
+				step_alarm = step_faulty.getAlarmValue();
+				step_outputs_different = createOutputsDifferentLiteral(step_solver, step_ok,
+						step_faulty, step_next_free_cnf_var);
+			}
+
+			int step_error = step_next_free_cnf_var++;
+			step_solver->addVarToKeep(step_error);
+			step_solver->incAdd2LitClause(-step_error, -step_alarm);
+			step_solver->incAdd2LitClause(-step_error, step_outputs_different);
+
+			vector<int> step_assumptions;
+			step_assumptions.push_back(step_error);
+			bool step_sat = true;
+			while (step_sat)
+			{
+				vector<int> model;
+				step_sat = step_solver->incIsSatModelOrCore(step_assumptions, step_state_vars, model);
+
+				// a counterexample to induction, unless it visits a state twice
+				if (step_sat
+						&& (isBudgetExceeded()
+								|| !addSimplePathConstraints(step_solver, step_states, model,
+										step_next_free_cnf_var)))
+					break;
+			}
+			if (!step_sat)
+			{
+				if (step_solver->isLastResultUnknown())
+					break;
+				detected_latches_.insert(latch_aig);
+				L_DBG("Definitely protected latch " << latch_aig << " found. (" << k << "-inductive)")
+				decided = true;
+				break;
+			}
+		}
+
+		if (!decided)
+		{
+			markLatchUnknown(latch_aig);
+			L_DBG("UNKNOWN " << latch_aig << " (neither proven nor refuted)")
+		}
+
+		delete base_solver;
+		delete step_solver;
+	}
+
+}
+
 void DefinitelyProtected::printResults()
 {
 	float percentage = (float) detected_latches_.size() / Options::instance().getNumberOfLatchesToCheck() * 100;
 	L_LOG(
 			"#Definitely protected latches found: " << detected_latches_.size() << " (" << percentage << " %)");
+	if (!unknown_latches_.empty())
+		L_LOG("#Unknown (budget exceeded): " << unknown_latches_.size());
 
 	if (Options::instance().isUseDiagnosticOutput())
 	{
@@ -30,8 +30,12 @@
 #include "BackEnd.h"
 #include "SatSolver.h"
 #include "SymbolicSimulator.h"
+#include "ConeOfInfluence.h"
+
+class CnfRecorder;
 
 struct aiger;
+class BddReachability;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -67,12 +71,109 @@ public:
 	void findDefinitelyProtected_kstep_single_latch();
 	void findDefinitelyProtected_kstep_simultaneously();
 
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief proves the latches protected for an unbounded number of steps with k-induction
+	///
+	/// For every latch, k is increased (up to --kind_max) until either the base case finds a
+	/// path from the (open) initial state on which the flip changes an output before the alarm
+	/// is raised (not protected), or the step case shows that k steps without such an error
+	/// cannot be followed by one (protected). Both cases keep their own incremental solver,
+	/// which is extended by one step for every k. Simple-path constraints are only added to the
+	/// step case for those pairs of states which repeat in a counterexample to induction.
+	void findDefinitelyProtected_kinduction();
+
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief checks a batch of latches like findDefinitelyProtected_1step_single() (one thread
+	/// of --dp_threads)
+	///
+	/// Does not modify any member, so several batches can be checked concurrently.
+	///
+	/// @param solver the solver to use, its incremental session is (re-)started.
+	/// @param initial_relation the recorded initial transition relation.
+	/// @param initial_results the results of the SymbolicSimulator after the initial relation.
+	/// @param next_free_cnf_var the next free CNF variable after the initial relation.
+	/// @param latches the latches to check.
+	/// @param detected the latches found to be protected are inserted here.
+	/// @param unknown the latches exceeding the conflict limit are inserted here.
+	void checkLatchBatch(SatSolver* solver, const CnfRecorder& initial_relation,
+			const vector<int>& initial_results, int next_free_cnf_var,
+			const vector<unsigned>& latches, set<unsigned>& detected, set<unsigned>& unknown);
+
 	void printResults();
 
 
 protected:
-	void test_single_latch(SatSolver* solver, SymbolicSimulator& sim_symb, int& next_free_cnf_var, unsigned latch_aig);
-	void computeInitialTransitionRelation(SatSolver* solver, SymbolicSimulator& sim_symb, unsigned num_steps);
+	void test_single_latch(SatSolver* solver, SymbolicSimulator& sim_symb, int& next_free_cnf_var,
+			unsigned latch_aig, ConeOfInfluence& coi, set<unsigned>& detected,
+			set<unsigned>& unknown);
+
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief distributes the latches over --dp_threads threads, see checkLatchBatch()
+	///
+	/// The initial transition relation is built only once (into a CnfRecorder) and loaded into
+	/// the solver of every thread.
+	///
+	/// @param latches_to_check the (scheduled) latches to check.
+	void findDefinitelyProtected_1step_parallel(const vector<unsigned>& latches_to_check);
+	void computeInitialTransitionRelation(SatSolver* solver, SymbolicSimulator& sim_symb,
+			unsigned num_steps, int& next_free_cnf_var);
+
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief restricts the current state of sim_symb to the reachable states (see --dp_reach)
+	///
+	/// Does nothing if the reachable states have not been computed.
+	///
+	/// @param solver the solver to add the constraint to.
+	/// @param sim_symb the simulator whose current (open) state is restricted.
+	/// @param next_free_cnf_var the next free CNF variable, will be increased.
+	void constrainToReachableStates(SatSolver* solver, SymbolicSimulator& sim_symb,
+			int& next_free_cnf_var);
+
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief creates a literal which is true iff the outputs (except the alarm output) of the
+	/// two simulators differ in the current step
+	///
+	/// @param solver the solver to add the definition to.
+	/// @param sim_a the first simulator (already simulated).
+	/// @param sim_b the second simulator (already simulated).
+	/// @param next_free_cnf_var the next free CNF variable, will be increased.
+	/// @return the new literal
+	int createOutputsDifferentLiteral(SatSolver* solver, SymbolicSimulator& sim_a,
+			SymbolicSimulator& sim_b, int& next_free_cnf_var);
+
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief tests candidate latches concretely on the state and input of a counterexample
+	///
+	/// Simulates the last initial step once without and once per candidate with a flip of this
+	/// candidate. A candidate is not protected if its flip does not raise the alarm but changes
+	/// an output or the next state (except the error latches).
+	///
+	/// @param model a satisfying assignment over the variables of the state and the inputs.
+	/// @param state_lits the CNF literals of the (fault-free) latches.
+	/// @param input_lits the CNF literals of the inputs.
+	/// @param candidates the latches (AIGER literals) to test.
+	/// @param unprotected the candidates which are not protected are appended here.
+	void findUnprotectedBySimulation(const vector<int>& model, const vector<int>& state_lits,
+			const vector<int>& input_lits, const vector<unsigned>& candidates,
+			vector<unsigned>& unprotected);
+
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief requires all pairs of states which are equal in the model to be different
+	///
+	/// @param solver the solver to add the constraints to.
+	/// @param states the states of the step case (CNF literals of the latches), per step.
+	/// @param model a satisfying assignment over the variables of the states.
+	/// @param next_free_cnf_var the next free CNF variable, will be increased.
+	/// @return true if at least one pair of states was equal, i.e., a constraint was added.
+	bool addSimplePathConstraints(SatSolver* solver, const vector<vector<int> >& states,
+			const vector<int>& model, int& next_free_cnf_var);
 
 	// -------------------------------------------------------------------------------------------
 	///
@@ -90,6 +191,17 @@ protected:
 	/// protection circuit.
 	unsigned num_err_latches_;
 
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief the cone of influence of the currently flipped latch. The faulty copy of the
+	/// circuit only encodes the AND gates inside this cone.
+	ConeOfInfluence coi_;
+
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief the reachable states of the circuit, 0 if --dp_reach is not given
+	BddReachability* reachability_;
+
 
 private:
 
@@ -28,15 +28,42 @@
 #include "AigSimulator.h"
 #include "SymbolicSimulator.h"
 #include "Options.h"
+#include "FaultCollapsing.h"
 #include "Utils.h"
 #include "Logger.h"
 #include "TestCaseProvider.h"
+#include "AnalysisJournal.h"
 
 extern "C"
 {
 #include "aiger.h"
 }
 
+#include <stdint.h>
+#include <pthread.h>
+
+// -------------------------------------------------------------------------------------------
+static inline uint64_t readWord(const vector<uint64_t> &values, unsigned aigerlit)
+{
+	return aigerlit & 1 ? ~values[aigerlit >> 1] : values[aigerlit >> 1];
+}
+
+// -------------------------------------------------------------------------------------------
+static inline uint64_t broadcast(int aig_value)
+{
+	return aig_value == AIG_TRUE ? ~0ULL : 0ULL;
+}
+
+// -------------------------------------------------------------------------------------------
+static vector<int> toCnfConstants(const vector<int>& aig_values)
+{
+	vector<int> cnf_values;
+	cnf_values.reserve(aig_values.size());
+	for (unsigned cnt = 0; cnt < aig_values.size(); ++cnt)
+		cnf_values.push_back(aig_values[cnt] == AIG_TRUE ? CNF_TRUE : CNF_FALSE);
+	return cnf_values;
+}
+
 // -------------------------------------------------------------------------------------------
 FalsePositives::FalsePositives(aiger* circuit, int num_err_latches, bool only_one_trace_per_latch, int mode) :
 				BackEnd(circuit, num_err_latches, mode)
@@ -45,6 +72,7 @@ FalsePositives::FalsePositives(aiger* circuit, int num_err_latches, bool only_on
 	num_err_latches_ = num_err_latches;
 	mode_ = mode;
 	only_one_trace_per_latch_ = only_one_trace_per_latch;
+	num_journaled_traces_ = 0;
 
 }
 
@@ -61,6 +89,16 @@ void FalsePositives::analyze()
 
 bool FalsePositives::analyze(vector<TestCase>& testcases)
 {
+	if (latch_subset_.empty()) // groups (see analyzePartitioned()) do not split again
+	{
+		openJournal();
+		unsigned num_threads = Options::instance().getFpThreads();
+		if (num_threads > 1)
+		{
+			analyzePartitioned(testcases, num_threads);
+			return (superfluous.size() != 0);
+		}
+	}
 
 	if (mode_ == FalsePositives::SYMB_TIME)	// TODO: split into meaningful BackEnd groups
 		findFalsePositives_1b(testcases);
@@ -78,1261 +116,522 @@ bool FalsePositives::analyze(vector<TestCase>& testcases)
 
 bool FalsePositives::findFalsePositives_1b(vector<TestCase>& testcases)
 {
-	clearSuperfluousList();
-	int next_free_cnf_var = 2;
-
-	SatSolver* solver_ = Options::instance().getSATSolver();
-	AigSimulator* sim_concrete = new AigSimulator(circuit_);
-	SymbolicSimulator sim_symb(circuit_, solver_, next_free_cnf_var);
-	AigSimulator* sim_env = 0;
-	if (environment_model_)
-		sim_env = new AigSimulator(environment_model_);
-
-
-	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_,
-			num_err_latches_);
-	map<unsigned, unsigned> literal_to_idx;
-	Utils::genLit2IndexMap(latches_to_check, circuit_, literal_to_idx);
-
-	bool continue_with_next_latch;
-	// ---------------- BEGIN 'for each latch' -------------------------
-	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
-	{
-		continue_with_next_latch = false;
-		next_free_cnf_var = 2;
-
-		unsigned component_aig = latches_to_check[l_cnt];
-		int component_cnf = component_aig >> 1;
-
-		for (unsigned tci = 0; tci < testcases.size(); tci++)
-		{
-			TestCase& testcase = testcases[tci];
-
-			// initial state for concrete simulation = (0 0 0 0 0 0 0)  (AIG literals)
-			vector<int> concrete_state_ok;
-			concrete_state_ok.resize(circuit_->num_latches);
-			sim_symb.initLatches();
-			if (environment_model_)
-				sim_env->initLatches();
-
-			// start new incremental SAT-solving session
-			vector<int> vars_to_keep;
-			vars_to_keep.push_back(CNF_FALSE);
-			solver_->startIncrementalSession(vars_to_keep, 0);
-			solver_->incAddUnitClause(CNF_TRUE);
-			// set of literals to enable or disable the represented clauses, used for incremental solving.
-			vector<int> enable_literals;
-
-			// f = a set of variables fi indicating whether the latch is flipped in step i or not
-			vector<int> f;
-			map<int, unsigned> fi_to_timestep;
-
-			// set of literals representing the alarm output for each timestep
-			vector<int> alarm_literals;
-			map<int, unsigned> alarmlit_to_timestep;
-
-			for (unsigned timestep = 0; timestep < testcase.size(); timestep++)
-			{
-//				Utils::debugPrint(testcase[timestep], "Test inputs");
-				//------------------------------------------------------------------------------------
-				// Concrete simulations:
-				// correct simulation
-				sim_concrete->simulateOneTimeStep(testcase[timestep], concrete_state_ok);
-				vector<int> outputs_ok = sim_concrete->getOutputs();
-				bool alarm_ok = outputs_ok.back() == AIG_TRUE;
-				//Utils::debugPrint(outputs_ok,"outputs_ok");
-				if (alarm_ok)
-				{
-					cout << "Alarm raised without Error!" << endl;
-					return true;
-				}
-				vector<int> next_state_ok = sim_concrete->getNextLatchValues();
-
-				// flip latch
-				vector<int> faulty_state = concrete_state_ok;
-				unsigned index = literal_to_idx[component_aig];
-				faulty_state[index] = (faulty_state[index] == AIG_TRUE) ? AIG_FALSE : AIG_TRUE;
-
-				// faulty simulation with flipped latch
-				sim_concrete->simulateOneTimeStep(testcase[timestep], faulty_state);
-				vector<int> outputs_faulty = sim_concrete->getOutputs();
-				vector<int> next_state_faulty = sim_concrete->getNextLatchValues();
-				bool alarm_faulty = outputs_faulty.back() == AIG_TRUE;
-				//------------------------------------------------------------------------------------
-
-				bool equal_concrete_outputs = isEqualN(outputs_ok, outputs_faulty, 1);
-				bool equal_concrete_states = (next_state_ok == next_state_faulty);//isEqualN(next_state_ok, next_state_faulty, num_err_latches_);
-
-				sim_symb.setInputValues(testcase[timestep]);
-
-				if (equal_concrete_outputs && equal_concrete_states && alarm_faulty)
-				{
-					addSuperfluousTrace(component_aig, index, testcase, timestep, timestep, timestep + 1);
-					sim_symb.simulateOneTimeStep();
-					alarm_literals.push_back(sim_symb.getAlarmValue());
-					alarmlit_to_timestep[sim_symb.getAlarmValue()] = timestep;
-					sim_symb.switchToNextState();
-
-					// switch concrete simulation to next state
-					concrete_state_ok = next_state_ok; // OR: change to sim_->switchToNextState();
-
-					if (only_one_trace_per_latch_)
-					{
-						continue_with_next_latch = true;
-						break;
-					}
-					continue;
-				}
-
-				if (equal_concrete_outputs) // set TRUE for testing
-				{
-					// f variables:
-					int fi = next_free_cnf_var++;
-					solver_->addVarToKeep(fi);
-
-					int old_value = sim_symb.getResultValue(component_cnf);
-					if (old_value == CNF_TRUE) // old value is true
-						sim_symb.setResultValue(component_cnf, -fi);
-					else if (old_value == CNF_FALSE) // old value is false
-						sim_symb.setResultValue(component_cnf, fi);
-					else
-					{
-						int new_value = next_free_cnf_var++;
-						solver_->addVarToKeep(new_value);
-						// new_value = fi ? -old_value : old_value
-						solver_->incAdd3LitClause(fi, old_value, -new_value);
-						solver_->incAdd3LitClause(fi, -old_value, new_value);
-						solver_->incAdd3LitClause(-fi, old_value, new_value);
-						solver_->incAdd3LitClause(-fi, -old_value, -new_value);
-						sim_symb.setResultValue(component_cnf, new_value);
-					}
-
-					// there might be at most one flip in one time-step:
-					// if fi is true, all oter f must be false (fi -> -f1, fi -> -f2, ...)
-					for (unsigned cnt = 0; cnt < f.size(); cnt++)
-						solver_->incAdd2LitClause(-fi, -f[cnt]);
-
-					f.push_back(fi);
-					fi_to_timestep[fi] = timestep;
-
-				}
-
-
-
-				sim_symb.simulateOneTimeStep();
-				alarm_literals.push_back(sim_symb.getAlarmValue());
-				alarmlit_to_timestep[sim_symb.getAlarmValue()] = timestep;
-
-				vector<int> output_is_relevant;
-				if (environment_model_)
-				{
-					vector<int> env_input;
-					const vector<int>& input_values = testcase[timestep];
-
-					env_input.reserve(input_values.size() + outputs_ok.size());
-					env_input.insert(env_input.end(), input_values.begin(),
-							input_values.end());
-					env_input.insert(env_input.end(), outputs_ok.begin(), outputs_ok.end());
-
-					sim_env->simulateOneTimeStep(env_input);
-					output_is_relevant = sim_env->getOutputs();
-					sim_env->switchToNextState();
-				}
-
-				//------------------------------------------------------------------------------------
-				// unit clauses saying that the current (relevant) outputs are equal
-				const vector<int> &out_cnf_values = sim_symb.getOutputValues();
-				for (unsigned output_idx = 0;
-						output_idx < outputs_ok.size() - 1;	++output_idx) {
-
-					// skip if output is not relevant
-					if (environment_model_ && output_is_relevant[output_idx] == AIG_FALSE)
-						continue;
-
-					if (outputs_ok[output_idx] == AIG_FALSE)
-						solver_->incAddUnitClause(-out_cnf_values[output_idx]);
-					else
-						solver_->incAddUnitClause(out_cnf_values[output_idx]);
-
-
-				}
-				//------------------------------------------------------------------------------------
-
-                sim_symb.switchToNextState();
-				const vector<int> &next_cnf_values = sim_symb.getLatchValues();
-
-
-				//------------------------------------------------------------------------------------
-				int curr_enable_literal = next_free_cnf_var++;
-				solver_->addVarToKeep(curr_enable_literal);
-				enable_literals.push_back(curr_enable_literal);
-
-				vector<int> current_alarm_clause = alarm_literals;
-				current_alarm_clause.push_back(curr_enable_literal);
-				solver_->incAddClause(current_alarm_clause);
-				//---------------------------------------------timeste---------------------------------------
-				// assumptions saying that the states are equal
-				vector<int> assumptions;
-				assumptions.reserve(next_cnf_values.size() - num_err_latches_ + enable_literals.size());
-				assumptions = enable_literals;
-				assumptions.back() = -assumptions.back();
-
-				for (unsigned state_idx = 0;
-						state_idx < next_cnf_values.size() - num_err_latches_;
-						++state_idx) {
-					if (next_state_ok[state_idx] == AIG_FALSE)
-						assumptions.push_back(-next_cnf_values[state_idx]);
-					else
-						assumptions.push_back(next_cnf_values[state_idx]);
-
-				}
-//				Utils::debugPrint(assumptions, "Assumptions: ");
-
-				//------------------------------------------------------------------------------------
-
-				// switch concrete simulation to next state
-				concrete_state_ok = next_state_ok; // OR: change to sim_->switchToNextState();
-
-				//------------------------------------------------------------------------------------
-				// call SAT-solver
-				vector<int> vars_of_interest = f;
-				vars_of_interest.insert(vars_of_interest.end(), alarm_literals.begin(), alarm_literals.end());
-
-				vector<int> model;
-				while (solver_->incIsSatModelOrCore(assumptions, vars_of_interest, model))
-				{
-					Utils::debugPrint(model,"model");
-					SuperfluousTrace* sf = new SuperfluousTrace(testcase);
-					sf->component_ = component_aig;
-					detected_latches_.insert(component_aig);
-					sf->component_index_ = index;
-					sf->error_gone_timestep_ = timestep + 1;
-					detected_latches_.insert(component_aig);
-					unsigned earliest_alarm_timestep = timestep + 1;
-					//parse:
-					int fj = 0;
-					for (unsigned model_count = 0; model_count < model.size(); model_count++)
-					{
-						int lit = model[model_count];
-
-						if (lit < 0)
-							continue;
-
-						// parse f time step
-						map<int, unsigned>::iterator it = fi_to_timestep.find(lit);
-						if (lit > 0 && it != fi_to_timestep.end()) // we have found the fi variable which was set to TRUE
-						{
-							fj = lit;
-							solver_->incAddUnitClause(-fj);
-
-							sf->flip_timestep_ = it->second;
-							continue;
-						}
-
-						// parse earliest alarm time step
-						it = alarmlit_to_timestep.find(lit);
-						if(it != alarmlit_to_timestep.end() && it->second < earliest_alarm_timestep)
-						{
-							earliest_alarm_timestep = it->second;
-						}
-
-					}
-
-					if(earliest_alarm_timestep != timestep + 1)
-						sf->alarm_timestep_ = earliest_alarm_timestep;
-					else
-					{
-						//L_DBG("same literal for f and alarm..")
-						sf->alarm_timestep_ = alarmlit_to_timestep[fj];
-					}
-					L_DBG("[sat]  flip_timestep=" << sf->flip_timestep_ << ", alarm_timestep=" << sf->alarm_timestep_ << ",error_gone_ts=" << timestep+1)
-					superfluous.push_back(sf);
-
-					if (only_one_trace_per_latch_)
-					{
-						continue_with_next_latch = true;
-						break;
-					}
-
-				}
-
-				if (continue_with_next_latch)
-					break;
-
-			} // -- END "for each timestep in testcase" --
-
-			if (continue_with_next_latch)
-				break;
-		} // end "for each testcase"
-	} // ------ END 'for each latch' ---------------
-
-
-	if(sim_env)
-		delete sim_env;
-	delete sim_concrete;
-	delete solver_;
-
-	return superfluous.size() != 0;
+	return findFalsePositives(testcases, false, false);
 }
 
 bool FalsePositives::findFalsePositives_2b(vector<TestCase>& testcases)
 {
-	clearSuperfluousList();
-
-	int next_free_cnf_var = 2;
-
-	SatSolver* solver_ = Options::instance().getSATSolver();
-	AigSimulator* sim_concrete = new AigSimulator(circuit_);
-	SymbolicSimulator sim_symb(circuit_, solver_, next_free_cnf_var);
-	AigSimulator* sim_env = 0;
-	if (environment_model_)
-		sim_env = new AigSimulator(environment_model_);
+	return findFalsePositives(testcases, true, false);
+}
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
-	set<int> latches_to_check;
+bool FalsePositives::findFalsePositives_1b_free_inputs(vector<TestCase>& testcases)
+{
+	return findFalsePositives(testcases, false, true);
+}
 
-	//------------------------------------------------------------------------------------------
-	// set up ci signals
-	// maps for latch-literals <=> cj-literals: each latch has a corresponding cj literal,
-	// which indicates whether the latch is flipped or not.
-	map<int, int> latch_to_cj; // maps latch-literals(cnf) to corresponding cj-literals(cnf)
-	map<int, int> cj_to_latch; // maps cj-literals(cnf) to corresponding latch-literals(aig)
+bool FalsePositives::findFalsePositives_2b_free_inputs(vector<TestCase>& testcases)
+{
+	return findFalsePositives(testcases, true, true);
+}
 
-	for (unsigned c_cnt = 0; c_cnt < l_list.size(); ++c_cnt)
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the solver, the simulators and the flipped latches of FalsePositives::findFalsePositives()
+///
+/// Shared by all test-cases of a run. Each test-case starts a new incremental session.
+struct FpUnrolling
+{
+	FpUnrolling(aiger* circuit, aiger* environment_model, bool symb_location, bool free_inputs) :
+			symb_location_(symb_location), free_inputs_(free_inputs),
+			solver_(Options::instance().getSATSolver()), next_free_cnf_var_(2),
+			first_free_cnf_var_(2), sim_concrete_(0), sim_ok_(0), sim_symb_(0), env_concrete_(0),
+			env_symb_(0)
 	{
-		latches_to_check.insert(l_list[c_cnt]);
-		int cj = next_free_cnf_var++;
-		latch_to_cj[l_list[c_cnt] >> 1] = cj;
-		cj_to_latch[cj] = l_list[c_cnt];
+		sim_symb_ = new SymbolicSimulator(circuit, solver_, next_free_cnf_var_);
+		if (free_inputs_)
+			sim_ok_ = new SymbolicSimulator(circuit, solver_, next_free_cnf_var_);
+		else
+			sim_concrete_ = new AigSimulator(circuit);
+		if (environment_model && free_inputs_)
+			env_symb_ = new SymbolicSimulator(environment_model, solver_, next_free_cnf_var_);
+		else if (environment_model)
+			env_concrete_ = new AigSimulator(environment_model);
 	}
-	int next_cnf_var_after_ci_vars = next_free_cnf_var;
-	//------------------------------------------------------------------------------------------
 
-
-	// for each testcase
-	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
+	~FpUnrolling()
 	{
-		TestCase& testcase = testcases[tc_number];
-
-		// initial state for concrete simulation = (0 0 0 0 0 0 0)  (AIG literals)
-		vector<int> concrete_state_ok;
-		concrete_state_ok.resize(circuit_->num_latches);
-		sim_symb.initLatches();
-		if (environment_model_)
-			sim_env->initLatches();
-
-		// f = a set of variables fi indicating whether the latch is *flipped in _step_ i* or not
-		vector<int> f;
-		map<int, unsigned> fi_to_timestep;
-
-		// set of literals representing the alarm output for each timestep
-		vector<int> alarm_literals;
-		map<int, unsigned> alarmlit_to_timestep;
-
-		// a set of cj-literals indicating whether *the _latch_ C_j is flipped* or not
-		vector<int> cj_literals;
-		map<int, int>::iterator map_iter;
-		for (map_iter = latch_to_cj.begin(); map_iter != latch_to_cj.end(); map_iter++)
-		{
-			cj_literals.push_back(map_iter->second);
-		}
-
-		// start new incremental SAT-solving session
-		solver_->startIncrementalSession(cj_literals, 0);
-		solver_->addVarToKeep(abs(CNF_TRUE));
-		solver_->incAddUnitClause(CNF_TRUE); // CNF_TRUE= unit-clause representing TRUE constant
-
-		// set of literals to enable or disable the represented clauses, used for incremental solving.
-		vector<int> enable_literals;
-
-		//----------------------------------------------------------------------------------------
-		// single fault assumption: there might be at most one flipped component
-		map<int, int>::iterator map_iter2;
-		for (map_iter = latch_to_cj.begin(); map_iter != latch_to_cj.end(); map_iter++)
-		{
-			map_iter2 = map_iter;
-			map_iter2++;
-			for (; map_iter2 != latch_to_cj.end(); map_iter2++)
-				solver_->incAdd2LitClause(-map_iter->second, -map_iter2->second);
-		}
-
-
-
-
-
-		// if environment-model: define which output is relevant at which point in time:
-//		AigSimulator* environment_sim = 0;
-//		if (environment_model_)
-//			environment_sim = new AigSimulator(environment_model_);
+		delete sim_symb_;
+		delete sim_ok_;
+		delete sim_concrete_;
+		delete env_symb_;
+		delete env_concrete_;
+		delete solver_;
+	}
 
-		for (unsigned timestep = 0; timestep < testcase.size(); timestep++)
-		{ // -------- BEGIN "for each timestep in testcase" --------------------------------------
+	// all latches at once, the flipped one is selected by its cj literal (modes 1 and 3)
+	bool symb_location_;
+	// the fault-free run is symbolic, open inputs are chosen by the solver (modes 2 and 3)
+	bool free_inputs_;
+	SatSolver* solver_;
+	int next_free_cnf_var_;
+	// the first variable after the cj literals, each test-case starts here
+	int first_free_cnf_var_;
+	// the fault-free run: concrete, or symbolic with free inputs
+	AigSimulator* sim_concrete_;
+	SymbolicSimulator* sim_ok_;
+	// the faulty run
+	SymbolicSimulator* sim_symb_;
+	AigSimulator* env_concrete_;
+	SymbolicSimulator* env_symb_;
+	// the latches which are flipped (only one in modes 0 and 2)
+	set<unsigned> latches_to_check_;
+	map<unsigned, unsigned> literal_to_idx_;
+	// maps latch-literals(cnf) to their cj-literals(cnf), and back to the latch-literals(aig)
+	map<int, int> latch_to_cj_;
+	map<int, int> cj_to_latch_;
+};
 
-			//--------------------------------------------------------------------------------------
-			// Concrete simulations:
-			sim_concrete->simulateOneTimeStep(testcase[timestep], concrete_state_ok);
-			vector<int> outputs_ok = sim_concrete->getOutputs();
-			vector<int> next_state_ok = sim_concrete->getNextLatchValues();
-			bool alarm_ok = outputs_ok.back() == AIG_TRUE;
-			if (alarm_ok)
-			{
-				cout << "Alarm raised without Error!" << endl;
-				return true;
-			}
-
-			//--------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------
+bool FalsePositives::findFalsePositives(vector<TestCase>& testcases, bool symb_location,
+		bool free_inputs)
+{
+	clearSuperfluousList();
+	restoreJournaledTraces();
+	FpUnrolling unrolling(circuit_, environment_model_, symb_location, free_inputs);
 
-			// set input values according to TestCase to TRUE or FALSE:
-			sim_symb.setInputValues(testcase[timestep]);
+	vector<unsigned> l_list = getLatchesToCheck();
+	Utils::genLit2IndexMap(l_list, circuit_, unrolling.literal_to_idx_);
 
-			//--------------------------------------------------------------------------------------
-			// cj is a variable that indicatest whether the corresponding latch is flipped
-			// fi is a variable that indicates whether the component is flipped in step i or not
-			// there can only be a flip at timestep i if both cj and fi are true.
-			int fi = next_free_cnf_var++;
-			solver_->addVarToKeep(fi);
+	if (!symb_location)
+	{
+		scheduleLatches(l_list); // after genLit2IndexMap, which needs the original order
 
-			set<int>::iterator it;
-			for (it = latches_to_check.begin(); it != latches_to_check.end(); ++it)
+		// ---------------- BEGIN 'for each latch' -------------------------
+		for (unsigned l_cnt = 0; l_cnt < l_list.size(); ++l_cnt)
+		{
+			unsigned component_aig = l_list[l_cnt];
+			if (only_one_trace_per_latch_ && detected_latches_.find(component_aig) != detected_latches_.end())
+				continue; // found in a resumed run
+			if (isGlobalBudgetExceeded())
 			{
-				int latch_output = *it >> 1;
-				int old_value = sim_symb.getResultValue(latch_output);
-				int new_value = next_free_cnf_var++;
-				int ci_lit = latch_to_cj[latch_output];
-
-				//solver_->addVarToKeep(new_value);
-
-				solver_->incAdd3LitClause(old_value, ci_lit, -new_value);
-				solver_->incAdd3LitClause(old_value, fi, -new_value);
-				solver_->incAdd4LitClause(-old_value, -ci_lit, -fi, -new_value);
-				solver_->incAdd3LitClause(-old_value, ci_lit, new_value);
-				solver_->incAdd3LitClause(-old_value, fi, new_value);
-				solver_->incAdd4LitClause(old_value, -ci_lit, -fi, new_value);
-
-				sim_symb.setResultValue(latch_output, new_value);
+				markLatchUnknown(component_aig);
+				continue;
 			}
+			startLatchBudget(unrolling.solver_);
+			unrolling.latches_to_check_.clear();
+			unrolling.latches_to_check_.insert(component_aig);
 
-			// there might be at most one flip in one time-step
-			// if fi is true, all other f must be false (fi -> -f1, fi -> -f2, ...)
-			for (unsigned cnt = 0; cnt < f.size(); cnt++)
-				solver_->incAdd2LitClause(-fi, -f[cnt]);
-
-			f.push_back(fi);
-			fi_to_timestep[fi] = timestep;
-
-
-			sim_symb.simulateOneTimeStep();
-			alarm_literals.push_back(sim_symb.getAlarmValue());
-			alarmlit_to_timestep[sim_symb.getAlarmValue()] = timestep;
-
-
-			vector<int> output_is_relevant;
-			if (environment_model_)
+			for (unsigned tci = 0; tci < testcases.size(); tci++)
 			{
-				vector<int> env_input;
-				const vector<int>& input_values = testcase[timestep];
-
-				env_input.reserve(input_values.size() + outputs_ok.size());
-				env_input.insert(env_input.end(), input_values.begin(),
-						input_values.end());
-				env_input.insert(env_input.end(), outputs_ok.begin(), outputs_ok.end());
-
-				sim_env->simulateOneTimeStep(env_input);
-				output_is_relevant = sim_env->getOutputs();
-				sim_env->switchToNextState();
-			}
-
-			//------------------------------------------------------------------------------------
-			// unit clauses saying that the current (relevant) outputs are equal
-			const vector<int> &out_cnf_values = sim_symb.getOutputValues();
-			for (unsigned output_idx = 0;
-					output_idx < outputs_ok.size() - 1;	++output_idx) {
-
-				// skip if output is not relevant
-				if (environment_model_ && output_is_relevant[output_idx] == AIG_FALSE)
+				if (isJournaledDone(component_aig, tci))
 					continue;
-
-				if (outputs_ok[output_idx] == AIG_FALSE)
-					solver_->incAddUnitClause(-out_cnf_values[output_idx]);
-				else
-					solver_->incAddUnitClause(out_cnf_values[output_idx]);
-
-			}
-			//--------------------------------------------------------------------------------------
-
-			// get Outputs and next state values, switch to next state
-			sim_symb.switchToNextState();
-			const vector<int> &next_cnf_values = sim_symb.getLatchValues();
-
-
-			int curr_enable_literal = next_free_cnf_var++;
-			solver_->addVarToKeep(curr_enable_literal);
-			enable_literals.push_back(curr_enable_literal);
-
-			vector<int> current_alarm_clause = alarm_literals;
-			current_alarm_clause.push_back(curr_enable_literal);
-			solver_->incAddClause(current_alarm_clause);
-
-			// assumptions saying that the states are equal
-			vector<int> assumptions;
-			assumptions.reserve(next_cnf_values.size() - num_err_latches_ + enable_literals.size());
-			assumptions = enable_literals;
-			assumptions.back() = -assumptions.back();
-
-			for (unsigned state_idx = 0;
-					state_idx < next_cnf_values.size() - num_err_latches_;
-					++state_idx) {
-				if (next_state_ok[state_idx] == AIG_FALSE)
-					assumptions.push_back(-next_cnf_values[state_idx]);
-				else
-					assumptions.push_back(next_cnf_values[state_idx]);
-
-			}
-
-			// switch concrete simulation to next state
-			concrete_state_ok = next_state_ok;
-
-			//--------------------------------------------------------------------------------------
-			// call SAT-solver
-
-			vector<int> vars_of_interest = f;
-			vars_of_interest.insert(vars_of_interest.end(), alarm_literals.begin(), alarm_literals.end());
-			vars_of_interest.insert(vars_of_interest.end(), cj_literals.begin(), cj_literals.end());
-
-
-			vector<int> model;
-			while (solver_->incIsSatModelOrCore(assumptions, vars_of_interest, model))
-			{
-				Utils::debugPrint(model, "model");
-
-				unsigned earliest_alarm_timestep = timestep + 1;
-				int fi = CNF_TRUE;
-				int cj = CNF_TRUE;
-
-				for (unsigned model_count = 0; model_count < model.size(); model_count++)
-				{
-					int lit = model[model_count];
-
-
-					if (lit > 0 && lit < next_cnf_var_after_ci_vars) // we have found the one and only active cj signal
-					{
-						cj = lit;
-						continue;
-					}
-
-					// parse f time step
-					map<int, unsigned>::iterator it = fi_to_timestep.find(lit);
-					if (lit > 0 && it != fi_to_timestep.end()) // we have found the fi variable which was set to TRUE
-					{
-						fi = lit;
-						continue;
-					}
-
-					// parse earliest alarm time step
-					it = alarmlit_to_timestep.find(lit);
-					if(it != alarmlit_to_timestep.end() && it->second < earliest_alarm_timestep)
-					{
-						earliest_alarm_timestep = it->second;
-					}
-				}
-
-
-				if (only_one_trace_per_latch_)
-				{
-					solver_->incAddUnitClause(-cj);
-					latches_to_check.erase(cj_to_latch[cj]);
-				}
-				else
-				{
-					// blocking clause: ignore flips at this particular time step for this particular latch in the future
-					solver_->incAdd2LitClause(-fi, -cj);
-				}
-
-				SuperfluousTrace* sf = new SuperfluousTrace(testcase);
-				sf->error_gone_timestep_ = timestep +1;
-				sf->component_ = cj_to_latch[cj];
-				detected_latches_.insert(sf->component_);
-				sf->flip_timestep_ = fi_to_timestep[fi];
-				if(earliest_alarm_timestep != timestep + 1)
-					sf->alarm_timestep_ = earliest_alarm_timestep;
-				else
-					sf->alarm_timestep_ = alarmlit_to_timestep[fi];
-				superfluous.push_back(sf);
-				L_DBG(sf->toString())
-			}
-
-
-
-		} // -- END "for each timestep in testcase" --
-
-
-//		if (environment_model_)
-//			delete environment_sim;
-	} // ------ END 'for each testcase' ---------------
-
-	if(sim_env)
-		delete sim_env;
-	delete sim_concrete;
-	delete solver_;
-
-	return superfluous.size() != 0;
-}
-
-bool FalsePositives::findFalsePositives_1b_free_inputs(vector<TestCase>& testcases)
-{
-	clearSuperfluousList();
-	int next_free_cnf_var = 2;
-
-	SatSolver* solver_ = Options::instance().getSATSolver();
-	SymbolicSimulator sim_ok(circuit_,solver_, next_free_cnf_var);
-	SymbolicSimulator sim_symb(circuit_, solver_, next_free_cnf_var);
-	SymbolicSimulator* sim_env = 0;
-	if (environment_model_)
-		sim_env = new SymbolicSimulator(environment_model_, solver_, next_free_cnf_var);
-
-	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
-	map<unsigned, unsigned> literal_to_idx;
-	Utils::genLit2IndexMap(latches_to_check, circuit_, literal_to_idx);
-
-	// ---------------- BEGIN 'for each latch' -------------------------
-	bool continue_with_next_latch;
-	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
-	{
-		continue_with_next_latch = false;
-		next_free_cnf_var = 2;
-
-		unsigned component_aig = latches_to_check[l_cnt];
-		int component_cnf = component_aig >> 1;
-
-		for (unsigned tci = 0; tci < testcases.size(); tci++)
-		{
-			TestCase& testcase = testcases[tci];
-			TestCase testcase_with_cnf_literals;
-
-			sim_symb.initLatches(); // initialize latches to false
-			sim_ok.initLatches();
-			if (environment_model_)
-				sim_env->initLatches();
-
-			AndCacheMap cache(solver_);
-			sim_ok.setCache(&cache);
-			sim_symb.setCache(&cache);
-
-			// start new incremental SAT-solving session
-			vector<int> vars_to_keep;
-			vars_to_keep.push_back(CNF_FALSE);
-			solver_->startIncrementalSession(vars_to_keep, 0);
-			solver_->incAddUnitClause(CNF_TRUE);
-			// set of literals to enable or disable the represented clauses, used for incremental solving.
-			vector<int> enable_literals;
-
-			// f = a set of variables fi indicating whether the latch is flipped in step i or not
-			vector<int> f;
-			map<int, unsigned> fi_to_timestep;
-
-			// set of literals representing the alarm output for each timestep
-			vector<int> alarm_literals;
-			map<int, unsigned> alarmlit_to_timestep;
-
-			for (unsigned timestep = 0; timestep < testcase.size(); timestep++)
-			{
-//				Utils::debugPrint(testcase[timestep], "Test inputs");
-				//------------------------------------------------------------------------------------
-				// Concrete simulations:
-				// correct simulation
-				sim_ok.simulateOneTimeStep(testcase[timestep]);
-				vector<int> outputs_ok = sim_ok.getOutputValues();
-				bool alarm_ok = outputs_ok.back() == CNF_TRUE;
-				//Utils::debugPrint(outputs_ok,"outputs_ok");
-				if (alarm_ok)
-				{
-					cout << "Alarm raised without Error!" << endl;
+				unsigned first = superfluous.size();
+				TestcaseResult result = analyzeTestcase(unrolling, testcases[tci], tci);
+				if (result == TC_ALARM_WITHOUT_ERROR)
 					return true;
-				}
-				vector<int> next_state_ok = sim_ok.getNextLatchValues();
-
-				// f variables:
-				int fi = next_free_cnf_var++;
-				solver_->addVarToKeep(fi);
-
-				int old_value = sim_symb.getResultValue(component_cnf);
-				if (old_value == CNF_TRUE) // old value is true
-					sim_symb.setResultValue(component_cnf, -fi);
-				else if (old_value == CNF_FALSE) // old value is false
-					sim_symb.setResultValue(component_cnf, fi);
-				else
+				sortTestcaseTraces(first);
+				if (result == TC_GAVE_UP)
 				{
-					int new_value = next_free_cnf_var++;
-					solver_->addVarToKeep(new_value);
-					// new_value = fi ? -old_value : old_value
-					solver_->incAdd3LitClause(fi, old_value, -new_value);
-					solver_->incAdd3LitClause(fi, -old_value, new_value);
-					solver_->incAdd3LitClause(-fi, old_value, new_value);
-					solver_->incAdd3LitClause(-fi, -old_value, -new_value);
-					sim_symb.setResultValue(component_cnf, new_value);
-				}
-
-				// there might be at most one flip in one time-step:
-				// if fi is true, all oter f must be false (fi -> -f1, fi -> -f2, ...)
-				for (unsigned cnt = 0; cnt < f.size(); cnt++)
-					solver_->incAdd2LitClause(-fi, -f[cnt]);
-
-				f.push_back(fi);
-				fi_to_timestep[fi] = timestep;
-
-
-				testcase_with_cnf_literals.push_back(sim_ok.getInputValues());
-				sim_symb.setCnfInputValues(sim_ok.getInputValues());
-				sim_symb.simulateOneTimeStep();
-				alarm_literals.push_back(sim_symb.getAlarmValue());
-				alarmlit_to_timestep[sim_symb.getAlarmValue()] = timestep;
-
-				//------------------------------------------------------------------------------------
-				vector<int> env_outputs;
-				if (environment_model_)
-				{
-					vector<int> env_input;
-					const vector<int>& input_values = sim_ok.getInputValues();
-
-					env_input.reserve(input_values.size() + outputs_ok.size());
-					env_input.insert(env_input.end(), input_values.begin(),
-							input_values.end());
-					env_input.insert(env_input.end(), outputs_ok.begin(), outputs_ok.end());
-
-					sim_env->setCnfInputValues(env_input);
-					sim_env->simulateOneTimeStep();
-					env_outputs = sim_env->getOutputValues();
-					sim_env->switchToNextState();
-
-					// last output of environment model defines valid input values
-					// must be true
-					if(env_outputs.size() == outputs_ok.size())
-						solver_->incAddUnitClause(env_outputs.back());
-				}
-
-				//------------------------------------------------------------------------------------
-				// unit clauses saying that the current (relevant) outputs are equal
-				const vector<int> &out_cnf_values = sim_symb.getOutputValues();
-				for (unsigned output_idx = 0;
-						output_idx < outputs_ok.size() - 1;	++output_idx) {
-					if (!environment_model_ &&outputs_ok[output_idx] == CNF_FALSE)
-						solver_->incAddUnitClause(-out_cnf_values[output_idx]);
-					else if (!environment_model_ && outputs_ok[output_idx] == CNF_TRUE)
-						solver_->incAddUnitClause(out_cnf_values[output_idx]);
-					else if (!environment_model_){
-						solver_->incAdd2LitClause(-outputs_ok[output_idx], out_cnf_values[output_idx]);
-						solver_->incAdd2LitClause(outputs_ok[output_idx], -out_cnf_values[output_idx]);
-					}
-					else { // if environment-model
-						solver_->incAdd3LitClause(-env_outputs[output_idx], -outputs_ok[output_idx], out_cnf_values[output_idx]);
-						solver_->incAdd3LitClause(-env_outputs[output_idx], outputs_ok[output_idx], -out_cnf_values[output_idx]);
-					}
-
-				}
-				//--------------------------------------------------------------------------------------
-
-                sim_symb.switchToNextState();
-				const vector<int> &next_cnf_values = sim_symb.getLatchValues();
-
-
-				//------------------------------------------------------------------------------------
-				int curr_enable_literal = next_free_cnf_var++;
-				solver_->addVarToKeep(curr_enable_literal);
-				enable_literals.push_back(curr_enable_literal);
-
-				vector<int> current_alarm_clause = alarm_literals;
-				current_alarm_clause.push_back(curr_enable_literal);
-				solver_->incAddClause(current_alarm_clause);
-				//---------------------------------------------timeste---------------------------------------
-				// assumptions saying that the states are equal
-				vector<int> assumptions;
-				assumptions.reserve(next_cnf_values.size() - num_err_latches_ + enable_literals.size());
-				assumptions = enable_literals;
-				assumptions.back() = -assumptions.back();
-
-				for (unsigned state_idx = 0;
-						state_idx < next_cnf_values.size() - num_err_latches_;
-						++state_idx) {
-					int ok_lit = next_state_ok[state_idx];
-					int symb_lit = next_cnf_values[state_idx];
-
-					if (ok_lit == CNF_FALSE)
-						assumptions.push_back(-symb_lit);
-					else if (ok_lit == CNF_TRUE)
-						assumptions.push_back(symb_lit);
-					else
-					{
-						// TODO check
-						solver_->incAdd3LitClause(curr_enable_literal, -ok_lit, symb_lit);
-						solver_->incAdd3LitClause(curr_enable_literal, ok_lit, -symb_lit);
-					}
-
-				}
-//				Utils::debugPrint(assumptions, "Assumptions: ");
-
-				//------------------------------------------------------------------------------------
-
-				// switch concrete simulation to next state
-				sim_ok.switchToNextState();
-				//------------------------------------------------------------------------------------
-				// call SAT-solver
-				vector<int> vars_of_interest = f;
-				vars_of_interest.insert(vars_of_interest.end(), alarm_literals.begin(), alarm_literals.end());
-				const vector<int> &open_in = sim_ok.getOpenInputVars();
-				vars_of_interest.insert(vars_of_interest.end(), open_in.begin(), open_in.end());
-
-				vector<int> model;
-				while (solver_->incIsSatModelOrCore(assumptions, vars_of_interest, model))
-				{
-
-					map<int, unsigned> cnf_input_var_to_aig_truth_lit;
-					cnf_input_var_to_aig_truth_lit[CNF_TRUE] = AIG_TRUE;
-					cnf_input_var_to_aig_truth_lit[CNF_FALSE] = AIG_FALSE;
-
-					Utils::debugPrint(model,"model");
-
-					SuperfluousTrace* sf = new SuperfluousTrace();
-					sf->testcase_.reserve(testcase_with_cnf_literals.size());
-
-					sf->component_ = component_aig;
-					detected_latches_.insert(component_aig);
-					sf->component_index_ = literal_to_idx[component_aig];
-					sf->error_gone_timestep_ = timestep + 1;
-					unsigned earliest_alarm_timestep = timestep + 1;
-					//parse:
-					int fj = 0;
-					for (unsigned model_count = 0; model_count < model.size(); model_count++)
-					{
-						int lit = model[model_count];
-						if (abs(lit) != 1)
-							cnf_input_var_to_aig_truth_lit[lit] = (lit > 0) ? AIG_TRUE : AIG_FALSE;
-
-						if (lit < 0)
-							continue;
-
-						// parse f time step
-						map<int, unsigned>::iterator it = fi_to_timestep.find(lit);
-						if (lit > 0 && it != fi_to_timestep.end()) // we have found the fi variable which was set to TRUE
-						{
-							fj = lit;
-							solver_->incAddUnitClause(-fj);
-
-							sf->flip_timestep_ = it->second;
-							continue;
-						}
-
-						// parse earliest alarm time step
-						it = alarmlit_to_timestep.find(lit);
-						if(it != alarmlit_to_timestep.end() && it->second < earliest_alarm_timestep)
-						{
-							earliest_alarm_timestep = it->second;
-						}
-
-					}
-
-					if(earliest_alarm_timestep != timestep + 1)
-						sf->alarm_timestep_ = earliest_alarm_timestep;
-					else
-					{
-						//L_DBG("same literal for f and alarm..")
-						sf->alarm_timestep_ = alarmlit_to_timestep[fj];
-					}
-					L_DBG("[sat]  flip_timestep=" << sf->flip_timestep_ << ", alarm_timestep=" << sf->alarm_timestep_ << ",error_gone_ts=" << timestep+1)
-
-
-					for (TestCase::const_iterator in = testcase_with_cnf_literals.begin();
-							in != testcase_with_cnf_literals.end(); ++in)
-					{
-						vector<int> concrete_input_vector;
-						concrete_input_vector.reserve(in->size());
-						for (vector<int>::const_iterator iv = in->begin(); iv != in->end();
-								++iv)
-						{
-							concrete_input_vector.push_back(cnf_input_var_to_aig_truth_lit[*iv]);
-						}
-						sf->testcase_.push_back(concrete_input_vector);
-					}
-
-					superfluous.push_back(sf);
-
-					if (only_one_trace_per_latch_)
-					{
-						continue_with_next_latch = true;
-						break;
-					}
+					markLatchUnknown(component_aig);
+					num_journaled_traces_ = superfluous.size(); // a resumed run repeats this test-case
+					break;
 				}
-
-				if (continue_with_next_latch)
+				journalTestcaseDone(component_aig, tci);
+				if (result == TC_LATCH_DONE)
 					break;
+			} // end "for each testcase"
+		} // ------ END 'for each latch' ---------------
 
-			} // -- END "for each timestep in testcase" --
-
-			if (continue_with_next_latch)
-				break;
-		} // end "for each testcase"
-	} // ------ END 'for each latch' ---------------
-
-
-	delete solver_;
-	if(sim_env)
-		delete sim_env;
-
-	return superfluous.size() != 0;
-}
+		return superfluous.size() != 0;
+	}
 
-bool FalsePositives::findFalsePositives_2b_free_inputs(vector<TestCase>& testcases)
-{
-	clearSuperfluousList();
-	int next_free_cnf_var = 2;
-
-	SatSolver* solver_ = Options::instance().getSATSolver();
-	SymbolicSimulator sim_ok(circuit_,solver_, next_free_cnf_var);
-	SymbolicSimulator sim_symb(circuit_, solver_, next_free_cnf_var);
-	SymbolicSimulator* sim_env = 0;
-	if (environment_model_)
-		sim_env = new SymbolicSimulator(environment_model_, solver_, next_free_cnf_var);
-
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
-	set<int> latches_to_check;
-	map<unsigned, unsigned> literal_to_idx;
-	Utils::genLit2IndexMap(l_list, circuit_, literal_to_idx);
 	//------------------------------------------------------------------------------------------
-	// set up ci signals
-	// maps for latch-literals <=> cj-literals: each latch has a corresponding cj literal,
-	// which indicates whether the latch is flipped or not.
-	map<int, int> latch_to_cj; // maps latch-literals(cnf) to corresponding cj-literals(cnf)
-	map<int, int> cj_to_latch; // maps cj-literals(cnf) to corresponding latch-literals(aig)
-
+	// set up ci signals: each latch has a corresponding cj literal, which indicates whether the
+	// latch is flipped or not.
 	for (unsigned c_cnt = 0; c_cnt < l_list.size(); ++c_cnt)
 	{
-		latches_to_check.insert(l_list[c_cnt]);
-		int cj = next_free_cnf_var++;
-		latch_to_cj[l_list[c_cnt] >> 1] = cj;
-		cj_to_latch[cj] = l_list[c_cnt];
+		unrolling.latches_to_check_.insert(l_list[c_cnt]);
+		int cj = unrolling.next_free_cnf_var_++;
+		unrolling.latch_to_cj_[l_list[c_cnt] >> 1] = cj;
+		unrolling.cj_to_latch_[cj] = l_list[c_cnt];
 	}
-	int next_cnf_var_after_ci_vars = next_free_cnf_var;
+	// latches detected in a resumed run need not be flipped again (if one trace is enough)
+	for (set<unsigned>::iterator it = detected_latches_.begin();
+			only_one_trace_per_latch_ && it != detected_latches_.end(); ++it)
+		unrolling.latches_to_check_.erase(*it);
+	unrolling.first_free_cnf_var_ = unrolling.next_free_cnf_var_;
 	//------------------------------------------------------------------------------------------
 
+	// all latches are flipped at once, so --latch_timeout does not apply. If --timeout or the
+	// conflict limit stop a test-case early, all undetected latches are reported as unknown.
+	startLatchBudget(unrolling.solver_);
+	bool incomplete = false;
+	testcase_begins_.clear();
 
 	// for each testcase
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
-		TestCase& testcase = testcases[tc_number];
-		TestCase testcase_with_cnf_literals;
-
-		sim_ok.initLatches();
-		sim_symb.initLatches();
-		if (environment_model_)
-			sim_env->initLatches();
-
-		AndCacheMap cache(solver_);
-		sim_ok.setCache(&cache);
-		sim_symb.setCache(&cache);
-
-		// f = a set of variables fi indicating whether the latch is *flipped in _step_ i* or not
-		vector<int> f;
-		map<int, unsigned> fi_to_timestep;
-
-		// set of literals representing the alarm output for each timestep
-		vector<int> alarm_literals;
-		map<int, unsigned> alarmlit_to_timestep;
-
-		// a set of cj-literals indicating whether *the _latch_ C_j is flipped* or not
-		vector<int> cj_literals;
-		map<int, int>::iterator map_iter;
-		for (map_iter = latch_to_cj.begin(); map_iter != latch_to_cj.end(); map_iter++)
+		testcase_begins_.push_back(superfluous.size());
+		if (isJournaledDone(l_list, tc_number))
+			continue;
+		if (isGlobalBudgetExceeded())
 		{
-			cj_literals.push_back(map_iter->second);
+			incomplete = true;
+			break;
 		}
+		TestcaseResult result = analyzeTestcase(unrolling, testcases[tc_number], tc_number);
+		if (result == TC_ALARM_WITHOUT_ERROR)
+			return true;
+		sortTestcaseTraces(testcase_begins_.back());
+		if (result == TC_GAVE_UP)
+		{
+			incomplete = true;
+			num_journaled_traces_ = superfluous.size(); // a resumed run repeats this test-case
+			continue;
+		}
+		journalTestcaseDone(l_list, tc_number);
+	} // ------ END 'for each testcase' ---------------
+	if (incomplete)
+		markUndetectedLatchesUnknown(l_list);
 
-		// start new incremental SAT-solving session
-		solver_->startIncrementalSession(cj_literals, 0);
-		solver_->addVarToKeep(abs(CNF_TRUE));
-		solver_->incAddUnitClause(CNF_TRUE); // CNF_TRUE= unit-clause representing TRUE constant
-
-		// set of literals to enable or disable the represented clauses, used for incremental solving.
-		vector<int> enable_literals;
+	return superfluous.size() != 0;
+}
 
-		//----------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------------
+FalsePositives::TestcaseResult FalsePositives::analyzeTestcase(FpUnrolling& unrolling,
+		TestCase& testcase, unsigned tc_number)
+{
+	SatSolver* solver = unrolling.solver_;
+	SymbolicSimulator* sim_symb = unrolling.sim_symb_;
+	bool concrete_single_latch = !unrolling.free_inputs_ && !unrolling.symb_location_;
+
+	// the flipped latch of modes 0 and 2
+	unsigned component_aig = unrolling.symb_location_ ? 0 : *unrolling.latches_to_check_.begin();
+	unsigned component_index = unrolling.literal_to_idx_[component_aig];
+
+	// start new incremental SAT-solving session
+	unrolling.next_free_cnf_var_ = unrolling.first_free_cnf_var_;
+	vector<int> cj_literals;
+	map<int, int>::iterator map_iter;
+	for (map_iter = unrolling.latch_to_cj_.begin(); map_iter != unrolling.latch_to_cj_.end(); map_iter++)
+		cj_literals.push_back(map_iter->second);
+	vector<int> vars_to_keep = cj_literals;
+	vars_to_keep.push_back(CNF_FALSE);
+	solver->startIncrementalSession(vars_to_keep, 0);
+	solver->incAddUnitClause(CNF_TRUE); // CNF_TRUE= unit-clause representing TRUE constant
+
+	if (unrolling.symb_location_)
+	{
 		// single fault assumption: there might be at most one flipped component
 		map<int, int>::iterator map_iter2;
-		for (map_iter = latch_to_cj.begin(); map_iter != latch_to_cj.end(); map_iter++)
+		for (map_iter = unrolling.latch_to_cj_.begin(); map_iter != unrolling.latch_to_cj_.end(); map_iter++)
 		{
 			map_iter2 = map_iter;
 			map_iter2++;
-			for (; map_iter2 != latch_to_cj.end(); map_iter2++)
-				solver_->incAdd2LitClause(-map_iter->second, -map_iter2->second);
+			for (; map_iter2 != unrolling.latch_to_cj_.end(); map_iter2++)
+				solver->incAdd2LitClause(-map_iter->second, -map_iter2->second);
 		}
+		// the traces of latches completed for this test-case by another shard (see --resume)
+		// are already restored, so these latches are not flipped again
+		for (map_iter = unrolling.cj_to_latch_.begin(); map_iter != unrolling.cj_to_latch_.end(); map_iter++)
+		{
+			if (isJournaledDone(map_iter->second, tc_number))
+				solver->incAddUnitClause(-map_iter->first);
+		}
+	}
 
+	// initial state = (0 0 0 0 0 0 0)
+	vector<int> concrete_state_ok; // (AIG literals)
+	if (unrolling.free_inputs_)
+		unrolling.sim_ok_->initLatches();
+	else
+		concrete_state_ok.resize(circuit_->num_latches);
+	sim_symb->initLatches();
+	if (unrolling.env_symb_)
+		unrolling.env_symb_->initLatches();
+	if (unrolling.env_concrete_)
+		unrolling.env_concrete_->initLatches();
+
+	AndCacheMap cache(solver);
+	if (unrolling.free_inputs_)
+	{
+		unrolling.sim_ok_->setCache(&cache);
+		sim_symb->setCache(&cache);
+	}
 
-		// if environment-model: define which output is relevant at which point in time:
-//		AigSimulator* environment_sim = 0;
-//		if (environment_model_)
-//			environment_sim = new AigSimulator(environment_model_);
-
-		for (unsigned timestep = 0; timestep < testcase.size(); timestep++)
-		{ // -------- BEGIN "for each timestep in testcase" --------------------------------------
+	// f = a set of variables fi indicating whether the latch is flipped in step i or not
+	vector<int> f;
+	map<int, unsigned> fi_to_timestep;
+
+	// set of literals representing the alarm output for each timestep
+	vector<int> alarm_literals;
+	map<int, unsigned> alarmlit_to_timestep;
+
+	// the inputs of the fault-free run, open ones as CNF variables (modes 2 and 3)
+	TestCase testcase_with_cnf_literals;
+	vector<int> open_inputs;
+
+	// the fault-free trace, to test other flip time steps concretely (see simulateFlips())
+	vector<vector<int> > ok_states;
+	vector<vector<int> > ok_outputs;
+	vector<vector<int> > relevant_outputs(testcase.size());
+	set<int> blocked_f;
+
+	for (unsigned timestep = 0; timestep < testcase.size(); timestep++)
+	{ // -------- BEGIN "for each timestep in testcase" --------------------------------------
+
+		//--------------------------------------------------------------------------------------
+		// fault-free simulation (CNF literals or constants)
+		vector<int> outputs_ok;
+		vector<int> next_state_ok;
+		vector<int> aig_outputs_ok;
+		vector<int> aig_next_state_ok;
+		if (unrolling.free_inputs_)
+		{
+			unrolling.sim_ok_->simulateOneTimeStep(testcase[timestep]);
+			outputs_ok = unrolling.sim_ok_->getOutputValues();
+			next_state_ok = unrolling.sim_ok_->getNextLatchValues();
+		}
+		else
+		{
+			unrolling.sim_concrete_->simulateOneTimeStep(testcase[timestep], concrete_state_ok);
+			aig_outputs_ok = unrolling.sim_concrete_->getOutputs();
+			aig_next_state_ok = unrolling.sim_concrete_->getNextLatchValues();
+			outputs_ok = toCnfConstants(aig_outputs_ok);
+			next_state_ok = toCnfConstants(aig_next_state_ok);
+		}
+		if (outputs_ok.back() == CNF_TRUE)
+		{
+			cout << "Alarm raised without Error!" << endl;
+			return TC_ALARM_WITHOUT_ERROR;
+		}
 
-			//--------------------------------------------------------------------------------------
-			// Concrete simulations:
-			sim_ok.simulateOneTimeStep(testcase[timestep]);
-			vector<int> outputs_ok = sim_ok.getOutputValues();
-			vector<int> next_state_ok = sim_ok.getNextLatchValues();
-			bool alarm_ok = outputs_ok.back() == CNF_TRUE;
-			if (alarm_ok)
+		//--------------------------------------------------------------------------------------
+		// a single latch with concrete inputs: simulate the flip in this time step concretely
+		bool flip_possible = true;
+		if (concrete_single_latch)
+		{
+			ok_states.push_back(concrete_state_ok);
+			ok_outputs.push_back(aig_outputs_ok);
+
+			vector<int> faulty_state = concrete_state_ok;
+			faulty_state[component_index] =
+					(faulty_state[component_index] == AIG_TRUE) ? AIG_FALSE : AIG_TRUE;
+			unrolling.sim_concrete_->simulateOneTimeStep(testcase[timestep], faulty_state);
+			vector<int> outputs_faulty = unrolling.sim_concrete_->getOutputs();
+			bool alarm_faulty = outputs_faulty.back() == AIG_TRUE;
+			bool equal_concrete_outputs = isEqualN(aig_outputs_ok, outputs_faulty, 1);
+			bool equal_concrete_states = (aig_next_state_ok == unrolling.sim_concrete_->getNextLatchValues());
+
+			if (equal_concrete_outputs && equal_concrete_states && alarm_faulty)
 			{
-				cout << "Alarm raised without Error!" << endl;
-				return true;
+				// the alarm is raised and the error is gone at once, no need for the solver
+				addSuperfluousTrace(component_aig, component_index, testcase, timestep, timestep, timestep + 1);
+				sim_symb->setInputValues(testcase[timestep]);
+				sim_symb->simulateOneTimeStep();
+				alarm_literals.push_back(sim_symb->getAlarmValue());
+				alarmlit_to_timestep[sim_symb->getAlarmValue()] = timestep;
+				sim_symb->switchToNextState();
+				concrete_state_ok = aig_next_state_ok;
+				if (only_one_trace_per_latch_)
+					return TC_LATCH_DONE;
+				continue;
 			}
+			// a flip which changes an output in this time step can not be a false positive
+			flip_possible = equal_concrete_outputs;
+		}
 
-			//--------------------------------------------------------------------------------------
-
-			// set input values according to TestCase to TRUE or FALSE:
-			sim_symb.setInputValues(testcase[timestep]);
-
-			//--------------------------------------------------------------------------------------
-			// cj is a variable that indicatest whether the corresponding latch is flipped
-			// fi is a variable that indicates whether the component is flipped in step i or not
-			// there can only be a flip at timestep i if both cj and fi are true.
-			int fi = next_free_cnf_var++;
-			solver_->addVarToKeep(fi);
+		//--------------------------------------------------------------------------------------
+		// fi is a variable that indicates whether the component is flipped in step i or not.
+		// With several latches, cj indicates whether the corresponding latch is flipped, and
+		// there can only be a flip at timestep i if both cj and fi are true.
+		if (flip_possible)
+		{
+			int fi = unrolling.next_free_cnf_var_++;
+			solver->addVarToKeep(fi);
 
-			set<int>::iterator it;
-			for (it = latches_to_check.begin(); it != latches_to_check.end(); ++it) // TODO: for ALL latches
+			for (set<unsigned>::iterator it = unrolling.latches_to_check_.begin();
+					it != unrolling.latches_to_check_.end(); ++it)
 			{
 				int latch_output = *it >> 1;
-				int old_value = sim_symb.getResultValue(latch_output);
-				int new_value = next_free_cnf_var++;
-				int ci_lit = latch_to_cj[latch_output];
-
-				//solver_->addVarToKeep(new_value);
-
-				solver_->incAdd3LitClause(old_value, ci_lit, -new_value);
-				solver_->incAdd3LitClause(old_value, fi, -new_value);
-				solver_->incAdd4LitClause(-old_value, -ci_lit, -fi, -new_value);
-				solver_->incAdd3LitClause(-old_value, ci_lit, new_value);
-				solver_->incAdd3LitClause(-old_value, fi, new_value);
-				solver_->incAdd4LitClause(old_value, -ci_lit, -fi, new_value);
-
-				sim_symb.setResultValue(latch_output, new_value);
+				if (unrolling.symb_location_)
+					sim_symb->flipLatchIf(latch_output, unrolling.latch_to_cj_[latch_output], fi);
+				else
+					sim_symb->flipLatchIf(latch_output, fi);
 			}
 
 			// there might be at most one flip in one time-step
 			// if fi is true, all other f must be false (fi -> -f1, fi -> -f2, ...)
 			for (unsigned cnt = 0; cnt < f.size(); cnt++)
-				solver_->incAdd2LitClause(-fi, -f[cnt]);
+				solver->incAdd2LitClause(-fi, -f[cnt]);
 
 			f.push_back(fi);
 			fi_to_timestep[fi] = timestep;
-			//--------------------------------------------------------------------------------------
-
-			testcase_with_cnf_literals.push_back(sim_ok.getInputValues());
-			sim_symb.setCnfInputValues(sim_ok.getInputValues());
-			sim_symb.simulateOneTimeStep();
-			alarm_literals.push_back(sim_symb.getAlarmValue());
-			alarmlit_to_timestep[sim_symb.getAlarmValue()] = timestep;
+		}
 
-			//------------------------------------------------------------------------------------
-			vector<int> env_outputs;
-			if (environment_model_)
+		//--------------------------------------------------------------------------------------
+		// faulty simulation with the same inputs
+		if (unrolling.free_inputs_)
+		{
+			const vector<int>& input_values = unrolling.sim_ok_->getInputValues();
+			testcase_with_cnf_literals.push_back(input_values);
+			for (unsigned cnt = 0; cnt < input_values.size(); ++cnt)
 			{
-				vector<int> env_input;
-				const vector<int>& input_values = sim_ok.getInputValues();
-
-				env_input.reserve(input_values.size() + outputs_ok.size());
-				env_input.insert(env_input.end(), input_values.begin(),
-						input_values.end());
-				env_input.insert(env_input.end(), outputs_ok.begin(), outputs_ok.end());
-
-				sim_env->setCnfInputValues(env_input);
-				sim_env->simulateOneTimeStep();
-				env_outputs = sim_env->getOutputValues();
-				sim_env->switchToNextState();
-
-				// last output of environment model defines valid input values
-				// must be true
-				if(env_outputs.size() == outputs_ok.size())
-					solver_->incAddUnitClause(env_outputs.back());
+				if (input_values[cnt] != CNF_TRUE && input_values[cnt] != CNF_FALSE)
+					open_inputs.push_back(input_values[cnt]);
 			}
-			//------------------------------------------------------------------------------------
-			// unit clauses saying that the current (relevant) outputs are equal
-			const vector<int> &out_cnf_values = sim_symb.getOutputValues();
-			for (unsigned output_idx = 0;
-					output_idx < outputs_ok.size() - 1;	++output_idx) {
-				if (!environment_model_ &&outputs_ok[output_idx] == CNF_FALSE)
-					solver_->incAddUnitClause(-out_cnf_values[output_idx]);
-				else if (!environment_model_ && outputs_ok[output_idx] == CNF_TRUE)
-					solver_->incAddUnitClause(out_cnf_values[output_idx]);
-				else if (!environment_model_){
-					solver_->incAdd2LitClause(-outputs_ok[output_idx], out_cnf_values[output_idx]);
-					solver_->incAdd2LitClause(outputs_ok[output_idx], -out_cnf_values[output_idx]);
-				}
-				else { // if environment-model
-					solver_->incAdd3LitClause(-env_outputs[output_idx], -outputs_ok[output_idx], out_cnf_values[output_idx]);
-					solver_->incAdd3LitClause(-env_outputs[output_idx], outputs_ok[output_idx], -out_cnf_values[output_idx]);
-				}
-
-			}
-			//--------------------------------------------------------------------------------------
-
-
-			sim_symb.switchToNextState();
-			const vector<int> &next_cnf_values = sim_symb.getLatchValues();
-
-
-			int curr_enable_literal = next_free_cnf_var++;
-			solver_->addVarToKeep(curr_enable_literal);
-			enable_literals.push_back(curr_enable_literal);
+			sim_symb->setCnfInputValues(input_values);
+		}
+		else
+			sim_symb->setInputValues(testcase[timestep]);
+		sim_symb->simulateOneTimeStep();
+		alarm_literals.push_back(sim_symb->getAlarmValue());
+		alarmlit_to_timestep[sim_symb->getAlarmValue()] = timestep;
+
+		//--------------------------------------------------------------------------------------
+		// if environment-model: define which output is relevant at which point in time
+		vector<int> output_is_relevant; // CNF literals or constants, empty = all relevant
+		if (unrolling.env_symb_)
+		{
+			const vector<int>& input_values = unrolling.sim_ok_->getInputValues();
+			vector<int> env_input;
+			env_input.reserve(input_values.size() + outputs_ok.size());
+			env_input.insert(env_input.end(), input_values.begin(), input_values.end());
+			env_input.insert(env_input.end(), outputs_ok.begin(), outputs_ok.end());
+
+			unrolling.env_symb_->setCnfInputValues(env_input);
+			unrolling.env_symb_->simulateOneTimeStep();
+			output_is_relevant = unrolling.env_symb_->getOutputValues();
+			unrolling.env_symb_->switchToNextState();
+
+			// last output of environment model defines valid input values
+			// must be true
+			if (output_is_relevant.size() == outputs_ok.size())
+				solver->incAddUnitClause(output_is_relevant.back());
+		}
+		else if (unrolling.env_concrete_)
+		{
+			const vector<int>& input_values = testcase[timestep];
+			vector<int> env_input;
+			env_input.reserve(input_values.size() + aig_outputs_ok.size());
+			env_input.insert(env_input.end(), input_values.begin(), input_values.end());
+			env_input.insert(env_input.end(), aig_outputs_ok.begin(), aig_outputs_ok.end());
+
+			unrolling.env_concrete_->simulateOneTimeStep(env_input);
+			relevant_outputs[timestep] = unrolling.env_concrete_->getOutputs();
+			output_is_relevant = toCnfConstants(relevant_outputs[timestep]);
+			unrolling.env_concrete_->switchToNextState();
+		}
 
-			vector<int> current_alarm_clause = alarm_literals;
-			current_alarm_clause.push_back(curr_enable_literal);
-			solver_->incAddClause(current_alarm_clause);
+		//--------------------------------------------------------------------------------------
+		// clauses saying that the current (relevant) outputs are equal
+		addEqualOutputsCondition(solver, outputs_ok, sim_symb->getOutputValues(), output_is_relevant);
 
-			// assumptions saying that the states are equal
-			vector<int> assumptions;
-			assumptions.reserve(next_cnf_values.size() - num_err_latches_ + enable_literals.size());
-			assumptions = enable_literals;
-			assumptions.back() = -assumptions.back();
+		// get next state values, switch to next state
+		sim_symb->switchToNextState();
 
-			for (unsigned state_idx = 0;
-					state_idx < next_cnf_values.size() - num_err_latches_;
-					++state_idx) {
-				int ok_lit = next_state_ok[state_idx];
-				int symb_lit = next_cnf_values[state_idx];
+		// the alarm was raised and the error is gone, if error_gone is assumed
+		int error_gone = addErrorGoneCondition(solver, alarm_literals, sim_symb->getLatchValues(),
+				next_state_ok, unrolling.next_free_cnf_var_);
+		vector<int> assumptions(1, error_gone);
 
-				if (ok_lit == CNF_FALSE)
-					assumptions.push_back(-symb_lit);
-				else if (ok_lit == CNF_TRUE)
-					assumptions.push_back(symb_lit);
-				else
-				{
-					// TODO check
-					solver_->incAdd3LitClause(curr_enable_literal, -ok_lit, symb_lit);
-					solver_->incAdd3LitClause(curr_enable_literal, ok_lit, -symb_lit);
-				}
+		// switch fault-free simulation to next state
+		if (unrolling.free_inputs_)
+			unrolling.sim_ok_->switchToNextState();
+		else
+			concrete_state_ok = aig_next_state_ok;
 
-			}
+		//--------------------------------------------------------------------------------------
+		// call SAT-solver
+		vector<int> vars_of_interest = f;
+		vars_of_interest.insert(vars_of_interest.end(), alarm_literals.begin(), alarm_literals.end());
+		vars_of_interest.insert(vars_of_interest.end(), cj_literals.begin(), cj_literals.end());
+		vars_of_interest.insert(vars_of_interest.end(), open_inputs.begin(), open_inputs.end());
 
-			// switch concrete simulation to next state
-			sim_ok.switchToNextState();
-
-//			vector<int> output_is_relevant;
-//			if(environment_model_)
-//			{
-//				vector<int> env_input;
-//				env_input.reserve(testcase[timestep].size() + outputs_ok.size());
-//				env_input.insert(env_input.end(),
-//						testcase[timestep].begin(), testcase[timestep].end());
-//				env_input.insert(env_input.end(), outputs_ok.begin(),
-//						outputs_ok.end());
-//				environment_sim->simulateOneTimeStep(env_input);
-//				output_is_relevant = environment_sim->getOutputs();
-//				environment_sim->switchToNextState();
-//			}
-
-			//--------------------------------------------------------------------------------------
-			// call SAT-solver
-
-			vector<int> vars_of_interest = f;
-			vars_of_interest.insert(vars_of_interest.end(), alarm_literals.begin(), alarm_literals.end());
-			vars_of_interest.insert(vars_of_interest.end(), cj_literals.begin(), cj_literals.end());
-			const vector<int> &open_in = sim_ok.getOpenInputVars();
-			vars_of_interest.insert(vars_of_interest.end(), open_in.begin(), open_in.end());
-
-			vector<int> model;
-			while (solver_->incIsSatModelOrCore(assumptions, vars_of_interest, model))
+		vector<int> model;
+		while (solver->incIsSatModelOrCore(assumptions, vars_of_interest, model))
+		{
+			Utils::debugPrint(model, "model");
+
+			int fi, cj;
+			TestCase concrete_testcase;
+			unsigned alarm_timestep = parseFlipModel(model, timestep, fi_to_timestep,
+					alarmlit_to_timestep, unrolling.symb_location_ ? unrolling.first_free_cnf_var_ : 0,
+					fi, cj, unrolling.free_inputs_ ? &testcase_with_cnf_literals : 0,
+					&concrete_testcase);
+
+			unsigned latch = unrolling.symb_location_ ? unrolling.cj_to_latch_[cj] : component_aig;
+			SuperfluousTrace* sf = new SuperfluousTrace(
+					unrolling.free_inputs_ ? concrete_testcase : testcase);
+			sf->component_ = latch;
+			sf->component_index_ = unrolling.literal_to_idx_[latch];
+			sf->flip_timestep_ = fi_to_timestep[fi];
+			sf->alarm_timestep_ = alarm_timestep;
+			sf->error_gone_timestep_ = timestep + 1;
+			detected_latches_.insert(latch);
+			superfluous.push_back(sf);
+			L_DBG("[sat]  " << sf->toString())
+
+			if (unrolling.symb_location_)
 			{
-				Utils::debugPrint(model, "model");
-
-				map<int, unsigned> cnf_input_var_to_aig_truth_lit;
-				cnf_input_var_to_aig_truth_lit[CNF_TRUE] = AIG_TRUE;
-				cnf_input_var_to_aig_truth_lit[CNF_FALSE] = AIG_FALSE;
-
-				unsigned earliest_alarm_timestep = timestep + 1;
-				int fi = CNF_TRUE;
-				int cj = CNF_TRUE;
-
-				for (unsigned model_count = 0; model_count < model.size(); model_count++)
-				{
-					int lit = model[model_count];
-					if (abs(lit) != 1)
-						cnf_input_var_to_aig_truth_lit[lit] = (lit > 0) ? AIG_TRUE : AIG_FALSE;
-
-					if (lit > 0 && lit < next_cnf_var_after_ci_vars) // we have found the one and only active cj signal
-					{
-						cj = lit;
-						continue;
-					}
-
-					// parse f time step
-					map<int, unsigned>::iterator it = fi_to_timestep.find(lit);
-					if (lit > 0 && it != fi_to_timestep.end()) // we have found the fi variable which was set to TRUE
-					{
-						fi = lit;
-						continue;
-					}
-
-					// parse earliest alarm time step
-					it = alarmlit_to_timestep.find(lit);
-					if(it != alarmlit_to_timestep.end() && it->second < earliest_alarm_timestep)
-					{
-						earliest_alarm_timestep = it->second;
-					}
-				}
-
 				if (only_one_trace_per_latch_)
 				{
-					solver_->incAddUnitClause(-cj);
-					latches_to_check.erase(cj_to_latch[cj]);
+					solver->incAddUnitClause(-cj);
+					unrolling.latches_to_check_.erase(latch);
 				}
 				else
 				{
 					// blocking clause: ignore flips at this particular time step for this particular latch in the future
-					solver_->incAdd2LitClause(-fi, -cj);
-				}
-
-				SuperfluousTrace* sf = new SuperfluousTrace();
-				sf->error_gone_timestep_ = timestep +1;
-				sf->component_ = cj_to_latch[cj];
-				detected_latches_.insert(sf->component_);
-				sf->component_index_ = literal_to_idx[sf->component_];
-				sf->flip_timestep_ = fi_to_timestep[fi];
-				if(earliest_alarm_timestep != timestep + 1)
-					sf->alarm_timestep_ = earliest_alarm_timestep;
-				else
-					sf->alarm_timestep_ = alarmlit_to_timestep[fi];
-
-				for (TestCase::const_iterator in = testcase_with_cnf_literals.begin();
-						in != testcase_with_cnf_literals.end(); ++in)
-				{
-					vector<int> concrete_input_vector;
-					concrete_input_vector.reserve(in->size());
-					for (vector<int>::const_iterator iv = in->begin(); iv != in->end();
-							++iv)
-					{
-						concrete_input_vector.push_back(cnf_input_var_to_aig_truth_lit[*iv]);
-					}
-					sf->testcase_.push_back(concrete_input_vector);
+					solver->incAdd2LitClause(-fi, -cj);
 				}
-				superfluous.push_back(sf);
-				L_DBG(sf->toString())
+				continue;
 			}
 
+			solver->incAddUnitClause(-fi);
+			blocked_f.insert(fi);
+			if (only_one_trace_per_latch_)
+				return TC_LATCH_DONE;
+			if (!concrete_single_latch)
+				continue;
+
+			// the inputs are concrete, so the model is a concrete trace: test all other
+			// flip time steps on it and block the hits before calling the solver again
+			vector<int> open_f;
+			vector<unsigned> flip_timesteps;
+			for (unsigned f_cnt = 0; f_cnt < f.size(); ++f_cnt)
+			{
+				if (blocked_f.find(f[f_cnt]) != blocked_f.end())
+					continue;
+				open_f.push_back(f[f_cnt]);
+				flip_timesteps.push_back(fi_to_timestep[f[f_cnt]]);
+			}
+			vector<bool> hits;
+			vector<unsigned> alarm_timesteps;
+			unsigned num_hits = simulateFlips(testcase, component_index, ok_states, ok_outputs,
+					relevant_outputs, aig_next_state_ok, timestep + 1, flip_timesteps, hits,
+					alarm_timesteps);
+			for (unsigned f_cnt = 0; f_cnt < open_f.size(); ++f_cnt)
+			{
+				if (!hits[f_cnt])
+					continue;
+				solver->incAddUnitClause(-open_f[f_cnt]);
+				blocked_f.insert(open_f[f_cnt]);
+				addSuperfluousTrace(component_aig, component_index, testcase, flip_timesteps[f_cnt],
+						alarm_timesteps[f_cnt], timestep + 1);
+			}
+			if (num_hits > 0)
+				L_DBG("[sim]  " << num_hits << " more flip time steps with error_gone_ts=" << timestep+1)
+		}
+		solver->incAddUnitClause(-error_gone); // retire the query of this time step
 
+		// modes 0 and 2 have a budget per latch, modes 1 and 3 only the global one
+		bool budget_exceeded = unrolling.symb_location_ ? isGlobalBudgetExceeded() : isBudgetExceeded();
+		if (solver->isLastResultUnknown() || budget_exceeded)
+			return TC_GAVE_UP; // the remaining time steps of this test-case are not analyzed
 
-		} // -- END "for each timestep in testcase" --
-
-
-//		if (environment_model_)
-//			delete environment_sim;
-	} // ------ END 'for each testcase' ---------------
-
-
-	delete solver_;
-	if(sim_env)
-		delete sim_env;
+	} // -- END "for each timestep in testcase" --
 
-	return superfluous.size() != 0;
+	return TC_COMPLETE;
 }
 
 void FalsePositives::printResults()
@@ -1408,6 +707,32 @@ void FalsePositives::printResults()
 
 }
 
+void FalsePositives::propagateCollapsedLatches()
+{
+	BackEnd::propagateCollapsedLatches();
+	FaultCollapsing* fault_collapsing = Options::instance().getFaultCollapsing();
+	if (fault_collapsing == 0)
+		return;
+
+	unsigned num_traces = superfluous.size(); // only the traces of the representatives
+	for (unsigned t_cnt = 0; t_cnt < num_traces; ++t_cnt)
+	{
+		const vector<unsigned>& members =
+				fault_collapsing->getClassMembers(superfluous[t_cnt]->component_);
+		if (members.empty())
+			continue;
+		map<unsigned, unsigned> literal_to_idx;
+		Utils::genLit2IndexMap(members, circuit_, literal_to_idx);
+		for (unsigned m_cnt = 0; m_cnt < members.size(); ++m_cnt)
+		{
+			SuperfluousTrace* sf = new SuperfluousTrace(*superfluous[t_cnt]);
+			sf->component_ = members[m_cnt];
+			sf->component_index_ = literal_to_idx[members[m_cnt]];
+			superfluous.push_back(sf);
+		}
+	}
+}
+
 bool FalsePositives::isEqualN(vector<int> a, vector<int> b, int elements_to_skip)
 {
 	unsigned length = a.size() - elements_to_skip;
@@ -1424,6 +749,376 @@ void FalsePositives::addSuperfluousTrace(int component, int component_index, Tes
 	superfluous.push_back(sf);
 }
 
+unsigned FalsePositives::simulateFlips(const TestCase& testcase, unsigned latch_index,
+		const vector<vector<int> >& ok_states, const vector<vector<int> >& ok_outputs,
+		const vector<vector<int> >& relevant_outputs, const vector<int>& next_state_ok,
+		unsigned error_gone_timestep, const vector<unsigned>& flip_timesteps,
+		vector<bool>& hits, vector<unsigned>& alarm_timesteps)
+{
+	hits.clear();
+	hits.resize(flip_timesteps.size(), false);
+	alarm_timesteps.clear();
+	alarm_timesteps.resize(flip_timesteps.size(), 0);
+	unsigned num_hits = 0;
+	unsigned alarm_lit = circuit_->outputs[circuit_->num_outputs - 1].lit;
+	unsigned latch_var = circuit_->latches[latch_index].lit >> 1;
+	vector<uint64_t> values(circuit_->maxvar + 1);
+	vector<uint64_t> next_latches(circuit_->num_latches);
+
+	// one flip time step per bit
+	for (unsigned first = 0; first < flip_timesteps.size(); first += 64)
+	{
+		unsigned num_lanes = flip_timesteps.size() - first;
+		if (num_lanes > 64)
+			num_lanes = 64;
+		uint64_t lanes = num_lanes == 64 ? ~0ULL : (1ULL << num_lanes) - 1;
+
+		// all lanes follow the fault-free trace until their flip
+		unsigned begin = flip_timesteps[first];
+		for (unsigned l = 0; l < circuit_->num_latches; ++l)
+			values[circuit_->latches[l].lit >> 1] = broadcast(ok_states[begin][l]);
+
+		uint64_t flipped = 0;
+		uint64_t outputs_different = 0;
+		uint64_t alarm_raised = 0;
+		for (unsigned timestep = begin; timestep < error_gone_timestep; ++timestep)
+		{
+			for (unsigned lane = 0; lane < num_lanes; ++lane)
+			{
+				if (flip_timesteps[first + lane] == timestep)
+				{
+					values[latch_var] ^= 1ULL << lane;
+					flipped |= 1ULL << lane;
+				}
+			}
+
+			values[0] = 0; // constant FALSE
+			for (unsigned i = 0; i < circuit_->num_inputs; ++i)
+				values[circuit_->inputs[i].lit >> 1] = broadcast(testcase[timestep][i]);
+			for (unsigned b = 0; b < circuit_->num_ands; ++b)
+			{
+				values[circuit_->ands[b].lhs >> 1] = readWord(values, circuit_->ands[b].rhs0)
+						& readWord(values, circuit_->ands[b].rhs1);
+			}
+
+			const vector<int>& relevant = relevant_outputs[timestep];
+			for (unsigned o = 0; o < circuit_->num_outputs - 1; ++o)
+			{
+				if (!relevant.empty() && relevant[o] == AIG_FALSE)
+					continue;
+				uint64_t ok = broadcast(ok_outputs[timestep][o]);
+				outputs_different |= readWord(values, circuit_->outputs[o].lit) ^ ok;
+			}
+
+			uint64_t new_alarms = readWord(values, alarm_lit) & flipped & ~alarm_raised & lanes;
+			for (unsigned lane = 0; lane < num_lanes; ++lane)
+			{
+				if (new_alarms & (1ULL << lane))
+					alarm_timesteps[first + lane] = timestep;
+			}
+			alarm_raised |= new_alarms;
+
+			for (unsigned l = 0; l < circuit_->num_latches; ++l)
+				next_latches[l] = readWord(values, circuit_->latches[l].next);
+			for (unsigned l = 0; l < circuit_->num_latches; ++l)
+				values[circuit_->latches[l].lit >> 1] = next_latches[l];
+		}
+
+		// the error must be gone, except in the error latches
+		uint64_t state_different = 0;
+		for (unsigned l = 0; l < circuit_->num_latches - num_err_latches_; ++l)
+			state_different |= next_latches[l] ^ broadcast(next_state_ok[l]);
+
+		uint64_t hit_lanes = alarm_raised & ~outputs_different & ~state_different & lanes;
+		for (unsigned lane = 0; lane < num_lanes; ++lane)
+		{
+			if (hit_lanes & (1ULL << lane))
+			{
+				hits[first + lane] = true;
+				num_hits++;
+			}
+		}
+	}
+
+	return num_hits;
+}
+
+int FalsePositives::addErrorGoneCondition(SatSolver* solver, const vector<int>& alarm_literals,
+		const vector<int>& next_cnf_values, const vector<int>& next_state_ok,
+		int& next_free_cnf_var)
+{
+	int error_gone = next_free_cnf_var++;
+	solver->addVarToKeep(error_gone);
+
+	// error_gone -> the alarm was raised in one of the time steps so far
+	vector<int> alarm_clause = alarm_literals;
+	alarm_clause.push_back(-error_gone);
+	solver->incAddClause(alarm_clause);
+
+	// error_gone -> the state is equal to the fault-free one (except the error latches)
+	for (unsigned state_idx = 0; state_idx < next_cnf_values.size() - num_err_latches_;
+			++state_idx)
+	{
+		int ok_lit = next_state_ok[state_idx];
+		int symb_lit = next_cnf_values[state_idx];
+		if (ok_lit == CNF_FALSE)
+			solver->incAdd2LitClause(-error_gone, -symb_lit);
+		else if (ok_lit == CNF_TRUE)
+			solver->incAdd2LitClause(-error_gone, symb_lit);
+		else
+		{
+			solver->incAdd3LitClause(-error_gone, -ok_lit, symb_lit);
+			solver->incAdd3LitClause(-error_gone, ok_lit, -symb_lit);
+		}
+	}
+
+	return error_gone;
+}
+
+// -------------------------------------------------------------------------------------------
+void FalsePositives::addEqualOutputsCondition(SatSolver* solver, const vector<int>& outputs_ok,
+		const vector<int>& outputs_faulty, const vector<int>& relevant)
+{
+	// the last output is the alarm output
+	for (unsigned output_idx = 0; output_idx + 1 < outputs_ok.size(); ++output_idx)
+	{
+		int guard = relevant.empty() ? CNF_TRUE : relevant[output_idx];
+		if (guard == CNF_FALSE)
+			continue;
+
+		int ok_lit = outputs_ok[output_idx];
+		int symb_lit = outputs_faulty[output_idx];
+		if (guard != CNF_TRUE)
+		{
+			solver->incAdd3LitClause(-guard, -ok_lit, symb_lit);
+			solver->incAdd3LitClause(-guard, ok_lit, -symb_lit);
+		}
+		else if (ok_lit == CNF_FALSE)
+			solver->incAddUnitClause(-symb_lit);
+		else if (ok_lit == CNF_TRUE)
+			solver->incAddUnitClause(symb_lit);
+		else
+		{
+			solver->incAdd2LitClause(-ok_lit, symb_lit);
+			solver->incAdd2LitClause(ok_lit, -symb_lit);
+		}
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+unsigned FalsePositives::parseFlipModel(const vector<int>& model, unsigned timestep,
+		const map<int, unsigned>& fi_to_timestep, const map<int, unsigned>& alarmlit_to_timestep,
+		int cj_limit, int& fi, int& cj, const TestCase* cnf_testcase, TestCase* testcase)
+{
+	map<int, unsigned> cnf_input_var_to_aig_truth_lit;
+	cnf_input_var_to_aig_truth_lit[CNF_TRUE] = AIG_TRUE;
+	cnf_input_var_to_aig_truth_lit[CNF_FALSE] = AIG_FALSE;
+
+	unsigned earliest_alarm_timestep = timestep + 1;
+	fi = CNF_TRUE;
+	cj = CNF_TRUE;
+
+	for (unsigned model_count = 0; model_count < model.size(); model_count++)
+	{
+		int lit = model[model_count];
+		if (cnf_testcase && abs(lit) != 1)
+			cnf_input_var_to_aig_truth_lit[lit] = (lit > 0) ? AIG_TRUE : AIG_FALSE;
+
+		if (lit > 0 && lit < cj_limit) // we have found the one and only active cj signal
+		{
+			cj = lit;
+			continue;
+		}
+
+		// parse f time step
+		map<int, unsigned>::const_iterator it = fi_to_timestep.find(lit);
+		if (lit > 0 && it != fi_to_timestep.end()) // we have found the fi variable which was set to TRUE
+		{
+			fi = lit;
+			continue;
+		}
+
+		// parse earliest alarm time step
+		it = alarmlit_to_timestep.find(lit);
+		if (it != alarmlit_to_timestep.end() && it->second < earliest_alarm_timestep)
+			earliest_alarm_timestep = it->second;
+	}
+
+	// concretize the open inputs of the test-case
+	if (cnf_testcase)
+	{
+		testcase->clear();
+		testcase->reserve(cnf_testcase->size());
+		for (TestCase::const_iterator in = cnf_testcase->begin(); in != cnf_testcase->end(); ++in)
+		{
+			vector<int> concrete_input_vector;
+			concrete_input_vector.reserve(in->size());
+			for (vector<int>::const_iterator iv = in->begin(); iv != in->end(); ++iv)
+				concrete_input_vector.push_back(cnf_input_var_to_aig_truth_lit[*iv]);
+			testcase->push_back(concrete_input_vector);
+		}
+	}
+
+	if (earliest_alarm_timestep != timestep + 1)
+		return earliest_alarm_timestep;
+
+	// the flip literal itself raises the alarm
+	map<int, unsigned>::const_iterator it = alarmlit_to_timestep.find(fi);
+	return it != alarmlit_to_timestep.end() ? it->second : 0;
+}
+
+// -------------------------------------------------------------------------------------------
+vector<unsigned> FalsePositives::getLatchesToCheck()
+{
+	if (!latch_subset_.empty())
+		return latch_subset_;
+	return Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the work shared by the threads of FalsePositives::analyzePartitioned()
+struct FpWorkQueue
+{
+	vector<FalsePositives*>* groups_;
+	vector<TestCase>* testcases_;
+	unsigned next_group_;
+	pthread_mutex_t mutex_;
+};
+
+// -------------------------------------------------------------------------------------------
+static void* analyzeGroups(void* queue)
+{
+	FpWorkQueue* q = static_cast<FpWorkQueue*>(queue);
+	while (true)
+	{
+		pthread_mutex_lock(&q->mutex_);
+		unsigned group = q->next_group_++;
+		pthread_mutex_unlock(&q->mutex_);
+		if (group >= q->groups_->size())
+			return 0;
+		(*q->groups_)[group]->analyze(*(q->testcases_));
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+void FalsePositives::analyzePartitioned(vector<TestCase>& testcases, unsigned num_threads)
+{
+	clearSuperfluousList();
+	restoreJournaledTraces(); // for all groups, as a sequential run does
+	vector<unsigned> l_list = getLatchesToCheck();
+	bool symb_location = (mode_ == SYMB_TIME_LOCATION || mode_ == SYMB_TIME_LOCATION_INPUTS);
+
+	// modes 0 and 2 analyze one latch after the other in the scheduled order, so contiguous
+	// groups of that order yield the traces of a sequential run one group after the other
+	vector<unsigned> scheduled = l_list;
+	if (!symb_location)
+		scheduleLatches(scheduled);
+
+	// a few groups per thread balance the load, contiguous groups keep the order of the latches
+	unsigned num_groups = num_threads * 4;
+	if (num_groups > l_list.size())
+		num_groups = l_list.size();
+	if (num_threads > num_groups)
+		num_threads = num_groups;
+	L_DBG("analyzing " << l_list.size() << " latches in " << num_groups << " groups with "
+			<< num_threads << " threads")
+
+	vector<FalsePositives*> groups(num_groups);
+	for (unsigned g = 0; g < num_groups; ++g)
+	{
+		unsigned begin = (l_list.size() * g) / num_groups;
+		unsigned end = (l_list.size() * (g + 1)) / num_groups;
+		groups[g] = new FalsePositives(circuit_, num_err_latches_, only_one_trace_per_latch_, mode_);
+		// Utils::genLit2IndexMap() needs the latches of a group in the order of the circuit
+		set<unsigned> in_group(scheduled.begin() + begin, scheduled.begin() + end);
+		for (unsigned l_cnt = 0; l_cnt < l_list.size(); ++l_cnt)
+		{
+			if (in_group.find(l_list[l_cnt]) != in_group.end())
+				groups[g]->latch_subset_.push_back(l_list[l_cnt]);
+		}
+		groups[g]->setEnvironmentModel(environment_model_);
+		groups[g]->detected_latches_ = detected_latches_; // found in a resumed run
+		groups[g]->journal_ = journal_; // shared, AnalysisJournal is thread-safe
+	}
+
+	FpWorkQueue queue;
+	queue.groups_ = &groups;
+	queue.testcases_ = &testcases;
+	queue.next_group_ = 0;
+	pthread_mutex_init(&queue.mutex_, 0);
+
+	vector<pthread_t> threads(num_threads);
+	for (unsigned t = 0; t < num_threads; ++t)
+	{
+		int rc = pthread_create(&threads[t], 0, analyzeGroups, &queue);
+		MASSERT(rc == 0, "could not create a thread for the false-positives analysis")
+	}
+	for (unsigned t = 0; t < num_threads; ++t)
+		pthread_join(threads[t], 0);
+	pthread_mutex_destroy(&queue.mutex_);
+
+	// merge the results in the order of a sequential run, so the output is deterministic
+	if (symb_location)
+	{
+		for (unsigned tc_number = 0; tc_number < testcases.size(); ++tc_number)
+		{
+			unsigned first = superfluous.size();
+			for (unsigned g = 0; g < num_groups; ++g)
+			{
+				const vector<SuperfluousTrace*>& traces = groups[g]->superfluous;
+				superfluous.insert(superfluous.end(),
+						traces.begin() + groups[g]->getTestcaseBegin(tc_number),
+						traces.begin() + groups[g]->getTestcaseBegin(tc_number + 1));
+			}
+			sortTestcaseTraces(first);
+		}
+	}
+	else
+	{
+		for (unsigned g = 0; g < num_groups; ++g)
+			superfluous.insert(superfluous.end(), groups[g]->superfluous.begin(),
+					groups[g]->superfluous.end());
+	}
+	num_journaled_traces_ = superfluous.size(); // the groups journaled their traces
+
+	for (unsigned g = 0; g < num_groups; ++g)
+	{
+		FalsePositives* analysis = groups[g];
+		const set<unsigned>& detected = analysis->getDetectedLatches();
+		detected_latches_.insert(detected.begin(), detected.end());
+		const set<unsigned>& unknown = analysis->getUnknownLatches();
+		unknown_latches_.insert(unknown.begin(), unknown.end());
+		analysis->superfluous.clear(); // the traces belong to this instance now
+		analysis->journal_ = 0; // owned by this instance
+		delete analysis;
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+unsigned FalsePositives::getTestcaseBegin(unsigned testcase) const
+{
+	if (testcase < testcase_begins_.size())
+		return testcase_begins_[testcase];
+	return superfluous.size();
+}
+
+// -------------------------------------------------------------------------------------------
+static bool isEarlierTrace(const SuperfluousTrace* a, const SuperfluousTrace* b)
+{
+	if (a->error_gone_timestep_ != b->error_gone_timestep_)
+		return a->error_gone_timestep_ < b->error_gone_timestep_;
+	if (a->component_index_ != b->component_index_)
+		return a->component_index_ < b->component_index_;
+	return a->flip_timestep_ < b->flip_timestep_;
+}
+
+// -------------------------------------------------------------------------------------------
+void FalsePositives::sortTestcaseTraces(unsigned first)
+{
+	stable_sort(superfluous.begin() + first, superfluous.end(), isEarlierTrace);
+}
+
 void FalsePositives::clearSuperfluousList()
 {
 	for(unsigned i = 0; i < superfluous.size(); i++)
@@ -1432,3 +1127,44 @@ void FalsePositives::clearSuperfluousList()
 	}
 	superfluous.clear();
 }
+
+// -------------------------------------------------------------------------------------------
+void FalsePositives::restoreJournaledTraces()
+{
+	num_journaled_traces_ = 0;
+	if (journal_ == 0 || !latch_subset_.empty())
+		return;
+
+	vector<unsigned> l_list = getLatchesToCheck();
+	set<unsigned> in_scope(l_list.begin(), l_list.end());
+	const vector<SuperfluousTrace>& traces = journal_->getTraces();
+	for (unsigned i = 0; i < traces.size(); ++i)
+	{
+		if (in_scope.find(traces[i].component_) != in_scope.end())
+			superfluous.push_back(new SuperfluousTrace(traces[i]));
+	}
+	num_journaled_traces_ = superfluous.size();
+}
+
+// -------------------------------------------------------------------------------------------
+void FalsePositives::journalTraces()
+{
+	if (journal_ == 0)
+		return;
+	for (; num_journaled_traces_ < superfluous.size(); ++num_journaled_traces_)
+		journal_->markTrace(*superfluous[num_journaled_traces_]);
+}
+
+// -------------------------------------------------------------------------------------------
+void FalsePositives::journalTestcaseDone(unsigned latch_aig, unsigned testcase)
+{
+	journalTraces();
+	journalDone(latch_aig, testcase);
+}
+
+// -------------------------------------------------------------------------------------------
+void FalsePositives::journalTestcaseDone(const vector<unsigned>& latches, unsigned testcase)
+{
+	journalTraces();
+	journalDone(latches, testcase);
+}
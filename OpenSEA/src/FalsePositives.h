@@ -31,6 +31,8 @@
 #include "SuperFluousTrace.h"
 
 struct aiger;
+class SatSolver;
+struct FpUnrolling;
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -109,6 +111,12 @@ public:
 
 	void printResults();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief copies the results from the representatives to the other latches of their fault
+/// collapsing class, including the traces (re-targeted to each member)
+	void propagateCollapsedLatches();
+
 
 	vector<SuperfluousTrace*> getSuperfluous()
 	{
@@ -137,13 +145,215 @@ protected:
 
 	void addSuperfluousTrace(int component, int component_index, TestCase& testcase,  unsigned flip_timestep, unsigned alarm_timestep, unsigned error_gone_ts);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the outcome of analyzeTestcase()
+	enum TestcaseResult
+	{
+		TC_COMPLETE = 0,           ///< all time steps have been analyzed
+		TC_LATCH_DONE = 1,         ///< the one trace of the latch has been found (modes 0 and 2)
+		TC_GAVE_UP = 2,            ///< the solver or the budget stopped the test-case early
+		TC_ALARM_WITHOUT_ERROR = 3 ///< the fault-free run raises the alarm
+	};
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the analysis of all four modes
+///
+/// Modes 0 and 2 analyze one latch after the other, modes 1 and 3 flip all latches at once
+/// (selected by cj literals). Each test-case is unrolled by analyzeTestcase().
+///
+/// @param testcases a vector of TestCases.
+/// @param symb_location true to flip all latches at once (modes 1 and 3).
+/// @param free_inputs true to let the solver choose open inputs (modes 2 and 3).
+/// @return TRUE if false positives were found.
+	bool findFalsePositives(vector<TestCase> &testcases, bool symb_location, bool free_inputs);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief unrolls one test-case and queries every time step for false positives
+///
+/// The time-step loop shared by all modes. The fault-free run is concrete, or symbolic if
+/// the inputs are free. With a single latch and concrete inputs, flips are also simulated
+/// concretely (see simulateFlips()).
+///
+/// @param unrolling the solver, the simulators and the flipped latches.
+/// @param testcase the test-case.
+/// @param tc_number the index of the test-case.
+/// @return how the test-case ended.
+	TestcaseResult analyzeTestcase(FpUnrolling& unrolling, TestCase& testcase, unsigned tc_number);
+
 
 	vector<SuperfluousTrace*> superfluous;
 
 	bool isEqualN(vector<int> a, vector<int> b, int elements_to_skip);
 
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief tests several flip time steps of one latch concretely (bit-parallel, 64 per word)
+	///
+	/// A flip time step is a hit if the flip raises the alarm, never changes a (relevant)
+	/// output, and the state after error_gone_timestep - 1 equals the fault-free one, i.e., if
+	/// the SAT query of findFalsePositives_1b() would return the same trace.
+	///
+	/// @param testcase the concrete inputs.
+	/// @param latch_index the index of the flipped latch.
+	/// @param ok_states the fault-free state at the beginning of every time step so far.
+	/// @param ok_outputs the fault-free outputs of every time step so far.
+	/// @param relevant_outputs the relevant outputs of every time step (empty = all relevant).
+	/// @param next_state_ok the fault-free state after error_gone_timestep - 1.
+	/// @param error_gone_timestep the time step in which the state must be fault-free again.
+	/// @param flip_timesteps the flip time steps to test (ascending).
+	/// @param hits true for every flip time step which is a hit.
+	/// @param alarm_timesteps the earliest alarm per flip time step (only valid for hits).
+	/// @return the number of hits.
+	unsigned simulateFlips(const TestCase& testcase, unsigned latch_index,
+			const vector<vector<int> >& ok_states, const vector<vector<int> >& ok_outputs,
+			const vector<vector<int> >& relevant_outputs, const vector<int>& next_state_ok,
+			unsigned error_gone_timestep, const vector<unsigned>& flip_timesteps,
+			vector<bool>& hits, vector<unsigned>& alarm_timesteps);
+
 	void clearSuperfluousList();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds the traces of a resumed run (--resume) to superfluous
+///
+/// Only the traces of the latches returned by getLatchesToCheck() are restored. The groups of
+/// analyzePartitioned() restore nothing, their traces are restored once for all groups.
+	void restoreJournaledTraces();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records the traces of superfluous which are not in the journal yet
+	void journalTraces();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records the new traces and a completed (latch, test-case) pair in the journal
+///
+/// @param latch_aig the latch.
+/// @param testcase the index of the test-case.
+	void journalTestcaseDone(unsigned latch_aig, unsigned testcase);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief records the new traces and a test-case completed for all given latches (modes 1
+///        and 3, which flip all latches at once)
+///
+/// @param latches the latches of the analysis (of the group, in analyzePartitioned()).
+/// @param testcase the index of the test-case.
+	void journalTestcaseDone(const vector<unsigned>& latches, unsigned testcase);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the number of traces in superfluous which are already in the journal
+	unsigned num_journaled_traces_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the size of superfluous when each test-case of modes 1 and 3 starts
+///
+/// Lets analyzePartitioned() merge the traces of the groups per test-case.
+	vector<unsigned> testcase_begins_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the index of the first trace of a test-case in superfluous (modes 1 and 3)
+///
+/// @param testcase the index of the test-case.
+/// @return the index, superfluous.size() if the test-case was not analyzed.
+	unsigned getTestcaseBegin(unsigned testcase) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief sorts the traces of one test-case (and of one latch in modes 0 and 2)
+///
+/// The solver enumerates the traces of a time step in any order. Sorting them by time step,
+/// latch and flip time step makes the result independent of the history of the solver, so
+/// analyzePartitioned() yields the same list as a sequential run.
+///
+/// @param first the index of the first trace of the test-case in superfluous.
+	void sortTestcaseTraces(unsigned first);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds 'the alarm was raised and the error is gone', guarded by a new literal
+///
+/// The query of a time step then only assumes the returned literal, instead of listing the
+/// enable literals of all previous time steps and the whole next state. The literal must be
+/// retired with a unit clause (its negation) after the query.
+///
+/// @param solver the solver to add the clauses to.
+/// @param alarm_literals the alarm outputs of all time steps so far.
+/// @param next_cnf_values the (faulty) next state.
+/// @param next_state_ok the fault-free next state (CNF literals or constants).
+/// @param next_free_cnf_var the next free CNF variable, will be increased.
+/// @return the activation literal.
+	int addErrorGoneCondition(SatSolver* solver, const vector<int>& alarm_literals,
+			const vector<int>& next_cnf_values, const vector<int>& next_state_ok,
+			int& next_free_cnf_var);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds 'the (relevant) outputs are equal to the fault-free ones'
+///
+/// Used in every time step of all variants. The alarm output (the last one) is skipped.
+///
+/// @param solver the solver to add the clauses to.
+/// @param outputs_ok the fault-free outputs (CNF literals or constants).
+/// @param outputs_faulty the outputs of the symbolic simulation.
+/// @param relevant per output a CNF literal (or constant) which is true if the output is
+///        relevant, empty if all outputs are relevant.
+	void addEqualOutputsCondition(SatSolver* solver, const vector<int>& outputs_ok,
+			const vector<int>& outputs_faulty, const vector<int>& relevant);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief parses a model of the query of one time step (shared by all variants)
+///
+/// @param model the model returned by the SAT solver.
+/// @param timestep the current time step.
+/// @param fi_to_timestep maps the flip literals to their time step.
+/// @param alarmlit_to_timestep maps the alarm literals to their time step.
+/// @param cj_limit the literals 0 < lit < cj_limit select a latch (0 for modes 0 and 2).
+/// @param fi is set to the flip literal which is true.
+/// @param cj is set to the latch selection literal which is true (modes 1 and 3).
+/// @param cnf_testcase the test-case with open inputs (modes 2 and 3), or 0.
+/// @param testcase is set to cnf_testcase with the open inputs replaced by their values.
+/// @return the earliest time step in which the alarm is raised.
+	unsigned parseFlipModel(const vector<int>& model, unsigned timestep,
+			const map<int, unsigned>& fi_to_timestep, const map<int, unsigned>& alarmlit_to_timestep,
+			int cj_limit, int& fi, int& cj, const TestCase* cnf_testcase, TestCase* testcase);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief analyzes groups of latches with --fp_threads threads
+///
+/// The latches are split into more groups than threads, every thread takes the next group
+/// when it is done. Each group is analyzed by its own FalsePositives instance (and thus SAT
+/// solver). The groups share the journal, so a resumed run skips the work of each group. The
+/// results are merged into the order of a sequential run: modes 0 and 2 split the scheduled
+/// latches (see BackEnd::scheduleLatches()) into contiguous groups and append the groups one
+/// after the other, modes 1 and 3 merge the traces of the groups test-case by test-case. So
+/// the output depends neither on the timing of the threads nor on their number.
+///
+/// @param testcases a vector of TestCases.
+/// @param num_threads the number of threads.
+	void analyzePartitioned(vector<TestCase>& testcases, unsigned num_threads);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the latches to analyze: latch_subset_, or all not excluded latches
+///
+/// @return the latches to analyze.
+	vector<unsigned> getLatchesToCheck();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the latches of this group, empty if all latches are analyzed
+	vector<unsigned> latch_subset_;
+
 
 private:
 
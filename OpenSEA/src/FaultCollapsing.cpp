@@ -0,0 +1,289 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file FaultCollapsing.cpp
+/// @brief Contains the definition of the class FaultCollapsing.
+// -------------------------------------------------------------------------------------------
+
+#include "FaultCollapsing.h"
+#include "Options.h"
+#include "Logger.h"
+#include "Utils.h"
+#include "SatSolver.h"
+#include "SymbolicSimulator.h"
+#include "AndCacheMap.h"
+#include "CnfUtils.h"
+
+extern "C"
+{
+#include "aiger.h"
+}
+
+// number of 64-bit words (= 64 random patterns each) used for the simulation signatures
+#define NUM_SIM_ROUNDS 4
+
+// -------------------------------------------------------------------------------------------
+static inline uint64_t nextRandomWord(uint64_t &state)
+{
+	// splitmix64: deterministic, so the classes do not depend on the seed of rand()
+	state += 0x9E3779B97F4A7C15ULL;
+	uint64_t z = state;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// -------------------------------------------------------------------------------------------
+static inline uint64_t mixSignature(uint64_t signature, uint64_t value)
+{
+	signature = (signature ^ value) * 0x100000001B3ULL;
+	return signature ^ (signature >> 29);
+}
+
+// -------------------------------------------------------------------------------------------
+static inline uint64_t readWord(const vector<uint64_t> &values, unsigned aigerlit)
+{
+	return aigerlit & 1 ? ~values[aigerlit >> 1] : values[aigerlit >> 1];
+}
+
+// -------------------------------------------------------------------------------------------
+FaultCollapsing::FaultCollapsing(aiger* circuit, bool confirm_with_sat) :
+		circuit_(circuit), confirm_with_sat_(confirm_with_sat)
+{
+}
+
+// -------------------------------------------------------------------------------------------
+FaultCollapsing::~FaultCollapsing()
+{
+	// nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+void FaultCollapsing::computeClasses(const vector<unsigned> &latches_to_check)
+{
+	representatives_.clear();
+	class_members_.clear();
+
+	map<unsigned, unsigned> literal_to_idx;
+	Utils::genLit2IndexMap(latches_to_check, circuit_, literal_to_idx);
+
+	vector<unsigned> latch_indices;
+	latch_indices.reserve(latches_to_check.size());
+	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
+		latch_indices.push_back(literal_to_idx[latches_to_check[l_cnt]]);
+
+	vector<uint64_t> sim_signatures;
+	computeSimulationSignatures(latch_indices, sim_signatures);
+
+	// maps (structural signature, simulation signature) to the positions of the
+	// representatives having these signatures
+	map<pair<uint64_t, uint64_t>, vector<unsigned> > candidates;
+	unsigned num_sat_calls = 0;
+
+	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
+	{
+		pair<uint64_t, uint64_t> key(computeStructuralSignature(latch_indices[l_cnt]),
+				sim_signatures[l_cnt]);
+		vector<unsigned> &reps_with_same_signature = candidates[key];
+
+		bool merged = false;
+		for (unsigned r_cnt = 0; r_cnt < reps_with_same_signature.size(); ++r_cnt)
+		{
+			unsigned rep_pos = reps_with_same_signature[r_cnt];
+			if (confirm_with_sat_)
+			{
+				num_sat_calls++;
+				if (!confirmEquivalence(latch_indices[rep_pos], latch_indices[l_cnt]))
+					continue;
+			}
+			class_members_[latches_to_check[rep_pos]].push_back(latches_to_check[l_cnt]);
+			merged = true;
+			break;
+		}
+
+		if (!merged)
+		{
+			reps_with_same_signature.push_back(l_cnt);
+			representatives_.push_back(latches_to_check[l_cnt]);
+		}
+	}
+
+	L_LOG("Fault collapsing: " << latches_to_check.size() << " latches, "
+			<< representatives_.size() << " classes, " << num_sat_calls << " SAT calls")
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<unsigned>& FaultCollapsing::getRepresentatives() const
+{
+	return representatives_;
+}
+
+// -------------------------------------------------------------------------------------------
+void FaultCollapsing::propagateVerdict(set<unsigned> &detected_latches) const
+{
+	for (map<unsigned, vector<unsigned> >::const_iterator it = class_members_.begin();
+			it != class_members_.end(); ++it)
+	{
+		if (detected_latches.find(it->first) != detected_latches.end())
+			detected_latches.insert(it->second.begin(), it->second.end());
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+const vector<unsigned>& FaultCollapsing::getClassMembers(unsigned representative) const
+{
+	static const vector<unsigned> no_members;
+	map<unsigned, vector<unsigned> >::const_iterator it = class_members_.find(representative);
+	if (it == class_members_.end())
+		return no_members;
+	return it->second;
+}
+
+// -------------------------------------------------------------------------------------------
+uint64_t FaultCollapsing::computeStructuralSignature(unsigned latch_idx) const
+{
+	// forward cone: the AND gates are topologically ordered
+	vector<bool> in_cone(circuit_->maxvar + 1, false);
+	in_cone[circuit_->latches[latch_idx].lit >> 1] = true;
+	for (unsigned b = 0; b < circuit_->num_ands; ++b)
+	{
+		if (in_cone[circuit_->ands[b].rhs0 >> 1] || in_cone[circuit_->ands[b].rhs1 >> 1])
+			in_cone[circuit_->ands[b].lhs >> 1] = true;
+	}
+
+	uint64_t signature = 0;
+	for (unsigned o = 0; o < circuit_->num_outputs; ++o)
+	{
+		if (in_cone[circuit_->outputs[o].lit >> 1])
+			signature = mixSignature(signature, o + 1);
+	}
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		if (in_cone[circuit_->latches[l].next >> 1])
+			signature = mixSignature(signature, circuit_->num_outputs + l + 1);
+	}
+	return signature;
+}
+
+// -------------------------------------------------------------------------------------------
+void FaultCollapsing::computeSimulationSignatures(const vector<unsigned> &latch_indices,
+		vector<uint64_t> &signatures) const
+{
+	signatures.assign(latch_indices.size(), 0);
+
+	uint64_t rand_state = 0;
+	vector<uint64_t> golden(circuit_->maxvar + 1, 0);
+	vector<uint64_t> faulty;
+
+	for (unsigned round = 0; round < NUM_SIM_ROUNDS; ++round)
+	{
+		// random state and inputs, 64 patterns at once
+		for (unsigned i = 0; i < circuit_->num_inputs; ++i)
+			golden[circuit_->inputs[i].lit >> 1] = nextRandomWord(rand_state);
+		for (unsigned l = 0; l < circuit_->num_latches; ++l)
+			golden[circuit_->latches[l].lit >> 1] = nextRandomWord(rand_state);
+		simulateWords(golden);
+
+		for (unsigned l_cnt = 0; l_cnt < latch_indices.size(); ++l_cnt)
+		{
+			faulty = golden;
+			unsigned flipped_var = circuit_->latches[latch_indices[l_cnt]].lit >> 1;
+			faulty[flipped_var] = ~faulty[flipped_var];
+			simulateWords(faulty);
+
+			// signature of the differences in outputs and next state caused by the flip
+			uint64_t signature = signatures[l_cnt];
+			for (unsigned o = 0; o < circuit_->num_outputs; ++o)
+			{
+				unsigned lit = circuit_->outputs[o].lit;
+				signature = mixSignature(signature, readWord(golden, lit) ^ readWord(faulty, lit));
+			}
+			for (unsigned l = 0; l < circuit_->num_latches; ++l)
+			{
+				unsigned lit = circuit_->latches[l].next;
+				signature = mixSignature(signature, readWord(golden, lit) ^ readWord(faulty, lit));
+			}
+			signatures[l_cnt] = signature;
+		}
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+void FaultCollapsing::simulateWords(vector<uint64_t> &values) const
+{
+	values[0] = 0; // constant FALSE
+	for (unsigned b = 0; b < circuit_->num_ands; ++b)
+	{
+		values[circuit_->ands[b].lhs >> 1] = readWord(values, circuit_->ands[b].rhs0)
+				& readWord(values, circuit_->ands[b].rhs1);
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+bool FaultCollapsing::confirmEquivalence(unsigned latch_idx_a, unsigned latch_idx_b) const
+{
+	int next_free_cnf_var = 2;
+	SatSolver* solver = Options::instance().getSATSolver();
+	vector<int> vars_to_keep; // empty
+	solver->startIncrementalSession(vars_to_keep);
+	solver->incAddUnitClause(CNF_TRUE);
+
+	// both copies share the AND gates which are not affected by the flips
+	AndCacheMap cache(solver);
+	SymbolicSimulator sim_a(circuit_, solver, next_free_cnf_var);
+	SymbolicSimulator sim_b(circuit_, solver, next_free_cnf_var);
+	sim_a.setCache(&cache);
+	sim_b.setCache(&cache);
+
+	// same (arbitrary) state and inputs for both copies
+	sim_a.setStateValuesOpen();
+	sim_a.setInputValuesOpen();
+	sim_b.setResults(sim_a.getResults());
+
+	unsigned var_a = circuit_->latches[latch_idx_a].lit >> 1;
+	unsigned var_b = circuit_->latches[latch_idx_b].lit >> 1;
+	sim_a.setResultValue(var_a, -sim_a.getResultValue(var_a));
+	sim_b.setResultValue(var_b, -sim_b.getResultValue(var_b));
+
+	sim_a.simulateOneTimeStep();
+	sim_b.simulateOneTimeStep();
+
+	// outputs (incl. alarm) and next state must be equal in all cases
+	vector<int> observable_a = sim_a.getOutputValues();
+	vector<int> observable_b = sim_b.getOutputValues();
+	const vector<int> &next_a = sim_a.getNextLatchValues();
+	const vector<int> &next_b = sim_b.getNextLatchValues();
+	observable_a.insert(observable_a.end(), next_a.begin(), next_a.end());
+	observable_b.insert(observable_b.end(), next_b.begin(), next_b.end());
+
+	vector<int> is_different_clause;
+	CnfUtils::generateVectorIsDifferentClause(observable_a, observable_b, is_different_clause,
+			next_free_cnf_var, solver);
+
+	bool equivalent = true;
+	if (!is_different_clause.empty())
+	{
+		solver->incAddClause(is_different_clause);
+		equivalent = !solver->incIsSat();
+	}
+
+	delete solver;
+	return equivalent;
+}
@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file FaultCollapsing.h
+/// @brief Contains the declaration of the class FaultCollapsing.
+// -------------------------------------------------------------------------------------------
+
+#ifndef FaultCollapsing_H__
+#define FaultCollapsing_H__
+
+#include <stdint.h>
+#include "defines.h"
+
+struct aiger;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class FaultCollapsing
+/// @brief Groups latches whose bit-flips are equivalent, so that only one representative
+/// per class has to be analyzed by a back-end.
+///
+/// Flipping latch a and flipping latch b are equivalent if, for every state and every
+/// input, both faulty versions produce the same outputs (including the alarm output) and
+/// the same next state. After one step both faulty runs are identical, so every back-end
+/// comes to the same verdict for a and b.
+///
+/// Candidates are found with two cheap necessary conditions: a structural signature (the
+/// set of outputs and next-state functions in the fanout cone of the latch) and a
+/// bit-parallel simulation signature (the output/next-state differences caused by the flip
+/// for 64 random states and inputs per round). Candidates can optionally be confirmed with
+/// a SAT-based miter over all states and inputs.
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class FaultCollapsing
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param circuit the circuit whose latches should be collapsed
+/// @param confirm_with_sat if true, every class member is confirmed with a SAT-solver call
+	FaultCollapsing(aiger* circuit, bool confirm_with_sat = true);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+	virtual ~FaultCollapsing();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief groups the given latches into classes of equivalent latches
+///
+/// @param latches_to_check the literals of the latches to group
+	void computeClasses(const vector<unsigned> &latches_to_check);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns one representative (latch literal) per class, in the original order
+///
+/// @return the list of representatives
+	const vector<unsigned>& getRepresentatives() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds all class members of the representatives contained in the given set
+///
+/// @param detected_latches the latches detected by a back-end (extended in place)
+	void propagateVerdict(set<unsigned> &detected_latches) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the other members of the class of a representative
+///
+/// @param representative the literal of a latch
+/// @return the literals of the other class members (empty if the latch is not a
+///         representative or its class has no other members)
+	const vector<unsigned>& getClassMembers(unsigned representative) const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief computes the structural fanout-cone signature of a latch
+///
+/// @param latch_idx the aiger index of the latch
+/// @return a hash of the outputs and next-state functions depending on the latch
+	uint64_t computeStructuralSignature(unsigned latch_idx) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief computes the bit-parallel simulation signatures of all given latches
+///
+/// @param latch_indices the aiger indices of the latches
+/// @param signatures the resulting signatures (same order as latch_indices)
+	void computeSimulationSignatures(const vector<unsigned> &latch_indices,
+			vector<uint64_t> &signatures) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks with a SAT-solver whether the flips of two latches are equivalent
+///
+/// @param latch_idx_a the aiger index of the first latch
+/// @param latch_idx_b the aiger index of the second latch
+/// @return true if both flips lead to the same outputs and next state in all cases
+	bool confirmEquivalence(unsigned latch_idx_a, unsigned latch_idx_b) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief evaluates all AND gates bit-parallel (64 patterns per word)
+///
+/// @param values one word per aiger variable, latches and inputs must be set
+	void simulateWords(vector<uint64_t> &values) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The circuit to analyze
+	aiger* circuit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief if true, candidates with equal signatures are confirmed by a SAT-solver call
+	bool confirm_with_sat_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief one representative latch literal per class
+	vector<unsigned> representatives_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief maps a representative to the other members of its class
+	map<unsigned, vector<unsigned> > class_members_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+	FaultCollapsing(const FaultCollapsing &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+	FaultCollapsing& operator=(const FaultCollapsing &other);
+
+};
+
+#endif // FaultCollapsing_H__
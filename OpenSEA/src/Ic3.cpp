@@ -0,0 +1,562 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file Ic3.cpp
+/// @brief Contains the definition of the class Ic3.
+// -------------------------------------------------------------------------------------------
+
+#include "Ic3.h"
+#include "Logger.h"
+#include "SatSolver.h"
+
+extern "C"
+{
+#include "aiger.h"
+}
+
+// -------------------------------------------------------------------------------------------
+Ic3::Ic3(aiger* circuit, SatSolver* solver) :
+		circuit_(circuit), solver_(solver), bad_lit_(0), top_(0), assumptions_act_(0),
+		last_query_assumed_(false), num_inductive_candidates_(0), next_free_cnf_var_(0)
+{
+	MASSERT(circuit_->num_outputs > 0, "the circuit has no bad output")
+	encode();
+}
+
+// -------------------------------------------------------------------------------------------
+Ic3::~Ic3()
+{
+	// nothing to be done
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::encode()
+{
+	// CNF var v+1 represents aiger var v (as in AIG2CNF), var 1 is FALSE
+	next_free_cnf_var_ = circuit_->maxvar + 2;
+	vector<int> vars_to_keep; // empty
+	solver_->startIncrementalSession(vars_to_keep, false);
+	solver_->setConflictLimit(-1); // lemmas must not depend on unknown results
+	solver_->incAddUnitClause(CNF_TRUE);
+
+	for (unsigned a = 0; a < circuit_->num_ands; ++a)
+	{
+		int lhs = aigLitToCnfLit(circuit_->ands[a].lhs);
+		int rhs0 = aigLitToCnfLit(circuit_->ands[a].rhs0);
+		int rhs1 = aigLitToCnfLit(circuit_->ands[a].rhs1);
+		solver_->incAdd2LitClause(-lhs, rhs0);
+		solver_->incAdd2LitClause(-lhs, rhs1);
+		solver_->incAdd3LitClause(lhs, -rhs0, -rhs1);
+	}
+
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		int latch_var = aigLitToCnfLit(circuit_->latches[l].lit);
+		int next_var = next_free_cnf_var_++;
+		int next_function = aigLitToCnfLit(circuit_->latches[l].next);
+		solver_->incAdd2LitClause(-next_var, next_function);
+		solver_->incAdd2LitClause(next_var, -next_function);
+
+		latch_vars_.push_back(latch_var);
+		next_vars_.push_back(next_var);
+		latch_index_[latch_var] = l;
+		reset_values_.push_back(circuit_->latches[l].reset);
+		solver_->addVarToKeep(latch_var);
+		solver_->addVarToKeep(next_var);
+		model_vars_.push_back(latch_var);
+	}
+
+	for (unsigned i = 0; i < circuit_->num_inputs; ++i)
+	{
+		int input_var = aigLitToCnfLit(circuit_->inputs[i].lit);
+		input_vars_.push_back(input_var);
+		solver_->addVarToKeep(input_var);
+		model_vars_.push_back(input_var);
+	}
+
+	bad_lit_ = aigLitToCnfLit(circuit_->outputs[circuit_->num_outputs - 1].lit);
+	if (abs(bad_lit_) > 1)
+		solver_->addVarToKeep(abs(bad_lit_));
+
+	// frame 0: the initial state, latches with a reset value other than 0/1 are uninitialized
+	int init_act = newActivationLiteral();
+	frame_act_.push_back(init_act);
+	frames_.push_back(vector<vector<int> >());
+	assumed_frames_.push_back(vector<vector<int> >());
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		if (reset_values_[l] == AIG_FALSE)
+			solver_->incAdd2LitClause(-init_act, -latch_vars_[l]);
+		else if (reset_values_[l] == AIG_TRUE)
+			solver_->incAdd2LitClause(-init_act, latch_vars_[l]);
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::constrainInput(unsigned input_lit, bool value)
+{
+	int input_cnf = aigLitToCnfLit(input_lit);
+	solver_->incAddUnitClause(value ? input_cnf : -input_cnf);
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::setInputAssumptions(const vector<unsigned>& input_lits)
+{
+	// the lemmas of the previous assumptions are not valid anymore
+	if (assumptions_act_ != 0)
+		solver_->incAddUnitClause(-assumptions_act_);
+	for (unsigned f = 0; f < assumed_frames_.size(); ++f)
+		assumed_frames_[f].clear();
+
+	assumptions_act_ = 0;
+	if (input_lits.empty())
+		return;
+
+	assumptions_act_ = newActivationLiteral();
+	for (unsigned i = 0; i < input_lits.size(); ++i)
+		solver_->incAdd2LitClause(-assumptions_act_, aigLitToCnfLit(input_lits[i]));
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::addCandidateLemma(const vector<unsigned>& clause)
+{
+	vector<int> cnf_clause;
+	cnf_clause.reserve(clause.size());
+	for (unsigned i = 0; i < clause.size(); ++i)
+	{
+		int lit = aigLitToCnfLit(clause[i]);
+		MASSERT(latch_index_.find(abs(lit)) != latch_index_.end(),
+				"candidate lemmas may only contain latches")
+		cnf_clause.push_back(lit);
+	}
+	candidates_.push_back(cnf_clause);
+}
+
+// -------------------------------------------------------------------------------------------
+Ic3::Result Ic3::check(unsigned max_frames)
+{
+	if (!candidates_.empty())
+		addInductiveCandidates();
+
+	// is there a bad initial state?
+	top_ = 0;
+	vector<int> assumptions = getFrameAssumptions(0);
+	assumptions.push_back(bad_lit_);
+	if (assumptions_act_ != 0)
+		assumptions.push_back(assumptions_act_);
+	if (solver_->incIsSat(assumptions))
+		return UNSAFE;
+
+	addFrame();
+	while (true)
+	{
+		// block all bad states in the top frame
+		while (true)
+		{
+			vector<int> no_core_assumptions; // empty
+			vector<int> model;
+			assumptions = getFrameAssumptions(top_);
+			assumptions.push_back(bad_lit_);
+			if (assumptions_act_ != 0)
+				assumptions.push_back(assumptions_act_);
+			if (!solver_->incIsSatModelOrCore(no_core_assumptions, assumptions, model_vars_, model))
+				break;
+
+			storeModel(model);
+			vector<int> bad(1, bad_lit_);
+			if (!blockCube(liftModel(bad), top_))
+			{
+				L_DBG("IC3: counterexample of length " << top_)
+				return UNSAFE;
+			}
+		}
+
+		if (max_frames != 0 && top_ >= max_frames)
+			return UNKNOWN;
+
+		addFrame();
+		if (propagateLemmas())
+		{
+			L_DBG("IC3: inductive invariant found in frame " << top_ - 1)
+			return SAFE;
+		}
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::addInductiveCandidates()
+{
+	// only candidates which hold in the initial state
+	vector<vector<int> > remaining;
+	for (unsigned c = 0; c < candidates_.size(); ++c)
+	{
+		for (unsigned i = 0; i < candidates_[c].size(); ++i)
+		{
+			int lit = candidates_[c][i];
+			unsigned reset = reset_values_[latch_index_[abs(lit)]];
+			if ((lit < 0 && reset == AIG_FALSE) || (lit > 0 && reset == AIG_TRUE))
+			{
+				remaining.push_back(candidates_[c]);
+				break;
+			}
+		}
+	}
+
+	// Houdini: drop candidates which are not implied (in the next state) by all remaining ones
+	bool changed = true;
+	while (changed && !remaining.empty())
+	{
+		changed = false;
+		int act = newActivationLiteral();
+		for (unsigned c = 0; c < remaining.size(); ++c)
+		{
+			vector<int> clause(remaining[c]);
+			clause.push_back(-act);
+			solver_->incAddClause(clause);
+		}
+
+		vector<vector<int> > inductive;
+		for (unsigned c = 0; c < remaining.size(); ++c)
+		{
+			vector<int> assumptions(1, act);
+			for (unsigned i = 0; i < remaining[c].size(); ++i)
+				assumptions.push_back(-prime(remaining[c][i]));
+
+			if (solver_->incIsSat(assumptions))
+				changed = true;
+			else
+				inductive.push_back(remaining[c]);
+		}
+		solver_->incAddUnitClause(-act);
+		remaining.swap(inductive);
+	}
+
+	// the inductive candidates hold in every frame
+	for (unsigned c = 0; c < remaining.size(); ++c)
+		solver_->incAddClause(remaining[c]);
+	num_inductive_candidates_ = remaining.size();
+	candidates_.clear();
+	L_DBG("IC3: " << num_inductive_candidates_ << " inductive candidate lemmas")
+}
+
+// -------------------------------------------------------------------------------------------
+bool Ic3::blockCube(const vector<int>& cube, unsigned level)
+{
+	// proof obligations, the lowest frame first
+	multimap<unsigned, vector<int> > obligations;
+	obligations.insert(make_pair(level, cube));
+	while (!obligations.empty())
+	{
+		multimap<unsigned, vector<int> >::iterator lowest = obligations.begin();
+		unsigned obl_level = lowest->first;
+		vector<int> obl_cube = lowest->second;
+		obligations.erase(lowest);
+
+		// lifted cubes only contain states leading to a bad state
+		if (obl_level == 0 || intersectsInitialState(obl_cube))
+			return false;
+		if (isBlockedSyntactically(obl_cube, obl_level))
+			continue;
+
+		vector<int> core;
+		if (isRelativeInductive(obl_cube, obl_level - 1, core))
+		{
+			bool assumed = last_query_assumed_;
+			vector<int> lemma = generalize(core, obl_level - 1, assumed);
+
+			// push the lemma as far as possible
+			unsigned lemma_level = obl_level;
+			vector<int> unused_core;
+			while (lemma_level < top_ && isRelativeInductive(lemma, lemma_level, unused_core))
+			{
+				assumed = assumed || last_query_assumed_;
+				lemma_level++;
+			}
+			addLemma(lemma, lemma_level, assumed);
+
+			if (lemma_level < top_)
+				obligations.insert(make_pair(lemma_level + 1, obl_cube));
+		}
+		else
+		{
+			vector<int> primed;
+			for (unsigned i = 0; i < obl_cube.size(); ++i)
+				primed.push_back(prime(obl_cube[i]));
+			obligations.insert(make_pair(obl_level - 1, liftModel(primed)));
+			obligations.insert(make_pair(obl_level, obl_cube));
+		}
+	}
+	return true;
+}
+
+// -------------------------------------------------------------------------------------------
+bool Ic3::isRelativeInductive(const vector<int>& cube, unsigned level, vector<int>& core)
+{
+	// -cube, only for this query
+	int act = newActivationLiteral();
+	vector<int> clause(1, -act);
+	vector<int> primed;
+	for (unsigned i = 0; i < cube.size(); ++i)
+	{
+		clause.push_back(-cube[i]);
+		primed.push_back(prime(cube[i]));
+	}
+	solver_->incAddClause(clause);
+
+	// the input assumptions are part of the core: lemmas which do not need them are kept
+	vector<int> core_assumptions(primed);
+	if (assumptions_act_ != 0)
+		core_assumptions.push_back(assumptions_act_);
+	vector<int> assumptions = getFrameAssumptions(level);
+	assumptions.push_back(act);
+	vector<int> model_or_core;
+	bool sat = solver_->incIsSatModelOrCore(core_assumptions, assumptions, model_vars_,
+			model_or_core);
+	solver_->incAddUnitClause(-act);
+	if (sat)
+	{
+		storeModel(model_or_core);
+		return false;
+	}
+
+	set<int> primed_core(model_or_core.begin(), model_or_core.end());
+	last_query_assumed_ = assumptions_act_ != 0 && primed_core.count(assumptions_act_) != 0;
+	core.clear();
+	for (unsigned i = 0; i < cube.size(); ++i)
+	{
+		if (primed_core.count(primed[i]) != 0)
+			core.push_back(cube[i]);
+	}
+
+	// the lemma must not exclude an initial state: add back a literal which does
+	if (intersectsInitialState(core))
+	{
+		for (unsigned i = 0; i < cube.size(); ++i)
+		{
+			vector<int> single(1, cube[i]);
+			if (!intersectsInitialState(single))
+			{
+				core.push_back(cube[i]);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+// -------------------------------------------------------------------------------------------
+vector<int> Ic3::generalize(const vector<int>& cube, unsigned level, bool& assumed)
+{
+	vector<int> result(cube);
+	unsigned i = 0;
+	while (i < result.size() && result.size() > 1)
+	{
+		vector<int> candidate(result);
+		candidate.erase(candidate.begin() + i);
+
+		vector<int> core;
+		if (!intersectsInitialState(candidate) && isRelativeInductive(candidate, level, core))
+		{
+			result = core;
+			assumed = last_query_assumed_;
+		}
+		else
+			i++;
+	}
+	return result;
+}
+
+// -------------------------------------------------------------------------------------------
+vector<int> Ic3::liftModel(const vector<int>& target)
+{
+	// state & inputs & -target is unsatisfiable, the core is the relevant part of the state
+	int act = newActivationLiteral();
+	vector<int> clause(1, -act);
+	for (unsigned i = 0; i < target.size(); ++i)
+		clause.push_back(-target[i]);
+	solver_->incAddClause(clause);
+
+	vector<int> assumptions(model_inputs_);
+	assumptions.push_back(act);
+	vector<int> core;
+	bool sat = solver_->incIsSatModelOrCore(model_state_, assumptions, model_vars_, core);
+	solver_->incAddUnitClause(-act);
+	MASSERT(!sat, "the state and inputs of the model do not imply the target")
+	return core;
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::addLemma(const vector<int>& cube, unsigned level, bool assumed)
+{
+	vector<int> clause(1, -frame_act_[level]);
+	for (unsigned i = 0; i < cube.size(); ++i)
+		clause.push_back(-cube[i]);
+	if (assumed)
+	{
+		clause.push_back(-assumptions_act_);
+		assumed_frames_[level].push_back(cube);
+	}
+	else
+		frames_[level].push_back(cube);
+	solver_->incAddClause(clause);
+}
+
+// -------------------------------------------------------------------------------------------
+bool Ic3::propagateLemmas()
+{
+	for (unsigned level = 1; level < top_; ++level)
+	{
+		bool all_pushed = true;
+
+		// lemmas which hold without the input assumptions
+		vector<vector<int> > lemmas;
+		lemmas.swap(frames_[level]);
+		for (unsigned c = 0; c < lemmas.size(); ++c)
+		{
+			vector<int> core;
+			if (isBlockedSyntactically(lemmas[c], level + 1))
+				frames_[level].push_back(lemmas[c]); // pushed already (under the assumptions)
+			else if (!isRelativeInductive(lemmas[c], level, core))
+			{
+				frames_[level].push_back(lemmas[c]); // its clause is still in the solver
+				all_pushed = false;
+			}
+			else
+			{
+				// a lemma pushed under the assumptions stays here for the following checks
+				if (last_query_assumed_)
+					frames_[level].push_back(lemmas[c]);
+				addLemma(core, level + 1, last_query_assumed_);
+			}
+		}
+
+		// lemmas which depend on the input assumptions
+		lemmas.clear();
+		lemmas.swap(assumed_frames_[level]);
+		for (unsigned c = 0; c < lemmas.size(); ++c)
+		{
+			vector<int> core;
+			if (isRelativeInductive(lemmas[c], level, core))
+				addLemma(core, level + 1, true);
+			else
+			{
+				assumed_frames_[level].push_back(lemmas[c]);
+				all_pushed = false;
+			}
+		}
+
+		if (all_pushed)
+			return true;
+	}
+	return false;
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::addFrame()
+{
+	top_++;
+	if (top_ < frames_.size())
+		return;
+	frames_.push_back(vector<vector<int> >());
+	assumed_frames_.push_back(vector<vector<int> >());
+	frame_act_.push_back(newActivationLiteral());
+}
+
+// -------------------------------------------------------------------------------------------
+vector<int> Ic3::getFrameAssumptions(unsigned level) const
+{
+	if (level == 0)
+		return vector<int>(1, frame_act_[0]);
+	return vector<int>(frame_act_.begin() + level, frame_act_.end());
+}
+
+// -------------------------------------------------------------------------------------------
+bool Ic3::intersectsInitialState(const vector<int>& cube) const
+{
+	for (unsigned i = 0; i < cube.size(); ++i)
+	{
+		unsigned reset = reset_values_[latch_index_.find(abs(cube[i]))->second];
+		if ((cube[i] > 0 && reset == AIG_FALSE) || (cube[i] < 0 && reset == AIG_TRUE))
+			return false;
+	}
+	return true;
+}
+
+// -------------------------------------------------------------------------------------------
+bool Ic3::isBlockedSyntactically(const vector<int>& cube, unsigned level) const
+{
+	set<int> cube_lits(cube.begin(), cube.end());
+	for (unsigned f = level; f < frames_.size(); ++f)
+	{
+		for (unsigned c = 0; c < frames_[f].size() + assumed_frames_[f].size(); ++c)
+		{
+			const vector<int>& lemma =
+					c < frames_[f].size() ? frames_[f][c] : assumed_frames_[f][c - frames_[f].size()];
+			unsigned i = 0;
+			while (i < lemma.size() && cube_lits.count(lemma[i]) != 0)
+				i++;
+			if (i == lemma.size())
+				return true;
+		}
+	}
+	return false;
+}
+
+// -------------------------------------------------------------------------------------------
+void Ic3::storeModel(const vector<int>& model)
+{
+	model_state_.assign(model.begin(), model.begin() + latch_vars_.size());
+	model_inputs_.assign(model.begin() + latch_vars_.size(), model.end());
+}
+
+// -------------------------------------------------------------------------------------------
+int Ic3::prime(int lit) const
+{
+	map<int, unsigned>::const_iterator it = latch_index_.find(abs(lit));
+	MASSERT(it != latch_index_.end(), "not a latch")
+	return lit > 0 ? next_vars_[it->second] : -next_vars_[it->second];
+}
+
+// -------------------------------------------------------------------------------------------
+int Ic3::newActivationLiteral()
+{
+	int act = next_free_cnf_var_++;
+	solver_->addVarToKeep(act);
+	return act;
+}
+
+// -------------------------------------------------------------------------------------------
+int Ic3::aigLitToCnfLit(unsigned aig_lit)
+{
+	int cnf_lit = (aig_lit >> 1) + 1;
+	return (aig_lit & 1) ? -cnf_lit : cnf_lit;
+}
+
+// -------------------------------------------------------------------------------------------
+unsigned Ic3::getNumFrames() const
+{
+	return top_;
+}
+
+// -------------------------------------------------------------------------------------------
+unsigned Ic3::getNumInductiveCandidates() const
+{
+	return num_inductive_candidates_;
+}
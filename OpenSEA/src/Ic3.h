@@ -0,0 +1,354 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) 2015 by Graz University of Technology
+//
+// This is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, see
+// <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+/// @file Ic3.h
+/// @brief Contains the declaration of the class Ic3.
+// -------------------------------------------------------------------------------------------
+
+#ifndef Ic3_H__
+#define Ic3_H__
+
+#include "defines.h"
+
+struct aiger;
+class SatSolver;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @class Ic3
+/// @brief A model checker (IC3 / PDR) for safety properties of AIGER circuits.
+///
+/// The property is given by the last output of the circuit, which signals a 'bad' state
+/// (as in the circuits created by AlarmToMC). The check tells whether a bad state is reachable
+/// from the initial state. All frames share one incremental SatSolver session, a frame is
+/// selected with an activation literal. Blocked cubes are generalized by unsatisfiable
+/// cores and by dropping literals, predecessors are lifted by unsatisfiable cores as well.
+///
+/// Candidate lemmas (e.g., equivalences between the two copies of a miter) can be passed
+/// before the check. The inductive subset of them is computed first and holds in all
+/// frames, which typically saves many blocking steps.
+///
+/// Several checks can be done in the same session, each under different assumptions on the
+/// inputs (e.g., selecting the flipped latch of a miter). Lemmas which were derived without
+/// the assumptions (according to the unsatisfiable cores) are kept for the following checks,
+/// the others are dropped when the assumptions change.
+///
+/// @author Patrick Klampfl
+/// @version 1.2.0
+class Ic3
+{
+public:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the result of a check
+  enum Result
+  {
+    SAFE = 0,
+    UNSAFE = 1,
+    UNKNOWN = 2
+  };
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Constructor.
+///
+/// @param circuit the circuit to check. The last output is the bad signal.
+/// @param solver the solver to use. It is not deleted by this class.
+  Ic3(aiger* circuit, SatSolver* solver);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Destructor.
+  virtual ~Ic3();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief restricts an input to a constant value in every time step
+///
+/// Must be called before check().
+///
+/// @param input_lit the aiger literal of the input.
+/// @param value the value of the input.
+  void constrainInput(unsigned input_lit, bool value);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief sets inputs which are assumed to be true in every step of the following checks
+///
+/// Lemmas of previous checks which depend on the previous assumptions are dropped.
+///
+/// @param input_lits aiger literals of inputs, empty for no assumptions.
+  void setInputAssumptions(const vector<unsigned>& input_lits);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds a candidate lemma, which is used if it turns out to be inductive
+///
+/// Must be called before check().
+///
+/// @param clause a clause of aiger literals over latches.
+  void addCandidateLemma(const vector<unsigned>& clause);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks if a bad state is reachable
+///
+/// Can be called repeatedly, the frames and lemmas of previous checks are reused.
+///
+/// @param max_frames gives up (UNKNOWN) when more frames are needed, 0 means no limit.
+/// @return SAFE if no bad state is reachable, UNSAFE if one is reachable.
+  Result check(unsigned max_frames = 0);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the number of frames of the last check
+///
+/// @return the index of the top frame.
+  unsigned getNumFrames() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the number of candidate lemmas that turned out to be inductive
+///
+/// @return the number of candidate lemmas used as invariants.
+  unsigned getNumInductiveCandidates() const;
+
+protected:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief encodes the transition relation, the initial state and the bad signal
+  void encode();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief keeps the inductive subset of the candidate lemmas (Houdini) as invariants
+  void addInductiveCandidates();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief blocks a cube in the given frame, recursively blocking its predecessors
+///
+/// @param cube the cube (CNF literals over the current-state variables) to block.
+/// @param level the frame in which the cube must be blocked.
+/// @return false if the cube is reachable from the initial state (counterexample).
+  bool blockCube(const vector<int>& cube, unsigned level);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks if a cube is inductive relative to a frame: F_level & -cube & T & cube'
+///
+/// If the cube is not relatively inductive, the model is stored for liftModel(). Otherwise,
+/// last_query_assumed_ tells if the input assumptions were needed.
+///
+/// @param cube the cube over the current-state variables.
+/// @param level the frame.
+/// @param core a sub-cube which is still relatively inductive and does not intersect the
+///        initial state (only if the result is true).
+/// @return true if the cube is inductive relative to the frame.
+  bool isRelativeInductive(const vector<int>& cube, unsigned level, vector<int>& core);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief generalizes a relatively inductive cube by dropping literals
+///
+/// @param cube the cube, which is inductive relative to frame level.
+/// @param level the frame.
+/// @param assumed true if the input assumptions were needed for the cube, will be updated
+///        for the generalized cube.
+/// @return the generalized cube.
+  vector<int> generalize(const vector<int>& cube, unsigned level, bool& assumed);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief reduces the state of the last model to the latches which imply the target
+///
+/// @param target the literals (over the next-state or the bad signal) the state implies.
+/// @return the lifted state cube.
+  vector<int> liftModel(const vector<int>& target);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief adds the clause -cube to all frames up to the given one
+///
+/// @param cube the cube to block.
+/// @param level the highest frame in which the lemma holds.
+/// @param assumed true if the lemma only holds under the current input assumptions.
+  void addLemma(const vector<int>& cube, unsigned level, bool assumed);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief pushes lemmas to the next frame if possible
+///
+/// @return true if two frames became equal, i.e., an inductive invariant was found.
+  bool propagateLemmas();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief moves the top frame one level up (adds a new frame if necessary)
+  void addFrame();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the activation literals selecting frame 'level' (lemmas of all frames >=
+/// level, or the initial state for level 0)
+  vector<int> getFrameAssumptions(unsigned level) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns true if the cube contains an initial state
+  bool intersectsInitialState(const vector<int>& cube) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns true if a lemma of frame level or above already blocks the cube
+  bool isBlockedSyntactically(const vector<int>& cube, unsigned level) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief splits a model over model_vars_ into model_state_ and model_inputs_
+  void storeModel(const vector<int>& model);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the next-state literal of a current-state literal
+  int prime(int lit) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns a fresh activation literal
+  int newActivationLiteral();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief converts an aiger literal to a CNF literal (current-state copy)
+  static int aigLitToCnfLit(unsigned aig_lit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the circuit to check
+  aiger* circuit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the solver holding the transition relation and all frames
+  SatSolver* solver_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the CNF variables of the latches, their next-state variables and the inputs
+  vector<int> latch_vars_;
+  vector<int> next_vars_;
+  vector<int> input_vars_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief maps CNF variables of latches to their index in circuit->latches
+  map<int, unsigned> latch_index_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the initial value of each latch: AIG_FALSE, AIG_TRUE or another value if the latch
+/// is uninitialized
+  vector<unsigned> reset_values_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the CNF literal of the bad signal
+  int bad_lit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the lemmas (blocked cubes) per frame. A lemma of frame i holds in the frames 1..i.
+  vector<vector<vector<int> > > frames_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the lemmas per frame which depend on the current input assumptions
+  vector<vector<vector<int> > > assumed_frames_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the top frame of the current check (frames above it are left from previous checks)
+  unsigned top_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the literal enabling the current input assumptions, 0 if there are none
+  int assumptions_act_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief true if the last relative induction query needed the input assumptions
+  bool last_query_assumed_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the activation literal of each frame. The one of frame 0 enables the initial state.
+  vector<int> frame_act_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the candidate lemmas (clauses of CNF literals)
+  vector<vector<int> > candidates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the number of candidate lemmas which turned out to be inductive
+  unsigned num_inductive_candidates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the variables a model is extracted for (latches first, inputs afterwards), and the
+/// state and input values of the last satisfiable query
+  vector<int> model_vars_;
+  vector<int> model_state_;
+  vector<int> model_inputs_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the next free CNF variable
+  int next_free_cnf_var_;
+
+private:
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Copy constructor.
+///
+/// The copy constructor is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+  Ic3(const Ic3 &other);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Assignment operator.
+///
+/// The assignment operator is disabled (set private) and not implemented.
+///
+/// @param other The source for creating the copy.
+/// @return The result of the assignment, i.e, *this.
+  Ic3& operator=(const Ic3 &other);
+
+};
+
+#endif // Ic3_H__
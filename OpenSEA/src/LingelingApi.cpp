@@ -254,11 +254,30 @@ void LingelingApi::incAddNegCubeAsClause(const vector<int> &cube)
   lgladd(lgl, 0);
 }
 
+// -------------------------------------------------------------------------------------------
+/// @brief Calls lglsat(), but gives up after conflict_limit conflicts.
+///
+/// @param lgl The solver instance to use.
+/// @param conflict_limit The maximum number of conflicts. A negative number means no limit.
+/// @return The result of lglsat() (LGL_UNKNOWN if the limit has been reached).
+static int satWithBudget(LGL *lgl, long conflict_limit)
+{
+  if(conflict_limit < 0)
+    return lglsat(lgl);
+  lglsetopt(lgl, "clim", static_cast<int>(conflict_limit));
+  int res = lglsat(lgl);
+  lglsetopt(lgl, "clim", -1);
+  return res;
+}
+
 // -------------------------------------------------------------------------------------------
 bool LingelingApi::incIsSat()
 {
   MASSERT(!incr_stack_.empty() && incr_stack_.back() != NULL, "No open session.");
-  int res = lglsat(incr_stack_.back());
+  int res = satWithBudget(incr_stack_.back(), conflict_limit_);
+  last_result_unknown_ = (res == LGL_UNKNOWN && conflict_limit_ >= 0);
+  if(last_result_unknown_)
+    return false;
   if(res == LGL_SATISFIABLE)
     return true;
   else if(res == LGL_UNSATISFIABLE)
@@ -274,7 +293,10 @@ bool LingelingApi::incIsSat(const vector<int> &assumptions)
   LGL *lgl = incr_stack_.back();
   for(size_t ass_cnt = 0; ass_cnt < assumptions.size(); ++ass_cnt)
     lglassume(lgl, assumptions[ass_cnt]);
-  int res = lglsat(lgl);
+  int res = satWithBudget(lgl, conflict_limit_);
+  last_result_unknown_ = (res == LGL_UNKNOWN && conflict_limit_ >= 0);
+  if(last_result_unknown_)
+    return false;
   if(res == LGL_SATISFIABLE)
     return true;
   else if(res == LGL_UNSATISFIABLE)
@@ -292,7 +314,13 @@ bool LingelingApi::incIsSatModelOrCore(const vector<int> &assumptions,
   LGL *lgl = incr_stack_.back();
   for(size_t ass_cnt = 0; ass_cnt < assumptions.size(); ++ass_cnt)
     lglassume(lgl, assumptions[ass_cnt]);
-  int res = lglsat(lgl);
+  int res = satWithBudget(lgl, conflict_limit_);
+  last_result_unknown_ = (res == LGL_UNKNOWN && conflict_limit_ >= 0);
+  if(last_result_unknown_)
+  {
+    model_or_core.clear();
+    return false;
+  }
   if(res == LGL_SATISFIABLE)
   {
     model_or_core.clear();
@@ -368,7 +396,13 @@ bool LingelingApi::incIsSatModelOrCore(const vector<int> &core_assumptions,
     lglassume(lgl, core_assumptions[ass_cnt]);
   for(size_t ass_cnt = 0; ass_cnt < more_assumptions.size(); ++ass_cnt)
     lglassume(lgl, more_assumptions[ass_cnt]);
-  int res = lglsat(lgl);
+  int res = satWithBudget(lgl, conflict_limit_);
+  last_result_unknown_ = (res == LGL_UNKNOWN && conflict_limit_ >= 0);
+  if(last_result_unknown_)
+  {
+    model_or_core.clear();
+    return false;
+  }
   if(res == LGL_SATISFIABLE)
   {
     model_or_core.clear();
@@ -324,11 +324,33 @@ void MiniSatApi::incAddNegCubeAsClause(const vector<int> &cube)
   solver->addClause(m_clause);
 }
 
+// -------------------------------------------------------------------------------------------
+/// @brief Solves under assumptions, but gives up after conflict_limit conflicts.
+///
+/// @param solver The solver instance to use.
+/// @param ass The assumptions.
+/// @param conflict_limit The maximum number of conflicts. A negative number means no limit.
+/// @param unknown Set to true if the solver gave up because of the limit.
+/// @return True in case of satisfiability, false otherwise (or if unknown).
+static bool solveWithBudget(Solver &solver, const vec<Lit> &ass, long conflict_limit,
+                            bool &unknown)
+{
+  unknown = false;
+  if(conflict_limit < 0)
+    return solver.solve(ass);
+  solver.setConfBudget(conflict_limit);
+  lbool res = solver.solveLimited(ass);
+  solver.budgetOff();
+  unknown = (res == l_Undef);
+  return (res == l_True);
+}
+
 // -------------------------------------------------------------------------------------------
 bool MiniSatApi::incIsSat()
 {
   DASSERT(!incr_stack_.empty() && incr_stack_.back() != NULL, "No open session.");
-  return incr_stack_.back()->solve();
+  vec<Lit> no_ass;
+  return solveWithBudget(*incr_stack_.back(), no_ass, conflict_limit_, last_result_unknown_);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -339,7 +361,7 @@ bool MiniSatApi::incIsSat(const vector<int> &assumptions)
   vec<Lit> ass(assumptions.size());
   for(size_t ass_cnt = 0; ass_cnt < assumptions.size(); ++ass_cnt)
     ass[ass_cnt] = c2m(*solver, assumptions[ass_cnt]);
-  return solver->solve(ass);
+  return solveWithBudget(*solver, ass, conflict_limit_, last_result_unknown_);
 }
 
 // -------------------------------------------------------------------------------------------
@@ -352,7 +374,12 @@ bool MiniSatApi::incIsSatModelOrCore(const vector<int> &assumptions,
   vec<Lit> ass(assumptions.size());
   for(size_t ass_cnt = 0; ass_cnt < assumptions.size(); ++ass_cnt)
     ass[ass_cnt] = c2m(*solver, assumptions[ass_cnt]);
-  bool sat = solver->solve(ass);
+  bool sat = solveWithBudget(*solver, ass, conflict_limit_, last_result_unknown_);
+  if(last_result_unknown_)
+  {
+    model_or_core.clear();
+    return false;
+  }
   if(sat)
   {
     model_or_core.clear();
@@ -413,7 +440,12 @@ bool MiniSatApi::incIsSatModelOrCore(const vector<int> &core_assumptions,
     ass[ass_cnt] = c2m(*solver, more_assumptions[ass_cnt]);
   for(size_t ass_cnt = 0; ass_cnt < core_assumptions.size(); ++ass_cnt)
     ass[ass_cnt + more_assumptions.size()] = c2m(*solver, core_assumptions[ass_cnt]);
-  bool sat = solver->solve(ass);
+  bool sat = solveWithBudget(*solver, ass, conflict_limit_, last_result_unknown_);
+  if(last_result_unknown_)
+  {
+    model_or_core.clear();
+    return false;
+  }
   if(sat)
   {
     model_or_core.clear();
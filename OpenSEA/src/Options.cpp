@@ -35,6 +35,7 @@
 #include "FalsePositives.h"
 #include "BddAnalysis.h"
 #include "DefinitelyProtected.h"
+#include "FaultCollapsing.h"
 #include "Utils.h"
 
 #include <sys/stat.h>
@@ -353,6 +354,118 @@ bool Options::parse(int argc, char **argv)
 			}
 			latches_to_exclude_file_path_ = string(argv[arg_count]);
 		}
+		else if (arg == "--collapse")
+		{
+			fault_collapsing_mode_ = 1;
+		}
+		else if (arg == "--collapse=nosat")
+		{
+			fault_collapsing_mode_ = 2;
+		}
+		else if (arg == "--schedule")
+		{
+			schedule_latches_ = true;
+		}
+		else if (arg.find("--latch_timeout=") == 0)
+		{
+			istringstream iss(arg.substr(16, string::npos));
+			iss >> latch_timeout_;
+		}
+		else if (arg.find("--timeout=") == 0)
+		{
+			istringstream iss(arg.substr(10, string::npos));
+			iss >> global_timeout_;
+		}
+		else if (arg.find("--conflict_limit=") == 0)
+		{
+			istringstream iss(arg.substr(17, string::npos));
+			iss >> conflict_limit_;
+		}
+		else if (arg.find("--journal=") == 0)
+		{
+			journal_path_ = arg.substr(10, string::npos);
+		}
+		else if (arg == "--resume")
+		{
+			resume_ = true;
+		}
+		else if (arg.find("--bdd_order=") == 0)
+		{
+			istringstream iss(arg.substr(12, string::npos));
+			iss >> bdd_variable_order_;
+		}
+		else if (arg.find("--bdd_max_mem=") == 0)
+		{
+			istringstream iss(arg.substr(14, string::npos));
+			iss >> bdd_max_memory_;
+		}
+		else if (arg.find("--bdd_max_nodes=") == 0)
+		{
+			istringstream iss(arg.substr(16, string::npos));
+			iss >> bdd_max_nodes_;
+		}
+		else if (arg.find("--bdd_reorder_at=") == 0)
+		{
+			istringstream iss(arg.substr(17, string::npos));
+			iss >> bdd_reorder_threshold_;
+		}
+		else if (arg.find("--bdd_partitions=") == 0)
+		{
+			istringstream iss(arg.substr(17, string::npos));
+			iss >> bdd_partitions_;
+		}
+		else if (arg.find("--bdd_stats=") == 0)
+		{
+			bdd_stats_path_ = arg.substr(12, string::npos);
+		}
+		else if (arg.find("--bdd_unique_slots=") == 0)
+		{
+			istringstream iss(arg.substr(19, string::npos));
+			iss >> bdd_unique_slots_;
+		}
+		else if (arg.find("--bdd_cache_slots=") == 0)
+		{
+			istringstream iss(arg.substr(18, string::npos));
+			iss >> bdd_cache_slots_;
+		}
+		else if (arg.find("--hybrid_nodes=") == 0)
+		{
+			istringstream iss(arg.substr(15, string::npos));
+			iss >> hybrid_node_limit_;
+		}
+		else if (arg == "--dp_reach")
+		{
+			dp_reachability_ = true;
+		}
+		else if (arg.find("--dp_reach=") == 0)
+		{
+			dp_reachability_ = true;
+			istringstream iss(arg.substr(11, string::npos));
+			iss >> dp_reachability_max_nodes_;
+		}
+		else if (arg == "--dp_no_sharing")
+		{
+			dp_share_gates_ = false;
+		}
+		else if (arg.find("--kind_max=") == 0)
+		{
+			istringstream iss(arg.substr(11, string::npos));
+			iss >> k_induction_max_depth_;
+		}
+		else if (arg.find("--dp_threads=") == 0)
+		{
+			istringstream iss(arg.substr(13, string::npos));
+			iss >> dp_threads_;
+			if (dp_threads_ == 0)
+				dp_threads_ = 1;
+		}
+		else if (arg.find("--fp_threads=") == 0)
+		{
+			istringstream iss(arg.substr(13, string::npos));
+			iss >> fp_threads_;
+			if (fp_threads_ == 0)
+				fp_threads_ = 1;
+		}
 		else if (arg == "-k")
 		{
 			if (arg_count + 2 >= argc)
@@ -375,6 +488,18 @@ bool Options::parse(int argc, char **argv)
 		return true;
 	}
 
+	if (resume_ && journal_path_ == "")
+	{
+		cerr << "Option --resume requires a journal (--journal=FILE)." << endl;
+		return true;
+	}
+
+	if (resume_ && testcase_mode_ == TC_RANDOM && seed_ == 0)
+	{
+		cerr << "Option --resume with random test-cases requires a fixed --seed." << endl;
+		return true;
+	}
+
 	if (latches_to_exclude_file_path_ != "")
 	{
 		ifstream infile(latches_to_exclude_file_path_.c_str());
@@ -627,12 +752,125 @@ void Options::printHelp() const
 	cout << "                      to leave some or all values in the given TestCase" << endl;
 	cout << "                      open (write '?' instead of '0' or '1')" << endl;
 	cout << "                 Back-end 'bdd': " << endl;
+	cout << "                   0: one-hot encoded latch selection (c) signals" << endl;
+	cout << "                   1: as 0, but with cardinality constraints for c" << endl;
+	cout << "                   2: binary encoded c signals, one f var per step" << endl;
+	cout << "                   3: binary encoded c signals and flip time-step (f)," << endl;
+	cout << "                      the number of BDD variables does not grow with" << endl;
+	cout << "                      the length of the test-cases" << endl;
+	cout << "                   4: as 3, but allows to leave some or all values in" << endl;
+	cout << "                      the given TestCase open (write '?')" << endl;
+	cout << "                   5: hybrid: as 3, but a test-case is continued with" << endl;
+	cout << "                      the SAT solver once the BDDs exceed --hybrid_nodes" << endl;
 	cout << "                 Back-end 'dp': " << endl;
+	cout << "                   0: 1-step analysis (deprecated)" << endl;
+	cout << "                   1: 1-step analysis, one latch at a time" << endl;
+	cout << "                   2: 1-step analysis, all latches simultaneously" << endl;
+	cout << "                   3: k-step analysis, one latch at a time (see -k)" << endl;
+	cout << "                   4: k-step analysis, all latches simultaneously" << endl;
+	cout << "                   5: unbounded proof with k-induction (see --kind_max)" << endl;
 	cout << "                 The default is 0." << endl;
+	cout << "  --bdd_order=N" << endl;
+	cout << "                 The static BDD variable order of the 'bdd' back-end:" << endl;
+	cout << "                   0: order of creation (default)" << endl;
+	cout << "                   1: latches ordered by a depth-first search over the" << endl;
+	cout << "                      fan-in of the outputs (c vars of related latches" << endl;
+	cout << "                      are close)" << endl;
+	cout << "                   2: as 1, and the flip time-step vars on top of the" << endl;
+	cout << "                      c vars (modes 3 and 4 only)" << endl;
+	cout << "  --bdd_max_mem=MB" << endl;
+	cout << "                 Limits the memory of the BDD manager of the 'bdd'" << endl;
+	cout << "                 back-end. If a limit is exceeded, the remaining" << endl;
+	cout << "                 test-cases are analyzed with the 'stla' back-end." << endl;
+	cout << "  --bdd_max_nodes=N" << endl;
+	cout << "                 Limits the number of live BDD nodes (see --bdd_max_mem)." << endl;
+	cout << "  --bdd_reorder_at=N" << endl;
+	cout << "                 Enables dynamic reordering (sifting) of the BDD" << endl;
+	cout << "                 variables, the first time when N nodes are reached." << endl;
+	cout << "  --bdd_partitions=K" << endl;
+	cout << "                 Splits the latches into K groups, which the 'bdd'" << endl;
+	cout << "                 back-end analyzes in parallel, each with its own" << endl;
+	cout << "                 BDD manager. The default is 1." << endl;
+	cout << "  --hybrid_nodes=N" << endl;
+	cout << "                 The number of live BDD nodes at which the hybrid mode" << endl;
+	cout << "                 (-b bdd -m 5) switches to SAT. The default is 100000." << endl;
+	cout << "  --bdd_stats=FILE" << endl;
+	cout << "                 Writes statistics of the 'bdd' back-end to FILE, one" << endl;
+	cout << "                 'key value' pair per line: CPU time, garbage collections," << endl;
+	cout << "                 reordering time and cache hits per phase, and peak" << endl;
+	cout << "                 (live) nodes and table sizes of the CUDD manager (summed" << endl;
+	cout << "                 over all managers with --bdd_partitions)." << endl;
+	cout << "  --bdd_unique_slots=N, --bdd_cache_slots=N" << endl;
+	cout << "                 The initial sizes of the unique table (per variable) and" << endl;
+	cout << "                 of the computed table of the CUDD manager." << endl;
+	cout << "                 The defaults are 256 and 262144." << endl;
+	cout << "  --dp_reach, --dp_reach=N" << endl;
+	cout << "                 The 'dp' back-end computes the reachable states with" << endl;
+	cout << "                 BDDs and restricts the initial state of its SAT checks" << endl;
+	cout << "                 to them. With '=N', the set of reachable states is" << endl;
+	cout << "                 over-approximated whenever its BDD exceeds N nodes." << endl;
+	cout << "  --dp_no_sharing" << endl;
+	cout << "                 The k-step and k-induction modes of the 'dp' back-end" << endl;
+	cout << "                 (-b dp -m 3/5) build the faulty copy without sharing the" << endl;
+	cout << "                 AND gates which do not differ from the fault-free copy." << endl;
+	cout << "                 Slower, for cross-checking the sharing." << endl;
+	cout << "  --kind_max=N" << endl;
+	cout << "                 The largest k tried by the k-induction mode of the 'dp'" << endl;
+	cout << "                 back-end (-b dp -m 5). Latches which are neither proven" << endl;
+	cout << "                 nor refuted up to N are 'unknown'. The default is 20." << endl;
+	cout << "  --dp_threads=N" << endl;
+	cout << "                 The 'dp' back-end (-b dp -m 1) checks the latches with N" << endl;
+	cout << "                 threads. The initial transition relation is built only" << endl;
+	cout << "                 once and loaded into one SAT solver per thread." << endl;
+	cout << "                 The default is 1." << endl;
+	cout << "  --fp_threads=N" << endl;
+	cout << "                 The 'fp' and 'fps' back-ends split the latches into small" << endl;
+	cout << "                 groups, which N threads analyze with their own SAT solvers." << endl;
+	cout << "                 The results are merged in the order of the groups." << endl;
+	cout << "                 The default is 1." << endl;
 	cout << "  -e FILE, --exclude=FILE" << endl;
 	cout << "                 excludes the latches listed in FILE from the analysis." << endl;
 	cout << "  -r FILE, --results=FILE" << endl;
 	cout << "                 stores the latches detected by the algorithm to FILE." << endl;
+	cout << "  --collapse, --collapse=nosat" << endl;
+	cout << "                 Groups latches with equivalent bit-flips (same outputs" << endl;
+	cout << "                 and next state) into classes, analyzes only one latch" << endl;
+	cout << "                 per class and copies the result to the other members." << endl;
+	cout << "                 Candidates are found with structural and simulation" << endl;
+	cout << "                 signatures and confirmed by a SAT-solver call, unless" << endl;
+	cout << "                 '=nosat' is given (faster, but not guaranteed sound)." << endl;
+	cout << "  --schedule" << endl;
+	cout << "                 Analyzes the latches in the order of their estimated" << endl;
+	cout << "                 difficulty (size of their cone of influence), easiest" << endl;
+	cout << "                 first. Useful together with the budgets below." << endl;
+	cout << "  --latch_timeout=SEC" << endl;
+	cout << "                 Gives up on a latch after SEC seconds of CPU time and" << endl;
+	cout << "                 reports it as 'unknown'. Supported by 'sta', 'dp' and" << endl;
+	cout << "                 'fp' (modes 0 and 2). The other modes flip all latches" << endl;
+	cout << "                 at once and have no per-latch work to limit." << endl;
+	cout << "  --timeout=SEC" << endl;
+	cout << "                 Stops the analysis after SEC seconds (real time). All" << endl;
+	cout << "                 latches that are not finished are reported as 'unknown'." << endl;
+	cout << "                 Supported by all back-ends ('bdd' checks it between" << endl;
+	cout << "                 test-cases)." << endl;
+	cout << "  --conflict_limit=N" << endl;
+	cout << "                 Gives up on a latch if a single SAT-solver call needs more" << endl;
+	cout << "                 than N conflicts (PicoSat: decisions). If all latches are" << endl;
+	cout << "                 flipped at once ('stla', 'fp' modes 1 and 3, the SAT part" << endl;
+	cout << "                 of 'bdd' mode 5), the rest of the test-case is skipped and" << endl;
+	cout << "                 all undetected latches are reported as 'unknown'." << endl;
+	cout << "                 The 'unknown' latches are written to the results FILE" << endl;
+	cout << "                 with the suffix '.unknown'." << endl;
+	cout << "  --journal=FILE" << endl;
+	cout << "                 Records completed latch/test-case pairs and detected" << endl;
+	cout << "                 latches in FILE while the analysis is running." << endl;
+	cout << "                 Supported by 'sta', 'stla' and 'fp'." << endl;
+	cout << "  --resume" << endl;
+	cout << "                 Continues the run recorded in the --journal FILE and" << endl;
+	cout << "                 skips all completed work. Journals of several shards" << endl;
+	cout << "                 (e.g. with different --exclude lists) can be merged by" << endl;
+	cout << "                 concatenating the files. The circuit, the test-cases" << endl;
+	cout << "                 and the --seed must be the same as in the recorded run." << endl;
 	cout << "  -p PRINT, --print=PRINT" << endl;
 	cout << "                 A string indicating which messages to print. Every" << endl;
 	cout << "                 character activates a certain type of message. The" << endl;
@@ -740,7 +978,7 @@ Options::Options() :
 				"ERWIL"), tmp_dir_("./tmp"), back_end_("sim"), back_end_instance_(0), mode_(0), sat_solver_(
 				"min_api"), tool_started_(Stopwatch::start()), circuit_(0), env_model_(0), num_err_latches_(
 				0), seed_(0), unsat_core_interval_(0), use_diagnostic_output_(false), diagnostic_output_to_file_(
-				false), diagnostic_output_path_(""), use_latches_result_(false), latches_result_path_(""), latches_to_exclude_file_path_("")
+				false), diagnostic_output_path_(""), use_latches_result_(false), latches_result_path_(""), latches_to_exclude_file_path_(""), fault_collapsing_mode_(0), fault_collapsing_(0), schedule_latches_(false), latch_timeout_(0), global_timeout_(0), conflict_limit_(-1), journal_path_(""), resume_(false), bdd_variable_order_(0), bdd_max_memory_(0), bdd_max_nodes_(0), bdd_reorder_threshold_(0), bdd_partitions_(1), dp_reachability_(false), dp_reachability_max_nodes_(0), dp_share_gates_(true), k_induction_max_depth_(20), dp_threads_(1), fp_threads_(1), bdd_stats_path_(""), bdd_unique_slots_(256), bdd_cache_slots_(262144), hybrid_node_limit_(100000)
 {
 	// nothing to be done
 }
@@ -756,9 +994,200 @@ vector<unsigned> Options::removeExcludedLatches(aiger* circuit, unsigned num_err
 		if (latches_to_exclude_.find(latch) == latches_to_exclude_.end())
 			result.push_back(latch);
 	}
+
+	if (fault_collapsing_mode_ != 0 && circuit == circuit_)
+	{
+		if (fault_collapsing_ == 0 || fault_collapsing_latches_ != result)
+		{
+			delete fault_collapsing_;
+			fault_collapsing_ = new FaultCollapsing(circuit, fault_collapsing_mode_ == 1);
+			fault_collapsing_->computeClasses(result);
+			fault_collapsing_latches_ = result;
+		}
+		return fault_collapsing_->getRepresentatives();
+	}
 	return result;
 }
 
+// -------------------------------------------------------------------------------------------
+FaultCollapsing* Options::getFaultCollapsing() const
+{
+	return fault_collapsing_;
+}
+
+// -------------------------------------------------------------------------------------------
+void Options::setFaultCollapsing(aiger* circuit, int mode)
+{
+	circuit_ = circuit;
+	fault_collapsing_mode_ = mode;
+	delete fault_collapsing_; // the classes of another circuit
+	fault_collapsing_ = 0;
+	fault_collapsing_latches_.clear();
+}
+
+bool Options::isScheduleLatches() const
+{
+	return schedule_latches_;
+}
+
+double Options::getLatchTimeout() const
+{
+	return latch_timeout_;
+}
+
+double Options::getGlobalTimeout() const
+{
+	return global_timeout_;
+}
+
+long Options::getConflictLimit() const
+{
+	return conflict_limit_;
+}
+
+const string& Options::getJournalPath() const
+{
+	return journal_path_;
+}
+
+bool Options::isResume() const
+{
+	return resume_;
+}
+
+// -------------------------------------------------------------------------------------------
+/// @brief adds a value to a 64-bit FNV-1a hash (byte by byte)
+static void hashValue(uint64_t& hash, unsigned value)
+{
+	for (unsigned byte = 0; byte < 4; ++byte)
+	{
+		hash ^= (value >> (8 * byte)) & 0xFF;
+		hash *= 1099511628211ULL;
+	}
+}
+
+string Options::getInputFingerprint(aiger* circuit) const
+{
+	// the structure of the circuit (the file name alone does not identify it)
+	uint64_t circuit_hash = 14695981039346656037ULL;
+	hashValue(circuit_hash, circuit->maxvar);
+	hashValue(circuit_hash, circuit->num_inputs);
+	for (unsigned cnt = 0; cnt < circuit->num_latches; ++cnt)
+	{
+		hashValue(circuit_hash, circuit->latches[cnt].lit);
+		hashValue(circuit_hash, circuit->latches[cnt].next);
+		hashValue(circuit_hash, circuit->latches[cnt].reset);
+	}
+	for (unsigned cnt = 0; cnt < circuit->num_ands; ++cnt)
+	{
+		hashValue(circuit_hash, circuit->ands[cnt].lhs);
+		hashValue(circuit_hash, circuit->ands[cnt].rhs0);
+		hashValue(circuit_hash, circuit->ands[cnt].rhs1);
+	}
+	for (unsigned cnt = 0; cnt < circuit->num_outputs; ++cnt)
+		hashValue(circuit_hash, circuit->outputs[cnt].lit);
+
+	ostringstream fingerprint;
+	fingerprint << "circuit=" << hex << circuit_hash << dec;
+	if (testcase_mode_ == TC_FILES)
+	{
+		uint64_t tc_hash = 14695981039346656037ULL;
+		for (unsigned cnt = 0; cnt < paths_to_testcases_.size(); ++cnt)
+		{
+			ifstream tc_file(paths_to_testcases_[cnt].c_str());
+			char c;
+			while (tc_file.get(c))
+				hashValue(tc_hash, static_cast<unsigned char>(c));
+			hashValue(tc_hash, 0); // separates the files
+		}
+		fingerprint << " tc=files:" << hex << tc_hash << dec;
+	}
+	else if (testcase_mode_ == TC_RANDOM)
+	{
+		fingerprint << " tc=random:" << num_testcases_ << "x" << len_rand_testcases_ << "x"
+				<< num_open_inputs_;
+	}
+	else if (testcase_mode_ == TC_MC)
+		fingerprint << " tc=mc:" << len_rand_testcases_;
+	fingerprint << " seed=" << seed_;
+	return fingerprint.str();
+}
+
+int Options::getBddVariableOrder() const
+{
+	return bdd_variable_order_;
+}
+
+unsigned long Options::getBddMaxMemory() const
+{
+	return bdd_max_memory_;
+}
+
+unsigned Options::getBddMaxNodes() const
+{
+	return bdd_max_nodes_;
+}
+
+unsigned Options::getBddReorderThreshold() const
+{
+	return bdd_reorder_threshold_;
+}
+
+unsigned Options::getBddPartitions() const
+{
+	return bdd_partitions_;
+}
+
+bool Options::isDpReachability() const
+{
+	return dp_reachability_;
+}
+
+unsigned Options::getDpReachabilityMaxNodes() const
+{
+	return dp_reachability_max_nodes_;
+}
+
+bool Options::isDpShareGates() const
+{
+	return dp_share_gates_;
+}
+
+unsigned Options::getKInductionMaxDepth() const
+{
+	return k_induction_max_depth_;
+}
+
+unsigned Options::getDpThreads() const
+{
+	return dp_threads_;
+}
+
+unsigned Options::getFpThreads() const
+{
+	return fp_threads_;
+}
+
+const string& Options::getBddStatsPath() const
+{
+	return bdd_stats_path_;
+}
+
+unsigned Options::getBddUniqueSlots() const
+{
+	return bdd_unique_slots_;
+}
+
+unsigned Options::getBddCacheSlots() const
+{
+	return bdd_cache_slots_;
+}
+
+unsigned Options::getHybridNodeLimit() const
+{
+	return hybrid_node_limit_;
+}
+
 // -------------------------------------------------------------------------------------------
 Options::~Options()
 {
@@ -766,6 +1195,7 @@ Options::~Options()
 	{
 		delete back_end_instance_;
 	}
+	delete fault_collapsing_;
 }
 
 unsigned Options::getNumErrLatches() const
@@ -29,6 +29,7 @@
 
 class SatSolver;
 class BackEnd;
+class FaultCollapsing;
 
 typedef pair<clock_t, time_t> PointInTime;
 
@@ -226,6 +227,11 @@ class Options
 		return use_diagnostic_output_;
 	}
 
+	void setUseDiagnosticOutput(bool useDiagnosticOutput)
+	{
+		use_diagnostic_output_ = useDiagnosticOutput;
+	}
+
 	aiger* getCircuit();
 
 	const string& getDiagnosticOutputPath() const
@@ -248,6 +254,279 @@ class Options
 	bool isUseLatchesResult() const;
 
 	vector<unsigned> removeExcludedLatches(aiger* circuit, unsigned num_err_latches = 0);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the fault collapsing of the input circuit (if enabled with --collapse)
+///
+/// @return the FaultCollapsing instance used by removeExcludedLatches(), or 0 if disabled
+	FaultCollapsing* getFaultCollapsing() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Enables fault collapsing for a circuit, like --collapse for the input circuit.
+///
+/// removeExcludedLatches() only collapses the input circuit, so the circuit replaces it.
+///
+/// @param circuit the circuit whose latches are collapsed.
+/// @param mode 0 disables fault collapsing, 1 confirms the classes with SAT, 2 does not.
+	void setFaultCollapsing(aiger* circuit, int mode);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if the latches should be analyzed ordered by estimated difficulty.
+///
+/// @return true if --schedule was given.
+	bool isScheduleLatches() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the CPU time budget per latch in seconds (0 = no limit).
+///
+/// @return the value of --latch_timeout.
+	double getLatchTimeout() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the real time budget of the whole analysis in seconds (0 = no limit).
+///
+/// @return the value of --timeout.
+	double getGlobalTimeout() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the conflict limit per SAT-solver call (negative = no limit).
+///
+/// @return the value of --conflict_limit.
+	long getConflictLimit() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the file name of the checkpoint journal ("" = no journal).
+///
+/// @return the value of --journal.
+	const string& getJournalPath() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if the run recorded in the journal should be continued.
+///
+/// @return true if --resume was given.
+	bool isResume() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets the checkpoint journal, like --journal=FILE and --resume.
+///
+/// @param path the file name of the journal ("" = no journal).
+/// @param resume true if the run recorded in the journal should be continued.
+	void setJournal(const string& path, bool resume)
+	{
+		journal_path_ = path;
+		resume_ = resume;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets the latches which are not analyzed, like --exclude.
+///
+/// @param latches the latch literals.
+	void setLatchesToExclude(const set<unsigned>& latches)
+	{
+		latches_to_exclude_ = latches;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns a fingerprint of everything the result of a run depends on.
+///
+/// The fingerprint contains a hash of the circuit structure, the test-case source (a hash of
+/// the contents of the -tc files, or the parameters of -tcr/-mc) and the seed. It is written
+/// to the header of the journal, so --resume rejects a journal of a different run. The
+/// --exclude list is not part of it: the journal records each latch separately.
+///
+/// @param circuit the circuit to analyze.
+/// @return the fingerprint as a single line of text.
+	string getInputFingerprint(aiger* circuit) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the static BDD variable order heuristic (see BddVariableOrder::Heuristic).
+///
+/// @return the value of --bdd_order.
+	int getBddVariableOrder() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets the static BDD variable order heuristic, like --bdd_order=N.
+///
+/// @param heuristic the heuristic (see BddVariableOrder::Heuristic).
+	void setBddVariableOrder(int heuristic)
+	{
+		bdd_variable_order_ = heuristic;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the memory limit of the BDD manager in MB, 0 means no limit.
+///
+/// @return the value of --bdd_max_mem.
+	unsigned long getBddMaxMemory() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the maximum number of live BDD nodes, 0 means no limit.
+///
+/// @return the value of --bdd_max_nodes.
+	unsigned getBddMaxNodes() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of nodes at which dynamic reordering starts, 0 means never.
+///
+/// @return the value of --bdd_reorder_at.
+	unsigned getBddReorderThreshold() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of latch groups the 'bdd' back-end analyzes in parallel.
+///
+/// @return the value of --bdd_partitions.
+	unsigned getBddPartitions() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets the number of latch groups the 'bdd' back-end analyzes in parallel, like
+///        --bdd_partitions=N.
+///
+/// @param num_partitions the number of groups, 1 means no partitioning.
+	void setBddPartitions(unsigned num_partitions)
+	{
+		bdd_partitions_ = num_partitions;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if the 'dp' back-end should restrict its checks to reachable states.
+///
+/// @return true if --dp_reach was given.
+	bool isDpReachability() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the node limit for the BDD of the reachable states, 0 means no limit.
+///
+/// @return the value of --dp_reach=N.
+	unsigned getDpReachabilityMaxNodes() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Restricts the checks of the 'dp' back-end to reachable states, like --dp_reach=N.
+///
+/// @param reachability true to compute the reachable states.
+/// @param max_nodes the node limit for the BDD of the reachable states, 0 means no limit.
+	void setDpReachability(bool reachability, unsigned max_nodes)
+	{
+		dp_reachability_ = reachability;
+		dp_reachability_max_nodes_ = max_nodes;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if the faulty copy of the 'dp' back-end shares the AND gates which do
+///        not differ from the fault-free copy (modes 3 and 5).
+///
+/// @return false if --dp_no_sharing was given.
+	bool isDpShareGates() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Enables or disables the gate sharing of the 'dp' back-end, like --dp_no_sharing.
+///
+/// @param share_gates false to build the faulty copy in full.
+	void setDpShareGates(bool share_gates)
+	{
+		dp_share_gates_ = share_gates;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the maximum k of the k-induction mode of the 'dp' back-end.
+///
+/// @return the value of --kind_max.
+	unsigned getKInductionMaxDepth() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of threads of the 'dp' back-end (mode 1).
+///
+/// @return the value of --dp_threads=N, 1 means sequential.
+	unsigned getDpThreads() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets the number of threads of the 'dp' back-end (mode 1), like --dp_threads=N.
+///
+/// @param num_threads the number of threads, 1 means sequential.
+	void setDpThreads(unsigned num_threads)
+	{
+		dp_threads_ = num_threads;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of threads of the 'fp' and 'fps' back-ends.
+///
+/// @return the value of --fp_threads=N, 1 means sequential.
+	unsigned getFpThreads() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets the number of threads of the 'fp' and 'fps' back-ends, like --fp_threads=N.
+///
+/// @param num_threads the number of threads, 1 means sequential.
+	void setFpThreads(unsigned num_threads)
+	{
+		fp_threads_ = num_threads;
+	}
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the file for the statistics of the 'bdd' back-end, "" if none.
+///
+/// @return the value of --bdd_stats.
+	const string& getBddStatsPath() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the initial number of unique table slots per variable of the CUDD manager.
+///
+/// @return the value of --bdd_unique_slots (default CUDD_UNIQUE_SLOTS).
+	unsigned getBddUniqueSlots() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the initial number of computed table slots of the CUDD manager.
+///
+/// @return the value of --bdd_cache_slots (default CUDD_CACHE_SLOTS).
+	unsigned getBddCacheSlots() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns the number of live BDD nodes at which the hybrid BDD mode switches to SAT.
+///
+/// @return the value of --hybrid_nodes.
+	unsigned getHybridNodeLimit() const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets the node count at which the hybrid BDD mode switches to SAT, like --hybrid_nodes=N.
+///
+/// @param limit the number of live BDD nodes, 0 switches to SAT at the first time-step.
+	void setHybridNodeLimit(unsigned limit)
+	{
+		hybrid_node_limit_ = limit;
+	}
 	int getDefinitevelyProtectedNumInitialSteps() const;
 	int getDefinitivelyProtectedKSteps() const;
 
@@ -387,6 +666,87 @@ class Options
 	set<unsigned> latches_to_exclude_;
 	string latches_to_exclude_file_path_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief 0: no fault collapsing, 1: collapsing with SAT confirmation, 2: signatures only
+	int fault_collapsing_mode_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the classes of equivalent latches (computed on the first removeExcludedLatches())
+	FaultCollapsing* fault_collapsing_;
+	vector<unsigned> fault_collapsing_latches_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the latch scheduling and budgets (see isScheduleLatches(), getLatchTimeout(),
+/// getGlobalTimeout() and getConflictLimit())
+	bool schedule_latches_;
+	double latch_timeout_;
+	double global_timeout_;
+	long conflict_limit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the checkpoint journal (see getJournalPath() and isResume())
+	string journal_path_;
+	bool resume_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the static BDD variable order heuristic (see getBddVariableOrder())
+	int bdd_variable_order_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the limits of the BDD manager (see getBddMaxMemory() and the following getters)
+	unsigned long bdd_max_memory_;
+	unsigned bdd_max_nodes_;
+	unsigned bdd_reorder_threshold_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the number of latch groups analyzed in parallel (see getBddPartitions())
+	unsigned bdd_partitions_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the reachable states option of the 'dp' back-end (see isDpReachability())
+	bool dp_reachability_;
+	unsigned dp_reachability_max_nodes_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the gate sharing of the 'dp' back-end (see isDpShareGates())
+	bool dp_share_gates_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the maximum k of the k-induction mode (see getKInductionMaxDepth())
+	unsigned k_induction_max_depth_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the number of threads of the 'dp' back-end (see getDpThreads())
+	unsigned dp_threads_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the number of threads of the 'fp' and 'fps' back-ends (see getFpThreads())
+	unsigned fp_threads_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the statistics file and table sizes of the 'bdd' back-end (see getBddStatsPath())
+	string bdd_stats_path_;
+	unsigned bdd_unique_slots_;
+	unsigned bdd_cache_slots_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the node limit of the hybrid BDD mode (see getHybridNodeLimit())
+	unsigned hybrid_node_limit_;
+
 	private:
 
 // -------------------------------------------------------------------------------------------
@@ -238,7 +238,10 @@ void PicoSatApi::incAddNegCubeAsClause(const vector<int> &cube)
 bool PicoSatApi::incIsSat()
 {
   MASSERT(incr_ != NULL, "No open session.");
-  int res = picosat_sat(incr_, -1);
+  int res = picosat_sat(incr_, conflict_limit_ < 0 ? -1 : static_cast<int>(conflict_limit_));
+  last_result_unknown_ = (res == PICOSAT_UNKNOWN);
+  if(last_result_unknown_)
+    return false;
   if(res == PICOSAT_SATISFIABLE)
     return true;
   else if(res == PICOSAT_UNSATISFIABLE)
@@ -253,7 +256,10 @@ bool PicoSatApi::incIsSat(const vector<int> &assumptions)
   MASSERT(incr_ != NULL, "No open session.");
   for(size_t ass_cnt = 0; ass_cnt < assumptions.size(); ++ass_cnt)
     picosat_assume(incr_, assumptions[ass_cnt]);
-  int res = picosat_sat(incr_, -1);
+  int res = picosat_sat(incr_, conflict_limit_ < 0 ? -1 : static_cast<int>(conflict_limit_));
+  last_result_unknown_ = (res == PICOSAT_UNKNOWN);
+  if(last_result_unknown_)
+    return false;
   if(res == PICOSAT_SATISFIABLE)
     return true;
   else if(res == PICOSAT_UNSATISFIABLE)
@@ -271,7 +277,13 @@ bool PicoSatApi::incIsSatModelOrCore(const vector<int> &assumptions,
   for(size_t ass_cnt = 0; ass_cnt < assumptions.size(); ++ass_cnt)
     picosat_assume(incr_, assumptions[ass_cnt]);
 
-  int res = picosat_sat(incr_, -1);
+  int res = picosat_sat(incr_, conflict_limit_ < 0 ? -1 : static_cast<int>(conflict_limit_));
+  last_result_unknown_ = (res == PICOSAT_UNKNOWN);
+  if(last_result_unknown_)
+  {
+    model_or_core.clear();
+    return false;
+  }
   if(res == PICOSAT_SATISFIABLE)
   {
     model_or_core.clear();
@@ -338,7 +350,13 @@ bool PicoSatApi::incIsSatModelOrCore(const vector<int> &core_assumptions,
   for(size_t ass_cnt = 0; ass_cnt < core_assumptions.size(); ++ass_cnt)
     picosat_assume(incr_, core_assumptions[ass_cnt]);
 
-  int res = picosat_sat(incr_, -1);
+  int res = picosat_sat(incr_, conflict_limit_ < 0 ? -1 : static_cast<int>(conflict_limit_));
+  last_result_unknown_ = (res == PICOSAT_UNKNOWN);
+  if(last_result_unknown_)
+  {
+    model_or_core.clear();
+    return false;
+  }
   if(res == PICOSAT_SATISFIABLE)
   {
     model_or_core.clear();
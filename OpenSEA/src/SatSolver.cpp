@@ -32,7 +32,9 @@
 // -------------------------------------------------------------------------------------------
 SatSolver::SatSolver(bool rand_models, bool min_cores) :
            min_cores_(min_cores),
-           rand_models_(rand_models)
+           rand_models_(rand_models),
+           conflict_limit_(-1),
+           last_result_unknown_(false)
 {
   // nothing to do
 }
@@ -55,3 +57,14 @@ void SatSolver::doRandModels(bool rand_models)
   rand_models_ = rand_models;
 }
 
+// -------------------------------------------------------------------------------------------
+void SatSolver::setConflictLimit(long limit)
+{
+  conflict_limit_ = limit;
+}
+
+// -------------------------------------------------------------------------------------------
+bool SatSolver::isLastResultUnknown() const
+{
+  return last_result_unknown_;
+}
@@ -97,6 +97,25 @@ public:
 ///        If this parameter is skipped, then randomization is enabled.
   void doRandModels(bool rand_models = true);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Sets a limit for the effort of every following incremental SAT-solver call.
+///
+/// If the limit is reached, the incIsSat...() methods give up, return false and
+/// #isLastResultUnknown() returns true. The limit is a number of conflicts (for PicoSat:
+/// decisions, which is the only limit its API offers). Minimization of unsat cores is not
+/// limited.
+///
+/// @param limit The maximum number of conflicts per call. A negative number means no limit.
+  void setConflictLimit(long limit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Returns true if the last incremental SAT-solver call hit the conflict limit.
+///
+/// @return True if the result of the last incIsSat...() call is unknown.
+  bool isLastResultUnknown() const;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Checks if a CNF is satisfiable.
@@ -456,6 +475,16 @@ protected:
 /// @brief Indicates if satisfying assignments should be randomized.
   bool rand_models_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief The conflict limit per incremental call (negative = no limit).
+  long conflict_limit_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Indicates if the last incremental call was aborted because of conflict_limit_.
+  bool last_result_unknown_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
@@ -39,6 +39,18 @@ SimulationBasedAnalysis::SimulationBasedAnalysis(aiger* circuit, int num_err_lat
 		BackEnd(circuit, num_err_latches, mode), tc_index_(0)
 {
 	sim_ = new AigSimulator(circuit_);
+
+	// Zobrist keys (splitmix64 sequence with fixed seed -> reproducible)
+	zobrist_keys_.reserve(circuit_->num_latches);
+	uint64_t seed = 0x9E3779B97F4A7C15ULL;
+	for (unsigned l = 0; l < circuit_->num_latches; ++l)
+	{
+		seed += 0x9E3779B97F4A7C15ULL;
+		uint64_t z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		zobrist_keys_.push_back(z ^ (z >> 31));
+	}
 }
 
 // -------------------------------------------------------------------------------------------
@@ -47,6 +59,18 @@ SimulationBasedAnalysis::~SimulationBasedAnalysis()
 	delete sim_;
 }
 
+// -------------------------------------------------------------------------------------------
+uint64_t SimulationBasedAnalysis::hashState(const vector<int> &state) const
+{
+	uint64_t hash = 0;
+	for (unsigned l = 0; l < state.size(); ++l)
+	{
+		if (state[l] == AIG_TRUE)
+			hash ^= zobrist_keys_[l];
+	}
+	return hash;
+}
+
 void SimulationBasedAnalysis::analyze()
 {
 	vector<TestCase> testcases = TestCaseProvider::instance().getTestcases();
@@ -78,14 +102,17 @@ void SimulationBasedAnalysis::findVulnerabilitiesForTC(TestCase& test_case)
 
 	vector<vector<int> > outputs_ok;
 	vector<vector<int> > states_ok;
+	vector<uint64_t> state_hashes_ok;
 	outputs_ok.reserve(test_case.size());
 	states_ok.reserve(test_case.size());
+	state_hashes_ok.reserve(test_case.size());
 
 	// simulate whole TestCase without error, store results
 	while (sim_->simulateOneTimeStep() == true)
 	{
 		outputs_ok.push_back(sim_->getOutputs());
 		states_ok.push_back(sim_->getLatchValues());
+		state_hashes_ok.push_back(hashState(states_ok.back()));
 		sim_->switchToNextState();
 	}
 
@@ -110,6 +137,9 @@ void SimulationBasedAnalysis::findVulnerabilitiesForTC(TestCase& test_case)
 	map<unsigned, unsigned> literal_to_idx;
 	Utils::genLit2IndexMap(latches_to_check, circuit_, literal_to_idx);
 
+	// one simulator for all flips, it gets the full state in every simulateOneTimeStep()
+	AigSimulator sim_w_flip(circuit_);
+
 	//  for each latch
 	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
 	{
@@ -121,6 +151,11 @@ void SimulationBasedAnalysis::findVulnerabilitiesForTC(TestCase& test_case)
 		{
 			continue;
 		}
+		if (isGlobalBudgetExceeded())
+		{
+			markLatchUnknown(latches_to_check[l_cnt]);
+			continue;
+		}
 		bool l_is_vulnerable = false;
 
 		// for all time steps i of t:
@@ -136,7 +171,7 @@ void SimulationBasedAnalysis::findVulnerabilitiesForTC(TestCase& test_case)
 			unsigned idx_of_current_latch = literal_to_idx[latches_to_check[l_cnt]];
 			// flip latch
 			state[idx_of_current_latch] = aiger_not(state[idx_of_current_latch]); // don't forget to restore state again later
-			AigSimulator sim_w_flip(circuit_);
+			uint64_t state_hash = state_hashes_ok[timestep] ^ zobrist_keys_[idx_of_current_latch];
 
 			// for all j >= i:
 			for (unsigned later_timestep = timestep; later_timestep < states_ok.size(); ++later_timestep)
@@ -144,7 +179,16 @@ void SimulationBasedAnalysis::findVulnerabilitiesForTC(TestCase& test_case)
 				// next_state[], out[], alarm = simulate1step(state[], t[later_timestep])
 				sim_w_flip.simulateOneTimeStep(test_case[later_timestep], state);
 
-				state = sim_w_flip.getNextLatchValues(); // state = next state
+				// state = next state (in place), update hash incrementally with the toggled latches
+				for (unsigned l = 0; l < state.size(); ++l)
+				{
+					int next_value = sim_w_flip.getNextLatchValue(l);
+					if (next_value != state[l])
+					{
+						state_hash ^= zobrist_keys_[l];
+						state[l] = next_value;
+					}
+				}
 				vector<int> outputs_w_flip = sim_w_flip.getOutputs();
 
 				// if(alarm)
@@ -196,7 +240,10 @@ void SimulationBasedAnalysis::findVulnerabilitiesForTC(TestCase& test_case)
 				}
 
 				// else if (next_state[] == states[later_timestep+1][])
-				if (sim_w_flip.getLatchValues() == states_ok[later_timestep + 1])
+				// (exact comparison only if the hashes match)
+				if (later_timestep + 1 < states_ok.size()
+						&& state_hash == state_hashes_ok[later_timestep + 1]
+						&& state == states_ok[later_timestep + 1])
 				{
 					state[idx_of_current_latch] = aiger_not(state[idx_of_current_latch]); // undo bit-flip
 					break;
@@ -230,6 +277,12 @@ void SimulationBasedAnalysis::findVulnerabilitiesForTCFreeInputs(TestCase& test_
 
 	for (unsigned long long input_vector = 0; input_vector < pow(2,num_free_inputs); input_vector++)
 	{
+		if (isGlobalBudgetExceeded())
+		{
+			markUndetectedLatchesUnknown(
+					Options::instance().removeExcludedLatches(circuit_, num_err_latches_));
+			break;
+		}
 
 		TestCase concrete_test_case = test_case;
 		unsigned free_input_ctr = 0;
@@ -25,6 +25,7 @@
 #ifndef SimulationBasedAnalysis_H__
 #define SimulationBasedAnalysis_H__
 
+#include <stdint.h>
 #include "defines.h"
 #include "AigSimulator.h"
 #include "BackEnd.h"
@@ -104,6 +105,21 @@ protected:
 ///
 void findVulnerabilitiesForTCFreeInputs(TestCase& test_case);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief computes the 64-bit Zobrist hash of a state (XOR of the keys of all latches = 1)
+///
+/// @param state the latch values of the state to hash
+/// @return the hash of the given state
+	uint64_t hashState(const vector<int> &state) const;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief one random 64-bit Zobrist key per latch index, used for state hashing.
+///
+/// The keys are generated deterministically, so results are reproducible.
+	vector<uint64_t> zobrist_keys_;
+
 private:
 
 // -------------------------------------------------------------------------------------------
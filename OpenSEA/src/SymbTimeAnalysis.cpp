@@ -33,6 +33,7 @@
 #include "Logger.h"
 #include "SymbolicSimulator.h"
 #include "AndCacheMap.h"
+#include "ConeOfInfluence.h"
 #include "ErrorTraceManager.h"
 #include "TestCaseProvider.h"
 
@@ -66,6 +67,7 @@ bool SymbTimeAnalysis::analyze(vector<TestCase> &testcases)
 {
 	//	vulnerable_latches = empty_set/list
 	detected_latches_.clear();
+	openJournal();
 
 	if (mode_ == NAIVE)
 		Analyze1_naive(testcases);
@@ -86,17 +88,27 @@ void SymbTimeAnalysis::Analyze1_naive(vector<TestCase> &testcases)
 
 	sim_ = new AigSimulator(circuit_);
 
-	AIG2CNF::instance().initFromAig(circuit_);
+	// logic which can not reach an output or next-state function is not encoded
+	ConeOfInfluence coi(circuit_);
+	AIG2CNF::instance().initFromAig(circuit_, &coi.getBackwardConeMask());
 
 	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
 	map<unsigned, unsigned> literal_to_idx;
 	Utils::genLit2IndexMap(latches_to_check, circuit_, literal_to_idx);
+	scheduleLatches(latches_to_check); // after genLit2IndexMap, which needs the original order
 
 
 // ---------------- BEGIN 'for each latch' -------------------------
 	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
 	{
 		unsigned component_aig = latches_to_check[l_cnt];
+		if (isGlobalBudgetExceeded())
+		{
+			markLatchUnknown(component_aig);
+			continue;
+		}
+		startLatchBudget(solver_);
+		bool gave_up = false;
 		int component_cnf = AIG2CNF::instance().aigLitToCnfLit(component_aig);
 
 		int next_free_cnf_var = AIG2CNF::instance().getMaxCnfVar() + 1;
@@ -118,8 +130,10 @@ void SymbTimeAnalysis::Analyze1_naive(vector<TestCase> &testcases)
 		T_err.add3LitClause(f_orig, -component_cnf, poss_neg_state_cnf_var);
 		T_err.add3LitClause(f_orig, component_cnf, -poss_neg_state_cnf_var);
 
-		for (unsigned tci = 0; tci < testcases.size(); tci++)
+		for (unsigned tci = 0; tci < testcases.size() && !gave_up; tci++)
 		{
+			if (isJournaledDone(component_aig, tci))
+				continue;
 			// concrete_state[] = (0 0 0 0 0 0 0)   // AIG literals
 			vector<int> concrete_state;
 			concrete_state.resize(circuit_->num_latches);
@@ -357,6 +371,13 @@ void SymbTimeAnalysis::Analyze1_naive(vector<TestCase> &testcases)
 					break;
 				}
 
+				if (solver_->isLastResultUnknown() || isBudgetExceeded())
+				{
+					markLatchUnknown(component_aig);
+					gave_up = true;
+					break;
+				}
+
 				concrete_state = next_state;
 
 				symb_state = renamed_next_state_vars;
@@ -364,6 +385,8 @@ void SymbTimeAnalysis::Analyze1_naive(vector<TestCase> &testcases)
 			} // -- END "for each timestep in testcase" --
 			if (environment_model_)
 				delete environment_sim;
+			if (!gave_up)
+				journalDone(component_aig, tci);
 		} // end "for each testcase"
 	} // ------ END 'for each latch' ---------------
 
@@ -381,17 +404,27 @@ void SymbTimeAnalysis::Analyze1_symb_sim(vector<TestCase>& testcases)
 	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
 	map<unsigned, unsigned> literal_to_idx;
 	Utils::genLit2IndexMap(latches_to_check, circuit_, literal_to_idx);
+	scheduleLatches(latches_to_check); // after genLit2IndexMap, which needs the original order
 
 	// ---------------- BEGIN 'for each latch' -------------------------
 	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
 	{
 		unsigned component_aig = latches_to_check[l_cnt];
+		if (isGlobalBudgetExceeded())
+		{
+			markLatchUnknown(component_aig);
+			continue;
+		}
+		startLatchBudget(solver_);
+		bool gave_up = false;
 		int component_cnf = component_aig >> 1;
 
 		next_free_cnf_var = 2;
 
-		for (unsigned tci = 0; tci < testcases.size(); tci++)
+		for (unsigned tci = 0; tci < testcases.size() && !gave_up; tci++)
 		{
+			if (isJournaledDone(component_aig, tci))
+				continue;
 
 			// initial state for concrete simulation = (0 0 0 0 0 0 0)  (AIG literals)
 			vector<int> concrete_state;
@@ -500,22 +533,7 @@ void SymbTimeAnalysis::Analyze1_symb_sim(vector<TestCase>& testcases)
 				{
 					int fi = next_free_cnf_var++;
 					solver_->addVarToKeep(fi);
-					int old_value = symbsim.getResultValue(component_cnf);
-					if (old_value == CNF_TRUE) // old value is true
-						symbsim.setResultValue(component_cnf, -fi);
-					else if (old_value == CNF_FALSE) // old value is false
-						symbsim.setResultValue(component_cnf, fi);
-					else
-					{
-						int new_value = next_free_cnf_var++;
-						solver_->addVarToKeep(new_value);
-						// new_value == fi ? -old_value : old_value
-						solver_->incAdd3LitClause(fi, old_value, -new_value);
-						solver_->incAdd3LitClause(fi, -old_value, new_value);
-						solver_->incAdd3LitClause(-fi, old_value, new_value);
-						solver_->incAdd3LitClause(-fi, -old_value, -new_value);
-						symbsim.setResultValue(component_cnf, new_value);
-					}
+					symbsim.flipLatchIf(component_cnf, fi);
 
 					// there might be at most one flip in one time-step:
 					// if fi is true, all oter f must be false (fi -> -f1, fi -> -f2, ...)
@@ -588,6 +606,13 @@ void SymbTimeAnalysis::Analyze1_symb_sim(vector<TestCase>& testcases)
 					break;
 				}
 
+				if (solver_->isLastResultUnknown() || isBudgetExceeded())
+				{
+					markLatchUnknown(component_aig);
+					gave_up = true;
+					break;
+				}
+
 				//------------------------------------------------------------------------------------
 				// Optimization: next state does not change,no matter if we flip or not -> remove fi's
 				int next_state_is_diff = next_free_cnf_var++;
@@ -650,6 +675,8 @@ void SymbTimeAnalysis::Analyze1_symb_sim(vector<TestCase>& testcases)
 					vector<int> core;
 					bool is_sat_2 = solver_->incIsSatModelOrCore(core_assumptions,
 							more_assumptions, f, core);
+					if (solver_->isLastResultUnknown())
+						continue; // no core within the conflict limit, keep all fi's
 					MASSERT(is_sat_2 == false, "must not be satisfiable")
 
 					// TODO: not sure if there could be a more efficient way to do this
@@ -681,6 +708,8 @@ void SymbTimeAnalysis::Analyze1_symb_sim(vector<TestCase>& testcases)
 			} // -- END "for each timestep in testcase" --
 			if(environment_sim)
 				delete environment_sim;
+			if (!gave_up)
+				journalDone(component_aig, tci);
 		} // end "for each testcase"
 	} // ------ END 'for each latch' ---------------
 
@@ -698,17 +727,32 @@ void SymbTimeAnalysis::Analyze1_free_inputs(vector<TestCase>& testcases)
 		sim_env = new SymbolicSimulator(environment_model_, solver_, next_free_cnf_var);
 
 	vector<unsigned> latches_to_check = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	scheduleLatches(latches_to_check);
+
+	// the faulty copy only encodes the AND gates in the cone of influence of the flipped latch,
+	// all other AND gates get the values of sim_ok
+	ConeOfInfluence coi(circuit_);
+	symbsim.setAndMask(&coi.getAndMask(), &sim_ok.getResults());
 
 	// ---------------- BEGIN 'for each latch' -------------------------
 	for (unsigned l_cnt = 0; l_cnt < latches_to_check.size(); ++l_cnt)
 	{
 		unsigned component_aig = latches_to_check[l_cnt];
+		if (isGlobalBudgetExceeded())
+		{
+			markLatchUnknown(component_aig);
+			continue;
+		}
+		startLatchBudget(solver_);
+		bool gave_up = false;
 		int component_cnf = component_aig >> 1;
 
 		next_free_cnf_var = 2;
 
-		for (unsigned tci = 0; tci < testcases.size(); tci++)
+		for (unsigned tci = 0; tci < testcases.size() && !gave_up; tci++)
 		{
+			if (isJournaledDone(component_aig, tci))
+				continue;
 
 			// initial state for concrete simulation = (0 0 0 0 0 0 0)  (AIG literals)
 			vector<int> concrete_state;
@@ -731,6 +775,7 @@ void SymbTimeAnalysis::Analyze1_free_inputs(vector<TestCase>& testcases)
 
 			sim_ok.initLatches();
 			symbsim.initLatches();
+			coi.setFlippedLatch(component_aig);
 			if (environment_model_)
 				sim_env->initLatches();
 
@@ -788,22 +833,7 @@ void SymbTimeAnalysis::Analyze1_free_inputs(vector<TestCase>& testcases)
 				{
 					int fi = next_free_cnf_var++;
 					solver_->addVarToKeep(fi);
-					int old_value = symbsim.getResultValue(component_cnf);
-					if (old_value == CNF_TRUE) // old value is true
-						symbsim.setResultValue(component_cnf, -fi);
-					else if (old_value == CNF_FALSE) // old value is false
-						symbsim.setResultValue(component_cnf, fi);
-					else
-					{
-						int new_value = next_free_cnf_var++;
-						solver_->addVarToKeep(new_value);
-						// new_value == fi ? -old_value : old_value
-						solver_->incAdd3LitClause(fi, old_value, -new_value);
-						solver_->incAdd3LitClause(fi, -old_value, new_value);
-						solver_->incAdd3LitClause(-fi, old_value, new_value);
-						solver_->incAdd3LitClause(-fi, -old_value, -new_value);
-						symbsim.setResultValue(component_cnf, new_value);
-					}
+					symbsim.flipLatchIf(component_cnf, fi);
 
 					// there might be at most one flip in one time-step:
 					// if fi is true, all oter f must be false (fi -> -f1, fi -> -f2, ...)
@@ -818,6 +848,7 @@ void SymbTimeAnalysis::Analyze1_free_inputs(vector<TestCase>& testcases)
 				//------------------------------------------------------------------------------------
 				// Symbolic simulation of AND gates
 				symbsim.simulateOneTimeStep();
+				coi.extendToNextStep(); // a flip in this step may reach more latches
 
 				//------------------------------------------------------------------------------------
 				vector<int> env_outputs;
@@ -932,6 +963,13 @@ void SymbTimeAnalysis::Analyze1_free_inputs(vector<TestCase>& testcases)
 					break;
 				}
 
+				if (solver_->isLastResultUnknown() || isBudgetExceeded())
+				{
+					markLatchUnknown(component_aig);
+					gave_up = true;
+					break;
+				}
+
 				//------------------------------------------------------------------------------------
 				// Optimization: next state does not change,no matter if we flip or not -> remove fi's
 				int next_state_is_diff = next_free_cnf_var++;
@@ -1010,6 +1048,8 @@ void SymbTimeAnalysis::Analyze1_free_inputs(vector<TestCase>& testcases)
 					vector<int> core;
 					bool is_sat_2 = solver_->incIsSatModelOrCore(core_assumptions,
 							more_assumptions, f, core);
+					if (solver_->isLastResultUnknown())
+						continue; // no core within the conflict limit, keep all fi's
 					MASSERT(is_sat_2 == false, "must not be satisfiable")
 
 					// TODO: not sure if there could be a more efficient way to do this
@@ -1039,6 +1079,8 @@ void SymbTimeAnalysis::Analyze1_free_inputs(vector<TestCase>& testcases)
 				}
 
 			} // -- END "for each timestep in testcase" --
+			if (!gave_up)
+				journalDone(component_aig, tci);
 		} // end "for each testcase"
 	} // ------ END 'for each latch' ---------------
 
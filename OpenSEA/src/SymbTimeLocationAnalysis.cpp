@@ -65,6 +65,7 @@ bool SymbTimeLocationAnalysis::analyze(vector<TestCase> &testcases)
 {
 	//	vulnerable_latches = empty_set/list
 	detected_latches_.clear();
+	openJournal();
 
 	if (mode_ == STANDARD)
 		Analyze2(testcases);
@@ -77,6 +78,20 @@ bool SymbTimeLocationAnalysis::analyze(vector<TestCase> &testcases)
 }
 
 
+// -------------------------------------------------------------------------------------------
+void SymbTimeLocationAnalysis::setLatchesToCheck(const vector<unsigned>& latches)
+{
+	latch_subset_ = latches;
+}
+
+// -------------------------------------------------------------------------------------------
+vector<unsigned> SymbTimeLocationAnalysis::getLatchesToCheck()
+{
+	if (!latch_subset_.empty())
+		return latch_subset_;
+	return Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+}
+
 // -------------------------------------------------------------------------------------------
 void SymbTimeLocationAnalysis::Analyze2(vector<TestCase>& testcases)
 {
@@ -84,7 +99,7 @@ void SymbTimeLocationAnalysis::Analyze2(vector<TestCase>& testcases)
 	// used to store the results of the symbolic simulation
 	int next_free_cnf_var = 2;
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	vector<unsigned> l_list = getLatchesToCheck();
 	set<int> latches_to_check;
 
 	//------------------------------------------------------------------------------------------
@@ -101,13 +116,29 @@ void SymbTimeLocationAnalysis::Analyze2(vector<TestCase>& testcases)
 		latch_to_cj[l_list[c_cnt] >> 1] = cj;
 		cj_to_latch[cj] = l_list[c_cnt];
 	}
+	// latches detected in a resumed run need not be flipped again
+	for (set<unsigned>::iterator it = detected_latches_.begin(); it != detected_latches_.end(); ++it)
+		latches_to_check.erase(*it);
 	int next_cnf_var_after_ci_vars = next_free_cnf_var;
 	//------------------------------------------------------------------------------------------
 	SymbolicSimulator symbsim(circuit_, solver_, next_free_cnf_var);
 
+	// all latches are flipped at once, so --latch_timeout does not apply. If --timeout or the
+	// conflict limit stop a test-case early, all undetected latches are reported as unknown.
+	startLatchBudget(solver_);
+	bool incomplete = false;
+
 	// for each testcase-step
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
+		if (isJournaledDone(l_list, tc_number))
+			continue;
+		if (isGlobalBudgetExceeded())
+		{
+			incomplete = true;
+			break;
+		}
+		bool gave_up = false;
 
 		// initial state for concrete simulation = (0 0 0 0 0 0 0)  (AIG literals)
 		vector<int> concrete_state;
@@ -182,20 +213,7 @@ void SymbTimeLocationAnalysis::Analyze2(vector<TestCase>& testcases)
 			for (it = latches_to_check.begin(); it != latches_to_check.end(); ++it)
 			{
 				int latch_output = *it >> 1;
-				int old_value = symbsim.getResultValue(latch_output);
-				int new_value = next_free_cnf_var++;
-				int ci_lit = latch_to_cj[latch_output];
-
-				//solver_->addVarToKeep(new_value);
-
-				solver_->incAdd3LitClause(old_value, ci_lit, -new_value);
-				solver_->incAdd3LitClause(old_value, fi, -new_value);
-				solver_->incAdd4LitClause(-old_value, -ci_lit, -fi, -new_value);
-				solver_->incAdd3LitClause(-old_value, ci_lit, new_value);
-				solver_->incAdd3LitClause(-old_value, fi, new_value);
-				solver_->incAdd4LitClause(old_value, -ci_lit, -fi, new_value);
-
-				symbsim.setResultValue(latch_output, new_value);
+				symbsim.flipLatchIf(latch_output, latch_to_cj[latch_output], fi);
 			}
 
 			//--------------------------------------------------------------------------------------
@@ -301,6 +319,12 @@ void SymbTimeLocationAnalysis::Analyze2(vector<TestCase>& testcases)
 				}
 			}
 
+			if (solver_->isLastResultUnknown() || isGlobalBudgetExceeded())
+			{
+				gave_up = true; // the remaining time steps of this test-case are not analyzed
+				break;
+			}
+
 			// negate (=set to positive face) newest odiff_enable_literal to disable
 			// the previous o_is_diff_clausefor the next iterations
 			odiff_enable_literals.back() = -odiff_enable_literals.back();
@@ -391,6 +415,8 @@ void SymbTimeLocationAnalysis::Analyze2(vector<TestCase>& testcases)
 				vector<int> core;
 				bool is_sat_2 = solver_->incIsSatModelOrCore(core_assumptions, more_assumptions,
 						f, core);
+				if (solver_->isLastResultUnknown())
+					continue; // no core within the conflict limit, keep all fi's
 				MASSERT(is_sat_2 == false, "must not be satisfiable")
 
 				// TODO: not sure if there could be a more efficient way to do this
@@ -422,7 +448,15 @@ void SymbTimeLocationAnalysis::Analyze2(vector<TestCase>& testcases)
 		} // -- END "for each timestep in testcase" --
 		if (environment_model_)
 			delete environment_sim;
+		if (gave_up)
+		{
+			incomplete = true;
+			continue;
+		}
+		journalDone(l_list, tc_number);
 	} // ------ END 'for each testcase' ---------------
+	if (incomplete)
+		markUndetectedLatchesUnknown(l_list);
 
 
 	delete sim_;
@@ -433,7 +467,7 @@ void SymbTimeLocationAnalysis::Analyze2_free_inputs(vector<TestCase>& testcases)
 	// used to store the results of the symbolic simulation
 	int next_free_cnf_var = 2;
 
-	vector<unsigned> l_list = Options::instance().removeExcludedLatches(circuit_, num_err_latches_);
+	vector<unsigned> l_list = getLatchesToCheck();
 	set<int> latches_to_check_;
 
 	//------------------------------------------------------------------------------------------
@@ -450,6 +484,9 @@ void SymbTimeLocationAnalysis::Analyze2_free_inputs(vector<TestCase>& testcases)
 		latch_to_cj[l_list[c_cnt] >> 1] = cj;
 		cj_to_latch[cj] = l_list[c_cnt];
 	}
+	// latches detected in a resumed run need not be flipped again
+	for (set<unsigned>::iterator it = detected_latches_.begin(); it != detected_latches_.end(); ++it)
+		latches_to_check_.erase(*it);
 	int next_cnf_var_after_ci_vars = next_free_cnf_var;
 	//------------------------------------------------------------------------------------------
 	SymbolicSimulator sim_ok(circuit_, solver_, next_free_cnf_var);
@@ -458,9 +495,22 @@ void SymbTimeLocationAnalysis::Analyze2_free_inputs(vector<TestCase>& testcases)
 	if (environment_model_)
 		sim_env = new SymbolicSimulator(environment_model_, solver_, next_free_cnf_var);
 
+	// all latches are flipped at once, so --latch_timeout does not apply. If --timeout or the
+	// conflict limit stop a test-case early, all undetected latches are reported as unknown.
+	startLatchBudget(solver_);
+	bool incomplete = false;
+
 	// for each testcase-step
 	for (unsigned tc_number = 0; tc_number < testcases.size(); tc_number++)
 	{
+		if (isJournaledDone(l_list, tc_number))
+			continue;
+		if (isGlobalBudgetExceeded())
+		{
+			incomplete = true;
+			break;
+		}
+		bool gave_up = false;
 
 		// f = a set of variables fi indicating whether a latch is *flipped in _step_ i* or not
 		vector<int> f;
@@ -532,20 +582,7 @@ void SymbTimeLocationAnalysis::Analyze2_free_inputs(vector<TestCase>& testcases)
 			for (it = latches_to_check_.begin(); it != latches_to_check_.end(); ++it)
 			{
 				int latch_output = *it >> 1;
-				int old_value = symbsim.getResultValue(latch_output);
-				int new_value = next_free_cnf_var++;
-				int ci_lit = latch_to_cj[latch_output];
-
-				//solver_->addVarToKeep(new_value);
-
-				solver_->incAdd3LitClause(old_value, ci_lit, -new_value);
-				solver_->incAdd3LitClause(old_value, fi, -new_value);
-				solver_->incAdd4LitClause(-old_value, -ci_lit, -fi, -new_value);
-				solver_->incAdd3LitClause(-old_value, ci_lit, new_value);
-				solver_->incAdd3LitClause(-old_value, fi, new_value);
-				solver_->incAdd4LitClause(old_value, -ci_lit, -fi, new_value);
-
-				symbsim.setResultValue(latch_output, new_value);
+				symbsim.flipLatchIf(latch_output, latch_to_cj[latch_output], fi);
 			}
 
 			//--------------------------------------------------------------------------------------
@@ -731,6 +768,12 @@ void SymbTimeLocationAnalysis::Analyze2_free_inputs(vector<TestCase>& testcases)
 				}
 			}
 
+			if (solver_->isLastResultUnknown() || isGlobalBudgetExceeded())
+			{
+				gave_up = true; // the remaining time steps of this test-case are not analyzed
+				break;
+			}
+
 			// negate (=set to positive face) newest odiff_enable_literal to disable
 			// the previous o_is_diff_clausefor the next iterations
 			odiff_enable_literals.back() = -odiff_enable_literals.back();
@@ -836,6 +879,8 @@ void SymbTimeLocationAnalysis::Analyze2_free_inputs(vector<TestCase>& testcases)
 				vector<int> core;
 				bool is_sat_2 = solver_->incIsSatModelOrCore(core_assumptions, more_assumptions,
 						f, core);
+				if (solver_->isLastResultUnknown())
+					continue; // no core within the conflict limit, keep all fi's
 				MASSERT(is_sat_2 == false, "must not be satisfiable")
 
 				// TODO: not sure if there could be a more efficient way to do this
@@ -865,7 +910,15 @@ void SymbTimeLocationAnalysis::Analyze2_free_inputs(vector<TestCase>& testcases)
 			}
 
 		} // -- END "for each timestep in testcase" --
+		if (gave_up)
+		{
+			incomplete = true;
+			continue;
+		}
+		journalDone(l_list, tc_number);
 	} // ------ END 'for each latch' ---------------
+	if (incomplete)
+		markUndetectedLatchesUnknown(l_list);
 
 	if(sim_env)
 		delete sim_env;
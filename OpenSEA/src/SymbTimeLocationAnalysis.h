@@ -69,6 +69,13 @@ enum AnalysisMode {
 	bool analyze(vector<TestCase> &testcases);
 	void analyze();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief restricts the analysis to a subset of the latches
+///
+/// @param latches the latches to analyze (empty = all not excluded latches).
+	void setLatchesToCheck(const vector<unsigned>& latches);
+
 
 	protected:
 
@@ -110,6 +117,18 @@ enum AnalysisMode {
 
 // 0 = disabled, 1 = every iteration, 2 = every 2nd iteration, ...
 unsigned unsat_core_interval_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief returns the latches to analyze: latch_subset_, or all not excluded latches
+///
+/// @return the latches to analyze.
+	vector<unsigned> getLatchesToCheck();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief the latches to analyze, empty if all latches are analyzed
+	vector<unsigned> latch_subset_;
 	private:
 
 // -------------------------------------------------------------------------------------------
@@ -37,7 +37,7 @@ extern "C"
 // -------------------------------------------------------------------------------------------
 SymbolicSimulator::SymbolicSimulator(aiger* circuit, SatSolver* solver,
 		int& next_free_cnf_var_reference) :
-		circuit_(circuit), solver_(solver), next_free_cnf_var_(next_free_cnf_var_reference), cache_map_(0), cache_2sim_(0), time_index_(0)
+		circuit_(circuit), solver_(solver), next_free_cnf_var_(next_free_cnf_var_reference), cache_map_(0), cache_2sim_(0), and_mask_(0), and_mask_reference_(0), time_index_(0)
 {
 	results_.resize(circuit_->maxvar + 1);
 	results_[0] = CNF_FALSE; // FALSE and TRUE constants
@@ -86,6 +86,12 @@ void SymbolicSimulator::simulateOneTimeStep()
 	// Symbolic simulation of AND gates
 	for (unsigned b = 0; b < circuit_->num_ands; ++b)
 	{
+		if (and_mask_ != 0 && !(*and_mask_)[b]) // outside of the cone of influence
+		{
+			if (and_mask_reference_ != 0)
+				results_[(circuit_->ands[b].lhs >> 1)] = (*and_mask_reference_)[(circuit_->ands[b].lhs >> 1)];
+			continue;
+		}
 
 		int rhs1_cnf_value = Utils::readCnfValue(results_, circuit_->ands[b].rhs1);
 		int rhs0_cnf_value = Utils::readCnfValue(results_, circuit_->ands[b].rhs0);
@@ -359,6 +365,52 @@ int SymbolicSimulator::getResultValue(unsigned cnf_lit)
 	return results_[cnf_lit];
 }
 
+// -------------------------------------------------------------------------------------------
+void SymbolicSimulator::flipLatchIf(unsigned latch_cnf, int flip_lit)
+{
+	int old_value = results_[latch_cnf];
+	if (old_value == CNF_TRUE) // old value is true
+		results_[latch_cnf] = -flip_lit;
+	else if (old_value == CNF_FALSE) // old value is false
+		results_[latch_cnf] = flip_lit;
+	else
+	{
+		int new_value = next_free_cnf_var_++;
+		solver_->addVarToKeep(new_value);
+		// new_value == flip_lit ? -old_value : old_value
+		solver_->incAdd3LitClause(flip_lit, old_value, -new_value);
+		solver_->incAdd3LitClause(flip_lit, -old_value, new_value);
+		solver_->incAdd3LitClause(-flip_lit, old_value, new_value);
+		solver_->incAdd3LitClause(-flip_lit, -old_value, -new_value);
+		results_[latch_cnf] = new_value;
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+void SymbolicSimulator::flipLatchIf(unsigned latch_cnf, int flip_lit1, int flip_lit2)
+{
+	int old_value = results_[latch_cnf];
+	int new_value = next_free_cnf_var_++;
+	if (old_value == CNF_TRUE || old_value == CNF_FALSE)
+	{
+		// new_value == flip_lit1 AND flip_lit2
+		solver_->incAdd2LitClause(flip_lit1, -new_value);
+		solver_->incAdd2LitClause(flip_lit2, -new_value);
+		solver_->incAdd3LitClause(-flip_lit1, -flip_lit2, new_value);
+		results_[latch_cnf] = old_value == CNF_TRUE ? -new_value : new_value;
+		return;
+	}
+
+	// new_value == (flip_lit1 AND flip_lit2) ? -old_value : old_value
+	solver_->incAdd3LitClause(old_value, flip_lit1, -new_value);
+	solver_->incAdd3LitClause(old_value, flip_lit2, -new_value);
+	solver_->incAdd4LitClause(-old_value, -flip_lit1, -flip_lit2, -new_value);
+	solver_->incAdd3LitClause(-old_value, flip_lit1, new_value);
+	solver_->incAdd3LitClause(-old_value, flip_lit2, new_value);
+	solver_->incAdd4LitClause(old_value, -flip_lit1, -flip_lit2, new_value);
+	results_[latch_cnf] = new_value;
+}
+
 // -------------------------------------------------------------------------------------------
 void SymbolicSimulator::initLatches()
 {
@@ -388,6 +440,14 @@ void SymbolicSimulator::setCache(AndCacheFor2Simulators* cache)
 	cache_map_ = 0;
 }
 
+// -------------------------------------------------------------------------------------------
+void SymbolicSimulator::setAndMask(const vector<bool>* and_mask,
+		const vector<int>* reference_results)
+{
+	and_mask_ = and_mask;
+	and_mask_reference_ = reference_results;
+}
+
 // -------------------------------------------------------------------------------------------
 vector<int>& SymbolicSimulator::getResults()
 {
@@ -121,6 +121,28 @@ class SymbolicSimulator
 /// @return the value (=result) of the simulation for a given cnf variable
 	int getResultValue(unsigned cnf_lit);
 
+// -------------------------------------------------------------------------------------------
+//
+/// @brief flips the value of a latch if a literal is true (fault injection)
+///
+/// Adds a multiplexer new_value == flip_lit ? -old_value : old_value to the solver. Constant
+/// old values are folded, i.e., the latch then simply gets the value (-)flip_lit.
+///
+/// @param latch_cnf the cnf variable of the latch.
+/// @param flip_lit the literal which makes the latch flip.
+	void flipLatchIf(unsigned latch_cnf, int flip_lit);
+
+// -------------------------------------------------------------------------------------------
+//
+/// @brief flips the value of a latch if two literals are true (e.g., location and time)
+///
+/// Like flipLatchIf(unsigned, int), but flips iff (flip_lit1 AND flip_lit2).
+///
+/// @param latch_cnf the cnf variable of the latch.
+/// @param flip_lit1 the first literal of the flip condition.
+/// @param flip_lit2 the second literal of the flip condition.
+	void flipLatchIf(unsigned latch_cnf, int flip_lit1, int flip_lit2);
+
 // -------------------------------------------------------------------------------------------
 //
 /// @brief returns the value of the alarm output.
@@ -212,6 +234,18 @@ class SymbolicSimulator
 ///
 	void setCache(AndCacheFor2Simulators* cache);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief restricts the simulation to a subset of the AND gates (see ConeOfInfluence)
+///
+/// AND gates which are not set in the mask are not encoded. They either keep their current
+/// value, or get the value of the same AND gate in reference_results (typically the results
+/// of a fault-free SymbolicSimulator which has already simulated the current time-step).
+///
+/// @param and_mask the AND gates to simulate (index = position in circuit->ands), 0 = all
+/// @param reference_results the values for the skipped AND gates (0 = keep current values)
+	void setAndMask(const vector<bool>* and_mask, const vector<int>* reference_results = 0);
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief returns the full results-array which stores all the (intermediate) values for all
@@ -274,6 +308,16 @@ class SymbolicSimulator
 /// @brief If there is more than one SymbolicSimulator, an AndCache can be used
 	AndCacheFor2Simulators* cache_2sim_;
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief If not 0, only the AND gates set in this mask get simulated
+	const vector<bool>* and_mask_;
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief If not 0, the AND gates not set in and_mask_ get their values from here
+	const vector<int>* and_mask_reference_;
+
 // -------------------------------------------------------------------------------------------
 ///
 /// @brief Array storing the current values for each variable
@@ -54,6 +54,7 @@ int main(int argc, char *argv[])
 			"Back-End: " << Options::instance().getBackEndName() << ", mode = " << Options::instance().getBackEndMode());
 
 	error_analysis->analyze();
+	error_analysis->propagateCollapsedLatches();
 	error_analysis->printResults();
 
 	if (Options::instance().isUseLatchesResult())
@@ -31,6 +31,8 @@ extern "C" {
 #include "../src/BddAnalysis.h"
 #include "../src/SimulationBasedAnalysis.h"
 #include "../src/TestCaseProvider.h"
+#include "../src/BddVariableOrder.h"
+#include "../src/Options.h"
 
 #include <iostream>
 
@@ -451,3 +453,72 @@ void TestBdd::test7_analysis_compare_with_simulation_1()
 	compareWithSimulation("inputs/s5378.50percent.aag", 3, 5, 2,
 			0); // 164 Latches!
 }
+
+void TestBdd::test8_binary_encoding_w_variable_order()
+{
+	vector<int> modes;
+	modes.push_back(BddAnalysis::C_BINARY_ENCODING);
+	modes.push_back(BddAnalysis::C_F_BINARY);
+	modes.push_back(BddAnalysis::C_F_BINARY_FREE_INPUTS);
+
+	for (int heuristic = BddVariableOrder::FANIN_DFS;
+			heuristic <= BddVariableOrder::FANIN_DFS_F_FIRST; ++heuristic)
+	{
+		Options::instance().setBddVariableOrder(heuristic);
+		for (unsigned m_cnt = 0; m_cnt < modes.size(); ++m_cnt)
+		{
+			compareWithSimulation("inputs/toggle.2vulnerabilities.aag", 1, 2, 1, modes[m_cnt]);
+			compareWithSimulation("inputs/ex5.2vul.1l.aig", 5, 5, 1, modes[m_cnt]);
+			compareWithSimulation("inputs/beecount-synth.2vul.1l.aig", 2, 5, 1, modes[m_cnt]);
+			compareWithSimulation("inputs/traffic-synth.5vul.1l.aig", 5, 14, 1, modes[m_cnt]);
+		}
+	}
+	Options::instance().setBddVariableOrder(BddVariableOrder::CREATION);
+
+	// a node limit of 0 makes the hybrid mode continue every test-case with SAT from time-step 0
+	Options::instance().setHybridNodeLimit(0);
+	compareWithSimulation("inputs/toggle.2vulnerabilities.aag", 1, 2, 1, BddAnalysis::C_F_BINARY_HYBRID);
+	compareWithSimulation("inputs/ex5.2vul.1l.aig", 5, 5, 1, BddAnalysis::C_F_BINARY_HYBRID);
+	compareWithSimulation("inputs/beecount-synth.2vul.1l.aig", 2, 5, 1, BddAnalysis::C_F_BINARY_HYBRID);
+	compareWithSimulation("inputs/traffic-synth.5vul.1l.aig", 5, 14, 1, BddAnalysis::C_F_BINARY_HYBRID);
+	Options::instance().setHybridNodeLimit(100000);
+}
+
+void TestBdd::test9_partitions_equal_unpartitioned()
+{
+	vector<int> modes;
+	modes.push_back(BddAnalysis::C_ONE_HOT_ENCODING);
+	modes.push_back(BddAnalysis::C_BINARY_ENCODING);
+	modes.push_back(BddAnalysis::C_F_BINARY);
+
+	for (unsigned m_cnt = 0; m_cnt < modes.size(); ++m_cnt)
+	{
+		comparePartitionedWithUnpartitioned("inputs/toggle.2vulnerabilities.aag", 1, 2, 1, modes[m_cnt]);
+		comparePartitionedWithUnpartitioned("inputs/ex5.2vul.1l.aig", 5, 5, 1, modes[m_cnt]);
+		comparePartitionedWithUnpartitioned("inputs/beecount-synth.2vul.1l.aig", 2, 5, 1, modes[m_cnt]);
+		comparePartitionedWithUnpartitioned("inputs/traffic-synth.5vul.1l.aig", 5, 14, 1, modes[m_cnt]);
+	}
+}
+
+void TestBdd::comparePartitionedWithUnpartitioned(string path_to_aiger_circuit, int num_tc,
+		int num_timesteps, int num_err_latches, int mode)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+	CPPUNIT_ASSERT_MESSAGE("can not open " + path_to_aiger_circuit, circuit != 0);
+
+	srand(0xCAFECAFE);
+	TestCaseProvider::instance().setCircuit(circuit);
+	vector<TestCase> tcs = TestCaseProvider::instance().generateRandomTestCases(num_tc, num_timesteps);
+
+	BddAnalysis unpartitioned(circuit, num_err_latches, mode);
+	unpartitioned.analyze(tcs);
+	Options::instance().setBddPartitions(3);
+	BddAnalysis partitioned(circuit, num_err_latches, mode);
+	partitioned.analyze(tcs);
+	Options::instance().setBddPartitions(1);
+
+	bool equal = (unpartitioned.getDetectedLatches() == partitioned.getDetectedLatches());
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal);
+}
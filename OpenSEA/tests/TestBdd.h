@@ -45,6 +45,8 @@ class TestBdd : public CPPUNIT_NS::TestFixture
   CPPUNIT_TEST(test5_analysis_3latches);
   CPPUNIT_TEST(test6_analysis_w_1_extra_latch);
   CPPUNIT_TEST(test7_analysis_compare_with_simulation_1);
+  CPPUNIT_TEST(test8_binary_encoding_w_variable_order);
+  CPPUNIT_TEST(test9_partitions_equal_unpartitioned);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -83,6 +85,20 @@ protected:
   void test6_analysis_w_1_extra_latch();
   void test7_analysis_compare_with_simulation_1();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests the binary encoded modes with reordered latches, where the code of a latch
+///        is no longer its position in the circuit
+  void test8_binary_encoding_w_variable_order();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests that the latch groups of --bdd_partitions, each with its own BDD manager,
+///        detect the same latches as one analysis of all latches
+  void test9_partitions_equal_unpartitioned();
+  void comparePartitionedWithUnpartitioned(std::string path_to_aiger_circuit, int num_tc,
+      int num_timesteps, int num_err_latches, int mode);
+
 };
 
 #endif // CPP_UNIT_TestBdd_H__
@@ -28,6 +28,11 @@ extern "C" {
 #include "../src/DefinitelyProtected.h"
 #include "../src/Utils.h"
 #include "../src/Logger.h"
+#include "../src/SimulationBasedAnalysis.h"
+#include "../src/TestCaseProvider.h"
+#include "../src/Ic3.h"
+#include "../src/SatSolver.h"
+#include "../src/Options.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestDefinitelyProtected);
 
@@ -104,3 +109,261 @@ void TestDefinitelyProtected::test_multi_step()
 	aiger_reset(circuit);
 }
 
+void TestDefinitelyProtected::test_k_induction()
+{
+	const unsigned K_INDUCTION = 5;
+
+	aiger* circuit = Utils::readAiger("inputs/toggle.perfect.aag");
+	DefinitelyProtected dp(circuit, 0, K_INDUCTION);
+	dp.analyze();
+	CPPUNIT_ASSERT(dp.getDetectedLatches().size() == 4);
+	CPPUNIT_ASSERT(dp.getUnknownLatches().empty());
+	aiger_reset(circuit);
+
+	circuit = Utils::readAiger("inputs/toggle.1vulnerability.aag");
+	DefinitelyProtected dp_1vul(circuit, 0, K_INDUCTION);
+	dp_1vul.analyze();
+	CPPUNIT_ASSERT(dp_1vul.getDetectedLatches().size() == 3);
+	CPPUNIT_ASSERT(dp_1vul.getUnknownLatches().empty());
+	aiger_reset(circuit);
+
+	circuit = Utils::readAiger("inputs/toggle.3vulnerabilities.aag");
+	DefinitelyProtected dp_3vul(circuit, 0, K_INDUCTION);
+	dp_3vul.analyze();
+	CPPUNIT_ASSERT(dp_3vul.getDetectedLatches().size() == 0);
+	CPPUNIT_ASSERT(dp_3vul.getUnknownLatches().empty());
+	aiger_reset(circuit);
+
+	checkKInductionIsSound("inputs/toggle.2vulnerabilities.aag", 1);
+	checkKInductionIsSound("inputs/shiftreg.2vul.1l.aig", 1);
+	checkKInductionIsSound("inputs/ex5.2vul.1l.aig", 1);
+}
+
+void TestDefinitelyProtected::checkKInductionIsSound(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+	DefinitelyProtected dp(circuit, num_err_latches, 5);
+	dp.analyze();
+	checkProtectedAreNotVulnerable(circuit, num_err_latches, dp.getDetectedLatches(),
+			path_to_aiger_circuit);
+	aiger_reset(circuit);
+}
+
+void TestDefinitelyProtected::checkProtectedAreNotVulnerable(aiger* circuit, int num_err_latches,
+		const set<unsigned>& proven, string path_to_aiger_circuit)
+{
+	// a latch which is vulnerable in a simulation can not be protected
+	srand(0xCAFECAFE);
+	TestCaseProvider::instance().setCircuit(circuit);
+	vector<TestCase> tcs = TestCaseProvider::instance().generateRandomTestCases(5, 10);
+	SimulationBasedAnalysis sba(circuit, num_err_latches);
+	sba.analyze(tcs);
+	const set<unsigned> &vulnerable = sba.getDetectedLatches();
+
+	bool sound = true;
+	for (set<unsigned>::const_iterator it = proven.begin(); it != proven.end(); ++it)
+		sound = sound && vulnerable.count(*it) == 0;
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, sound);
+}
+
+void TestDefinitelyProtected::test_reachable_states()
+{
+	checkReachableStates("inputs/toggle.2vulnerabilities.aag", 1);
+	checkReachableStates("inputs/shiftreg.2vul.1l.aig", 1);
+	checkReachableStates("inputs/ex5.2vul.1l.aig", 1);
+	checkReachableStates("inputs/beecount-synth.2vul.1l.aig", 1);
+}
+
+void TestDefinitelyProtected::checkReachableStates(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+
+	DefinitelyProtected dp_all_states(circuit, num_err_latches, 1);
+	dp_all_states.analyze();
+	Options::instance().setDpReachability(true, 0);
+	DefinitelyProtected dp_exact(circuit, num_err_latches, 1);
+	dp_exact.analyze();
+	// a bound of 2 nodes makes BddReachability::compute() use RemapOverApprox()
+	Options::instance().setDpReachability(true, 2);
+	DefinitelyProtected dp_approx(circuit, num_err_latches, 1);
+	dp_approx.analyze();
+	DefinitelyProtected dp_kinduction(circuit, num_err_latches, 5);
+	dp_kinduction.analyze();
+	Options::instance().setDpReachability(false, 0);
+
+	const set<unsigned>& all_states = dp_all_states.getDetectedLatches();
+	const set<unsigned>& exact = dp_exact.getDetectedLatches();
+	const set<unsigned>& approx = dp_approx.getDetectedLatches();
+	bool monotonic = includes(exact.begin(), exact.end(), approx.begin(), approx.end())
+			&& includes(approx.begin(), approx.end(), all_states.begin(), all_states.end());
+
+	checkProtectedAreNotVulnerable(circuit, num_err_latches, exact, path_to_aiger_circuit);
+	checkProtectedAreNotVulnerable(circuit, num_err_latches, approx, path_to_aiger_circuit);
+	checkProtectedAreNotVulnerable(circuit, num_err_latches, dp_kinduction.getDetectedLatches(),
+			path_to_aiger_circuit);
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, monotonic);
+}
+
+void TestDefinitelyProtected::test_simultaneous_equals_single()
+{
+	compareSimultaneousWithSingle("inputs/toggle.2vulnerabilities.aag", 1);
+	compareSimultaneousWithSingle("inputs/iwls02texasa.2vul.1l.aag", 1);
+	compareSimultaneousWithSingle("inputs/ex5.2vul.2l.aig", 2);
+	compareSimultaneousWithSingle("inputs/beecount-synth.2vul.1l.aig", 1);
+	compareSimultaneousWithSingle("inputs/traffic-synth.5vul.1l.aig", 1);
+	compareSimultaneousWithSingle("inputs/s5378.50percent.aag", 2);
+}
+
+void TestDefinitelyProtected::compareSimultaneousWithSingle(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+
+	DefinitelyProtected dp_single(circuit, num_err_latches, 1);
+	dp_single.analyze();
+	DefinitelyProtected dp_simultaneous(circuit, num_err_latches, 2);
+	dp_simultaneous.analyze();
+
+	bool equal = (dp_single.getDetectedLatches() == dp_simultaneous.getDetectedLatches());
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal);
+}
+
+void TestDefinitelyProtected::test_threads_equal_single()
+{
+	compareThreadsWithSingle("inputs/toggle.2vulnerabilities.aag", 1);
+	compareThreadsWithSingle("inputs/iwls02texasa.2vul.1l.aag", 1);
+	compareThreadsWithSingle("inputs/ex5.2vul.2l.aig", 2);
+	compareThreadsWithSingle("inputs/beecount-synth.2vul.1l.aig", 1);
+	compareThreadsWithSingle("inputs/traffic-synth.5vul.1l.aig", 1);
+	compareThreadsWithSingle("inputs/s5378.50percent.aag", 2);
+}
+
+void TestDefinitelyProtected::compareThreadsWithSingle(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+
+	DefinitelyProtected dp_single(circuit, num_err_latches, 1);
+	dp_single.analyze();
+	Options::instance().setDpThreads(4);
+	DefinitelyProtected dp_threads(circuit, num_err_latches, 1);
+	dp_threads.analyze();
+	Options::instance().setDpThreads(1);
+
+	bool equal = (dp_single.getDetectedLatches() == dp_threads.getDetectedLatches());
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal);
+}
+
+void TestDefinitelyProtected::test_kstep_shared_gates()
+{
+	checkKStepResults("inputs/toggle.2vulnerabilities.aag", 1);
+	checkKStepResults("inputs/iwls02texasa.2vul.1l.aag", 1);
+	checkKStepResults("inputs/ex5.2vul.2l.aig", 2);
+	checkKStepResults("inputs/beecount-synth.2vul.1l.aig", 1);
+	checkKStepResults("inputs/traffic-synth.5vul.1l.aig", 1);
+}
+
+void TestDefinitelyProtected::checkKStepResults(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+
+	DefinitelyProtected dp_shared(circuit, num_err_latches, 3);
+	dp_shared.analyze();
+	Options::instance().setDpShareGates(false);
+	DefinitelyProtected dp_unshared(circuit, num_err_latches, 3);
+	dp_unshared.analyze();
+	Options::instance().setDpShareGates(true);
+	bool equal = (dp_shared.getDetectedLatches() == dp_unshared.getDetectedLatches());
+
+	// a shared gate which hides a difference would turn vulnerable latches into protected ones
+	checkProtectedAreNotVulnerable(circuit, num_err_latches, dp_shared.getDetectedLatches(),
+			path_to_aiger_circuit);
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal);
+}
+
+aiger* TestDefinitelyProtected::createSmallMiter()
+{
+	aiger* miter = aiger_init();
+	aiger_add_input(miter, 2, "c0");
+	aiger_add_input(miter, 4, "c1");
+	aiger_add_input(miter, 6, "i");
+
+	// both copies load i, the faulty copy of the selected latch may become true instead
+	aiger_add_and(miter, 16, aiger_not(6), aiger_not(2));
+	aiger_add_and(miter, 18, aiger_not(6), aiger_not(4));
+	aiger_add_latch(miter, 8, 6, "x");
+	aiger_add_latch(miter, 10, aiger_not(16), "x_faulty");
+	aiger_add_latch(miter, 12, 6, "y");
+	aiger_add_latch(miter, 14, aiger_not(18), "y_faulty");
+
+	// bad: the observed latch x differs in both copies (y is not observed)
+	aiger_add_and(miter, 20, 8, aiger_not(10));
+	aiger_add_and(miter, 22, aiger_not(8), 10);
+	aiger_add_and(miter, 24, aiger_not(20), aiger_not(22));
+	aiger_add_output(miter, aiger_not(24), "bad");
+
+	return miter;
+}
+
+void TestDefinitelyProtected::test_ic3_small_miter()
+{
+	aiger* miter = createSmallMiter();
+
+	// latch x: a flip raises 'bad'
+	SatSolver* solver_c0 = Options::instance().getSATSolver();
+	Ic3 ic3_c0(miter, solver_c0);
+	ic3_c0.constrainInput(2, true);
+	CPPUNIT_ASSERT(ic3_c0.check() == Ic3::UNSAFE);
+
+	// latch y: a flip is never observed
+	SatSolver* solver_c1 = Options::instance().getSATSolver();
+	Ic3 ic3_c1(miter, solver_c1);
+	ic3_c1.constrainInput(2, false);
+	ic3_c1.constrainInput(4, true);
+	CPPUNIT_ASSERT(ic3_c1.check() == Ic3::SAFE);
+
+	delete solver_c0;
+	delete solver_c1;
+	aiger_reset(miter);
+}
+
+void TestDefinitelyProtected::test_ic3_assumptions()
+{
+	aiger* miter = createSmallMiter();
+	SatSolver* solver = Options::instance().getSATSolver();
+	Ic3 ic3(miter, solver);
+
+	vector<unsigned> select_x;
+	select_x.push_back(2);
+	vector<unsigned> select_y;
+	select_y.push_back(aiger_not(2));
+	select_y.push_back(4);
+
+	ic3.setInputAssumptions(select_x);
+	CPPUNIT_ASSERT(ic3.check() == Ic3::UNSAFE);
+	ic3.setInputAssumptions(select_y);
+	CPPUNIT_ASSERT(ic3.check() == Ic3::SAFE);
+
+	// the lemmas which needed -c0 must not survive the change of the assumptions
+	ic3.setInputAssumptions(select_x);
+	CPPUNIT_ASSERT(ic3.check() == Ic3::UNSAFE);
+
+	// without assumptions, c0 is free
+	ic3.setInputAssumptions(vector<unsigned>());
+	CPPUNIT_ASSERT(ic3.check() == Ic3::UNSAFE);
+
+	delete solver;
+	aiger_reset(miter);
+}
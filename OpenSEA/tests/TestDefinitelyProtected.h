@@ -25,6 +25,10 @@
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
+#include "../src/defines.h"
+
+struct aiger;
+
 
 // -------------------------------------------------------------------------------------------
 ///
@@ -38,6 +42,13 @@ class TestDefinitelyProtected : public CPPUNIT_NS::TestFixture
   CPPUNIT_TEST_SUITE(TestDefinitelyProtected);
   CPPUNIT_TEST(test1);
   CPPUNIT_TEST(test_multi_step);
+  CPPUNIT_TEST(test_k_induction);
+  CPPUNIT_TEST(test_reachable_states);
+  CPPUNIT_TEST(test_simultaneous_equals_single);
+  CPPUNIT_TEST(test_threads_equal_single);
+  CPPUNIT_TEST(test_kstep_shared_gates);
+  CPPUNIT_TEST(test_ic3_small_miter);
+  CPPUNIT_TEST(test_ic3_assumptions);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -63,6 +74,68 @@ protected:
   void test1();
   void test_multi_step();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests the verdicts of the k-induction mode (5): the toggle circuits get the same
+///        verdicts as in test1(), and no proven latch is vulnerable in a simulation.
+  void test_k_induction();
+  void checkKInductionIsSound(string path_to_aiger_circuit, int num_err_latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests the reachable states constraint (--dp_reach): the exact and the
+///        over-approximated states prove at least the latches of a run without them, the
+///        exact ones at least those of the over-approximation, and all verdicts are sound.
+  void test_reachable_states();
+  void checkReachableStates(string path_to_aiger_circuit, int num_err_latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief asserts that no latch proven protected is vulnerable in a simulation of 5 random
+///        test-cases of 10 time steps
+  void checkProtectedAreNotVulnerable(aiger* circuit, int num_err_latches,
+      const set<unsigned>& proven, string path_to_aiger_circuit);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests that mode 2, which refutes several latches per SAT call, finds the same
+///        protected latches as mode 1, which checks one latch after the other
+  void test_simultaneous_equals_single();
+  void compareSimultaneousWithSingle(string path_to_aiger_circuit, int num_err_latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests that mode 1 with --dp_threads, where every thread checks its latches with its
+///        own solver, finds the same protected latches as the single-threaded mode 1
+  void test_threads_equal_single();
+  void compareThreadsWithSingle(string path_to_aiger_circuit, int num_err_latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests that the k-step mode 3, where the faulty copy shares the AND gates without a
+///        difference to the fault-free copy, agrees with mode 3 without the sharing
+///        (--dp_no_sharing) and with a simulation
+  void test_kstep_shared_gates();
+  void checkKStepResults(string path_to_aiger_circuit, int num_err_latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests the Ic3 engine on a small miter: the flip selected by c0 is observable
+///        (UNSAFE), the one selected by c1 is masked (SAFE)
+  void test_ic3_small_miter();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests several checks of the small miter in one Ic3 session, the flipped latch is
+///        selected by assumptions (as alarmToMC --ic3 does)
+  void test_ic3_assumptions();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief creates a small miter like AlarmToMC does: inputs c0 (2), c1 (4), i (6), the
+///        fault-free latches 8 and 12, the faulty copies 10 and 14 and the bad output
+  aiger* createSmallMiter();
+
 };
 
 #endif // CPP_UNIT_TestDefinitelyProtected_H__
@@ -24,6 +24,7 @@
 #include "../src/Logger.h"
 #include "../src/defines.h"
 #include "../src/TestCaseProvider.h"
+#include "../src/Options.h"
 
 
 extern "C"
@@ -174,18 +175,36 @@ void TestFalsePositives::test6_irrelevant_latches_delayOneTimestep()
 	checkIrrelevantLatchesDelayOneTraces(falsepos.getSuperfluous());
 	CPPUNIT_ASSERT(falsepos.findFalsePositives_2b_free_inputs(tcs));
 	checkIrrelevantLatchesDelayOneTraces(falsepos.getSuperfluous());
+
+	// a long test-case: every flip time step must still be found exactly once
+	tcs.clear();
+	Utils::generateRandomTestCases(tcs,1,30,circuit->num_inputs);
+	CPPUNIT_ASSERT(falsepos.findFalsePositives_1b(tcs));
+	checkIrrelevantLatchesDelayOneTraces(falsepos.getSuperfluous(), 30);
+	CPPUNIT_ASSERT(falsepos.findFalsePositives_2b(tcs));
+	checkIrrelevantLatchesDelayOneTraces(falsepos.getSuperfluous(), 30);
+	CPPUNIT_ASSERT(falsepos.findFalsePositives_1b_free_inputs(tcs));
+	checkIrrelevantLatchesDelayOneTraces(falsepos.getSuperfluous(), 30);
+	CPPUNIT_ASSERT(falsepos.findFalsePositives_2b_free_inputs(tcs));
+	checkIrrelevantLatchesDelayOneTraces(falsepos.getSuperfluous(), 30);
 	aiger_reset(circuit);
 
 }
 
-void TestFalsePositives::checkIrrelevantLatchesDelayOneTraces(vector<SuperfluousTrace*> sftrace)
+void TestFalsePositives::checkIrrelevantLatchesDelayOneTraces(vector<SuperfluousTrace*> sftrace,
+		unsigned num_timesteps)
 {
-	CPPUNIT_ASSERT(sftrace.size() == 25);
+	// the error must be gone within the test-case: latch 42 can be flipped in every time step,
+	// latches 6, 8 and 34 in all but the last one, and latch 4 in all but the last two
+	CPPUNIT_ASSERT(sftrace.size() == 5 * num_timesteps - 5);
 
+	set<pair<unsigned, unsigned> > flips; // (latch, flip time step)
 	for(vector<SuperfluousTrace*>::iterator it = sftrace.begin(); it != sftrace.end(); ++it)
 	{
 
 		SuperfluousTrace* trace = *it;
+		CPPUNIT_ASSERT(flips.insert(make_pair(trace->component_, trace->flip_timestep_)).second);
+		CPPUNIT_ASSERT(trace->error_gone_timestep_ <= num_timesteps);
 
 		if(trace->component_ < 42)
 			CPPUNIT_ASSERT(trace->alarm_timestep_ == trace->flip_timestep_ + 1);
@@ -296,3 +315,125 @@ void TestFalsePositives::test8_environment_input_model()
 	aiger_reset(circuit);
 	aiger_reset(environment);
 }
+
+// the concrete simulation of further flip time steps in findFalsePositives_1b() must find
+// exactly the traces the SAT-solver finds on its own with the same (concrete) test-cases
+void TestFalsePositives::test9_amplified_traces_equal_sat_traces()
+{
+	compareAmplifiedWithSatTraces("inputs/irrelevant_latches.prot.delay1.aag", 0);
+	compareAmplifiedWithSatTraces("inputs/irrelevant_latches.prot.aag", 0);
+	compareAmplifiedWithSatTraces("inputs/shiftreg.2vul.1l.aig", 1);
+	compareAmplifiedWithSatTraces("inputs/ex5.2vul.1l.aig", 1);
+	compareAmplifiedWithSatTraces("inputs/beecount-synth.2vul.1l.aig", 1);
+}
+
+void TestFalsePositives::compareAmplifiedWithSatTraces(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+	FalsePositives falsepos(circuit, num_err_latches);
+
+	srand(0xCAFECAFE);
+	vector<TestCase> tcs;
+	Utils::generateRandomTestCases(tcs, 3, 8, circuit->num_inputs);
+
+	// the traces are freed by the next run, so only their keys are kept
+	falsepos.findFalsePositives_1b(tcs);
+	multiset<string> amplified = getTraceKeys(falsepos.getSuperfluous());
+	falsepos.findFalsePositives_1b_free_inputs(tcs);
+	multiset<string> sat_only = getTraceKeys(falsepos.getSuperfluous());
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, amplified == sat_only);
+}
+
+// each time step is a single query under one assumption, so long test-cases must not change
+// the traces: all four variants have to agree on them
+void TestFalsePositives::test10_variants_agree_on_long_testcases()
+{
+	compareVariants("inputs/irrelevant_latches.prot.delay1.aag", 0, 30);
+	compareVariants("inputs/irrelevant_latches.prot.aag", 0, 30);
+	compareVariants("inputs/shiftreg.2vul.1l.aig", 1, 20);
+	compareVariants("inputs/ex5.2vul.1l.aig", 1, 20);
+	compareVariants("inputs/beecount-synth.2vul.1l.aig", 1, 20);
+}
+
+void TestFalsePositives::compareVariants(string path_to_aiger_circuit, int num_err_latches,
+		int num_timesteps)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+	FalsePositives falsepos(circuit, num_err_latches);
+
+	srand(0xCAFECAFE);
+	vector<TestCase> tcs;
+	Utils::generateRandomTestCases(tcs, 2, num_timesteps, circuit->num_inputs);
+
+	falsepos.findFalsePositives_1b(tcs);
+	multiset<string> traces_1b = getTraceKeys(falsepos.getSuperfluous());
+	falsepos.findFalsePositives_2b(tcs);
+	multiset<string> traces_2b = getTraceKeys(falsepos.getSuperfluous());
+	falsepos.findFalsePositives_1b_free_inputs(tcs);
+	multiset<string> traces_1b_free = getTraceKeys(falsepos.getSuperfluous());
+	falsepos.findFalsePositives_2b_free_inputs(tcs);
+	multiset<string> traces_2b_free = getTraceKeys(falsepos.getSuperfluous());
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, traces_1b == traces_2b);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, traces_1b == traces_1b_free);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, traces_1b == traces_2b_free);
+}
+
+// --fp_threads analyzes groups of latches in parallel; the merged traces must be those of a
+// sequential run, in the same order
+void TestFalsePositives::test11_threads_equal_sequential_run()
+{
+	for (int mode = FalsePositives::SYMB_TIME; mode <= FalsePositives::SYMB_TIME_LOCATION; ++mode)
+	{
+		compareThreadsWithSequentialRun("inputs/irrelevant_latches.prot.delay1.aag", 0, mode);
+		compareThreadsWithSequentialRun("inputs/shiftreg.2vul.1l.aig", 1, mode);
+		compareThreadsWithSequentialRun("inputs/ex5.2vul.1l.aig", 1, mode);
+		compareThreadsWithSequentialRun("inputs/beecount-synth.2vul.1l.aig", 1, mode);
+	}
+}
+
+void TestFalsePositives::compareThreadsWithSequentialRun(string path_to_aiger_circuit,
+		int num_err_latches, int mode)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+	FalsePositives falsepos(circuit, num_err_latches, false, mode);
+
+	srand(0xCAFECAFE);
+	vector<TestCase> tcs;
+	Utils::generateRandomTestCases(tcs, 3, 8, circuit->num_inputs);
+
+	falsepos.analyze(tcs);
+	vector<string> sequential = getTraceSequence(falsepos.getSuperfluous());
+	set<unsigned> sequential_detected = falsepos.getDetectedLatches();
+
+	Options::instance().setFpThreads(4);
+	FalsePositives threaded(circuit, num_err_latches, false, mode);
+	threaded.analyze(tcs);
+	Options::instance().setFpThreads(1);
+	vector<string> parallel = getTraceSequence(threaded.getSuperfluous());
+	set<unsigned> parallel_detected = threaded.getDetectedLatches();
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, sequential == parallel);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, sequential_detected == parallel_detected);
+}
+
+vector<string> TestFalsePositives::getTraceSequence(const vector<SuperfluousTrace*> &sftrace)
+{
+	vector<string> keys;
+	for (vector<SuperfluousTrace*>::const_iterator it = sftrace.begin(); it != sftrace.end(); ++it)
+		keys.push_back((*it)->toString());
+	return keys;
+}
+
+multiset<string> TestFalsePositives::getTraceKeys(const vector<SuperfluousTrace*> &sftrace)
+{
+	multiset<string> keys;
+	for (vector<SuperfluousTrace*>::const_iterator it = sftrace.begin(); it != sftrace.end(); ++it)
+		keys.insert((*it)->toString());
+	return keys;
+}
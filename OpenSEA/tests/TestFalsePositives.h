@@ -49,6 +49,9 @@ class TestFalsePositives : public CPPUNIT_NS::TestFixture
   CPPUNIT_TEST(test6_irrelevant_latches_delayOneTimestep);
   CPPUNIT_TEST(test7_free_inputs);
   CPPUNIT_TEST(test8_environment_input_model);
+  CPPUNIT_TEST(test9_amplified_traces_equal_sat_traces);
+  CPPUNIT_TEST(test10_variants_agree_on_long_testcases);
+  CPPUNIT_TEST(test11_threads_equal_sequential_run);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -72,10 +75,19 @@ protected:
   void test4();
   void test5_irrelevant_latches();
   void test6_irrelevant_latches_delayOneTimestep();
-  void checkIrrelevantLatchesDelayOneTraces(vector<SuperfluousTrace*> sftrace);
+  void checkIrrelevantLatchesDelayOneTraces(vector<SuperfluousTrace*> sftrace,
+      unsigned num_timesteps = 6);
   void test7_free_inputs();
   void checkTest7Traces(vector<SuperfluousTrace*> sftrace);
   void test8_environment_input_model();
+  void test9_amplified_traces_equal_sat_traces();
+  void compareAmplifiedWithSatTraces(string path_to_aiger_circuit, int num_err_latches);
+  void test10_variants_agree_on_long_testcases();
+  void compareVariants(string path_to_aiger_circuit, int num_err_latches, int num_timesteps);
+  void test11_threads_equal_sequential_run();
+  void compareThreadsWithSequentialRun(string path_to_aiger_circuit, int num_err_latches, int mode);
+  multiset<string> getTraceKeys(const vector<SuperfluousTrace*> &sftrace);
+  vector<string> getTraceSequence(const vector<SuperfluousTrace*> &sftrace);
 
 };
 
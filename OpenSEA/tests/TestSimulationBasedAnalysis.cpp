@@ -25,6 +25,11 @@
 #include "TestSimulationBasedAnalysis.h"
 #include "../src/Logger.h"
 #include "../src/TestCaseProvider.h"
+#include "../src/SymbTimeAnalysis.h" // for comparison
+#include "../src/FaultCollapsing.h"
+#include "../src/FalsePositives.h"
+#include "../src/ErrorTraceManager.h"
+#include "../src/Options.h"
 
 extern "C"
 {
@@ -144,3 +149,198 @@ void TestSimulationBasedAnalysis::test2_simulation_analysis_w_2_extra_latch()
 	checkVulnerabilities("inputs/toggle2l.aag", tc_files, should_be_vulnerable,
 			1);
 }
+
+// -------------------------------------------------------------------------------------------
+void TestSimulationBasedAnalysis::compareWithSymbTime(string path_to_aiger_circuit,
+		int num_tc, int num_timesteps, int num_err_latches)
+{
+	aiger* circuit = readAigerFile(path_to_aiger_circuit);
+
+	srand(0xCAFECAFE);
+	TestCaseProvider::instance().setCircuit(circuit);
+	vector<TestCase> tcs = TestCaseProvider::instance().generateRandomTestCases(num_tc, num_timesteps);
+
+	SimulationBasedAnalysis sba(circuit, num_err_latches);
+	sba.analyze(tcs);
+	SymbTimeAnalysis sta(circuit, num_err_latches, SymbTimeAnalysis::SYMBOLIC_SIMULATION);
+	sta.analyze(tcs);
+
+	bool equal = (sba.getDetectedLatches() == sta.getDetectedLatches());
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestSimulationBasedAnalysis::test3_convergence_check()
+{
+	// test cases with a single time step: the flip happens in the last time step, there is
+	// no fault-free successor state to compare with
+	compareWithSymbTime("inputs/toggle.1vulnerability.aag", 5, 1, 1);
+	compareWithSymbTime("inputs/toggle.3vulnerabilities.aag", 5, 1, 0);
+	compareWithSymbTime("inputs/s27.1vul.1l", 5, 1, 1);
+
+	// toggling and shifting latches: the flipped state often equals the fault-free state of
+	// the following time step, which must not be mistaken for convergence
+	compareWithSymbTime("inputs/toggle.perfect.aag", 3, 6, 1);
+	compareWithSymbTime("inputs/toggle.2vulnerabilities.aag", 3, 6, 1);
+	compareWithSymbTime("inputs/toggle2l.aag", 3, 6, 1);
+	compareWithSymbTime("inputs/shiftreg.2vul.1l.aig", 3, 8, 1);
+	compareWithSymbTime("inputs/shiftreg.3vul.0l.aig", 3, 8, 0);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestSimulationBasedAnalysis::checkCollapsedClasses(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = readAigerFile(path_to_aiger_circuit);
+
+	vector<unsigned> latches;
+	for (unsigned l_cnt = 0; l_cnt < circuit->num_latches - num_err_latches; ++l_cnt)
+		latches.push_back(circuit->latches[l_cnt].lit);
+
+	FaultCollapsing collapsing(circuit);
+	collapsing.computeClasses(latches);
+
+	// every latch is either a representative or a member of exactly one class
+	const vector<unsigned> &representatives = collapsing.getRepresentatives();
+	set<unsigned> covered(representatives.begin(), representatives.end());
+	unsigned num_latches = representatives.size();
+	for (unsigned r_cnt = 0; r_cnt < representatives.size(); ++r_cnt)
+	{
+		const vector<unsigned> &members = collapsing.getClassMembers(representatives[r_cnt]);
+		covered.insert(members.begin(), members.end());
+		num_latches += members.size();
+	}
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit,
+			covered.size() == latches.size() && num_latches == latches.size());
+
+	// analyzing all latches gives the same result as propagating the representatives' verdict
+	srand(0xCAFECAFE);
+	TestCaseProvider::instance().setCircuit(circuit);
+	vector<TestCase> tcs = TestCaseProvider::instance().generateRandomTestCases(5, 6);
+	SimulationBasedAnalysis sba(circuit, num_err_latches);
+	sba.analyze(tcs);
+	const set<unsigned> &vulnerabilities = sba.getDetectedLatches();
+
+	set<unsigned> propagated;
+	for (unsigned r_cnt = 0; r_cnt < representatives.size(); ++r_cnt)
+	{
+		if (vulnerabilities.count(representatives[r_cnt]))
+			propagated.insert(representatives[r_cnt]);
+	}
+	collapsing.propagateVerdict(propagated);
+
+	bool equal = (propagated == vulnerabilities);
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestSimulationBasedAnalysis::test4_collapsed_classes()
+{
+	checkCollapsedClasses("inputs/shiftreg.2vul.1l.aig", 1);
+	checkCollapsedClasses("inputs/shiftreg.3vul.0l.aig", 0);
+	checkCollapsedClasses("inputs/toggle.2vulnerabilities.aag", 1);
+	checkCollapsedClasses("inputs/toggle2l.aag", 1);
+	checkCollapsedClasses("inputs/duplicated_regs.aag", 0);
+	checkPropagatedResults("inputs/duplicated_regs.aag", 0);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestSimulationBasedAnalysis::checkPropagatedResults(string path_to_aiger_circuit,
+		int num_err_latches)
+{
+	aiger* circuit = readAigerFile(path_to_aiger_circuit);
+	map<unsigned, unsigned> latch_to_idx;
+	for (unsigned l_cnt = 0; l_cnt < circuit->num_latches; ++l_cnt)
+		latch_to_idx[circuit->latches[l_cnt].lit] = l_cnt;
+
+	srand(0xCAFECAFE);
+	TestCaseProvider::instance().setCircuit(circuit);
+	vector<TestCase> tcs = TestCaseProvider::instance().generateRandomTestCases(5, 6);
+
+	// reference: all latches analyzed
+	SimulationBasedAnalysis sba(circuit, num_err_latches);
+	sba.analyze(tcs);
+	set<unsigned> vulnerabilities = sba.getDetectedLatches();
+	FalsePositives falsepos(circuit, num_err_latches);
+	falsepos.analyze(tcs);
+	set<unsigned> false_positives = falsepos.getDetectedLatches();
+
+	Options::instance().setFaultCollapsing(circuit, 1);
+	Options::instance().setUseDiagnosticOutput(true);
+	vector<ErrorTrace*>& error_traces = ErrorTraceManager::instance().error_traces_;
+	unsigned num_old_traces = error_traces.size();
+
+	// the duplicated registers must form a class with members
+	vector<unsigned> representatives =
+			Options::instance().removeExcludedLatches(circuit, num_err_latches);
+	FaultCollapsing* collapsing = Options::instance().getFaultCollapsing();
+	map<unsigned, unsigned> member_to_representative;
+	for (unsigned r_cnt = 0; r_cnt < representatives.size(); ++r_cnt)
+	{
+		const vector<unsigned>& members = collapsing->getClassMembers(representatives[r_cnt]);
+		for (unsigned m_cnt = 0; m_cnt < members.size(); ++m_cnt)
+			member_to_representative[members[m_cnt]] = representatives[r_cnt];
+	}
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, !member_to_representative.empty());
+
+	// BackEnd::propagateCollapsedLatches(): verdicts and error traces
+	SimulationBasedAnalysis collapsed_sba(circuit, num_err_latches);
+	collapsed_sba.analyze(tcs);
+	collapsed_sba.propagateCollapsedLatches();
+	bool equal_vulnerabilities = (collapsed_sba.getDetectedLatches() == vulnerabilities);
+	set<unsigned> traced_latches;
+	for (unsigned t_cnt = num_old_traces; t_cnt < error_traces.size(); ++t_cnt)
+		traced_latches.insert(error_traces[t_cnt]->latch_index_);
+	bool members_traced = true;
+	bool some_member_traced = false;
+	for (map<unsigned, unsigned>::iterator it = member_to_representative.begin();
+			it != member_to_representative.end(); ++it)
+	{
+		if (vulnerabilities.count(it->first) && !traced_latches.count(it->first))
+			members_traced = false;
+		if (traced_latches.count(it->first))
+			some_member_traced = true;
+	}
+	for (unsigned t_cnt = num_old_traces; t_cnt < error_traces.size(); ++t_cnt)
+		delete error_traces[t_cnt];
+	error_traces.resize(num_old_traces);
+	Options::instance().setUseDiagnosticOutput(false);
+
+	// FalsePositives::propagateCollapsedLatches(): verdicts and superfluous traces
+	FalsePositives collapsed_falsepos(circuit, num_err_latches);
+	collapsed_falsepos.analyze(tcs);
+	collapsed_falsepos.propagateCollapsedLatches();
+	bool equal_false_positives = (collapsed_falsepos.getDetectedLatches() == false_positives);
+	map<unsigned, unsigned> num_traces_of_latch;
+	bool correct_indices = true;
+	vector<SuperfluousTrace*> superfluous = collapsed_falsepos.getSuperfluous();
+	for (unsigned t_cnt = 0; t_cnt < superfluous.size(); ++t_cnt)
+	{
+		num_traces_of_latch[superfluous[t_cnt]->component_]++;
+		if (superfluous[t_cnt]->component_index_ != (int) latch_to_idx[superfluous[t_cnt]->component_])
+			correct_indices = false;
+	}
+	bool members_have_traces = true;
+	bool some_member_has_traces = false;
+	for (map<unsigned, unsigned>::iterator it = member_to_representative.begin();
+			it != member_to_representative.end(); ++it)
+	{
+		if (num_traces_of_latch[it->first] != num_traces_of_latch[it->second])
+			members_have_traces = false;
+		if (num_traces_of_latch[it->first] != 0)
+			some_member_has_traces = true;
+	}
+	Options::instance().setFaultCollapsing(0, 0);
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal_vulnerabilities);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, members_traced && some_member_traced);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal_false_positives);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, correct_indices);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, members_have_traces);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, some_member_has_traces);
+}
@@ -47,6 +47,8 @@ class TestSimulationBasedAnalysis : public CPPUNIT_NS::TestFixture
   CPPUNIT_TEST_SUITE(TestSimulationBasedAnalysis);
   CPPUNIT_TEST(test1_simulation_analysis_w_1_extra_latch);
   CPPUNIT_TEST(test2_simulation_analysis_w_2_extra_latch);
+  CPPUNIT_TEST(test3_convergence_check);
+  CPPUNIT_TEST(test4_collapsed_classes);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -65,6 +67,12 @@ public:
 
   void checkVulnerabilities(string path_to_aiger_circuit, vector<string> tc_files, set<unsigned> should_be_vulnerable, int num_err_latches);
 
+  void compareWithSymbTime(string path_to_aiger_circuit, int num_tc, int num_timesteps, int num_err_latches);
+
+  void checkCollapsedClasses(string path_to_aiger_circuit, int num_err_latches);
+
+  void checkPropagatedResults(string path_to_aiger_circuit, int num_err_latches);
+
 protected:
 
 // -------------------------------------------------------------------------------------------
@@ -77,6 +85,18 @@ protected:
 /// @brief Tests the found vulnerabilities of a circuit, which is protected with 2 extra latches
   void test2_simulation_analysis_w_2_extra_latch();
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests that a flip replay stops only if the faulty next state equals the fault-free
+///        one, also on the last time step of a test case
+  void test3_convergence_check();
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief Tests that the members of a fault collapsing class get the verdict and the traces of
+///        their representative
+  void test4_collapsed_classes();
+
 };
 
 #endif // CPP_UNIT_TestSimulationBasedAnalysis_H__
@@ -27,6 +27,11 @@
 #include "../src/Utils.h"
 #include "../src/Logger.h"
 #include "../src/TestCaseProvider.h"
+#include "../src/ConeOfInfluence.h"
+#include "../src/SymbolicSimulator.h"
+#include "../src/AndCacheMap.h"
+#include "../src/SatSolver.h"
+#include "../src/Options.h"
 
 extern "C"
 {
@@ -265,3 +270,83 @@ void TestSymbTimeAnalysis::test10_symbolic_simulation_compare_w_simulation()
 	compareWithSimulation("inputs/s27.1vul.1l", 2, 1, 1,
 			SymbTimeAnalysis::SYMBOLIC_SIMULATION);
 }
+
+// -------------------------------------------------------------------------------------------
+void TestSymbTimeAnalysis::checkConeOfInfluence(string path_to_aiger_circuit,
+		int num_timesteps, int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+	CPPUNIT_ASSERT_MESSAGE("can not open " + path_to_aiger_circuit, circuit != 0);
+
+	srand(0xCAFECAFE);
+	TestCaseProvider::instance().setCircuit(circuit);
+	TestCase testcase = TestCaseProvider::instance().generateRandomTestCases(1, num_timesteps)[0];
+
+	SatSolver* solver = Options::instance().getSATSolver();
+	ConeOfInfluence coi(circuit);
+	bool equal = true;
+
+	for (unsigned l_cnt = 0; l_cnt < circuit->num_latches - num_err_latches && equal; ++l_cnt)
+	{
+		unsigned latch_aig = circuit->latches[l_cnt].lit;
+
+		vector<int> vars_to_keep;
+		vars_to_keep.push_back(1); // TRUE and FALSE literals
+		solver->startIncrementalSession(vars_to_keep, 0);
+		solver->incAddUnitClause(CNF_TRUE);
+
+		// the fault-free copy, a complete faulty copy and a faulty copy restricted to the cone
+		// of influence. The shared cache gives equal AND gates the same literal.
+		int next_free_cnf_var = 2;
+		SymbolicSimulator sim_ok(circuit, solver, next_free_cnf_var);
+		SymbolicSimulator sim_full(circuit, solver, next_free_cnf_var);
+		SymbolicSimulator sim_masked(circuit, solver, next_free_cnf_var);
+		AndCacheMap cache(solver);
+		sim_ok.setCache(&cache);
+		sim_full.setCache(&cache);
+		sim_masked.setCache(&cache);
+		sim_ok.initLatches();
+		sim_full.initLatches();
+		sim_masked.initLatches();
+
+		coi.setFlippedLatch(latch_aig);
+		sim_masked.setAndMask(&coi.getAndMask(), &sim_ok.getResults());
+
+		// the flip is symbolic, so the whole forward cone depends on it
+		int flip = next_free_cnf_var++;
+		solver->addVarToKeep(flip);
+		sim_full.flipLatchIf(latch_aig >> 1, flip);
+		sim_masked.flipLatchIf(latch_aig >> 1, flip);
+
+		for (unsigned timestep = 0; timestep < testcase.size() && equal; ++timestep)
+		{
+			sim_ok.simulateOneTimeStep(testcase[timestep]);
+			sim_full.simulateOneTimeStep(testcase[timestep]);
+			sim_masked.simulateOneTimeStep(testcase[timestep]);
+
+			equal = sim_full.getOutputValues() == sim_masked.getOutputValues()
+					&& sim_full.getNextLatchValues() == sim_masked.getNextLatchValues();
+
+			sim_ok.switchToNextState();
+			sim_full.switchToNextState();
+			sim_masked.switchToNextState();
+			coi.extendToNextStep();
+		}
+	}
+
+	delete solver;
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, equal);
+}
+
+// -------------------------------------------------------------------------------------------
+void TestSymbTimeAnalysis::test11_cone_of_influence_mask()
+{
+	checkConeOfInfluence("inputs/toggle.1vulnerability.aag", 4, 1);
+	checkConeOfInfluence("inputs/shiftreg.2vul.1l.aig", 8, 1);
+	checkConeOfInfluence("inputs/irrelevant_latches.prot.aag", 6, 0);
+	checkConeOfInfluence("inputs/iwls02texasa.2vul.1l.aag", 5, 1);
+	checkConeOfInfluence("inputs/ex5.2vul.2l.aig", 5, 2);
+	checkConeOfInfluence("inputs/beecount-synth.2vul.1l.aig", 5, 1);
+}
@@ -47,6 +47,7 @@ class TestSymbTimeAnalysis: public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST (test7_compare_with_simulation_1);
 	CPPUNIT_TEST (test8_symbolic_simulation_basic);
 	CPPUNIT_TEST (test10_symbolic_simulation_compare_w_simulation);
+	CPPUNIT_TEST (test11_cone_of_influence_mask);
 //	CPPUNIT_TEST (test7_analysis_big_w_random_inputs);
 	CPPUNIT_TEST_SUITE_END();
 
@@ -68,6 +69,8 @@ class TestSymbTimeAnalysis: public CPPUNIT_NS::TestFixture
 
 	void compareWithSimulation(string path_to_aiger_circuit, int num_tc, int num_timesteps, int num_err_latches, int mode = SymbTimeAnalysis::NAIVE);
 
+	void checkConeOfInfluence(string path_to_aiger_circuit, int num_timesteps, int num_err_latches);
+
 
 	protected:
 
@@ -93,6 +96,12 @@ class TestSymbTimeAnalysis: public CPPUNIT_NS::TestFixture
 
 	void test10_symbolic_simulation_compare_w_simulation();
 
+	// -------------------------------------------------------------------------------------------
+	///
+	/// @brief Tests that a faulty copy restricted to the cone of influence of the flipped latch
+	///        has the same outputs and next states as a complete faulty copy
+	void test11_cone_of_influence_mask();
+
 };
 
 #endif // CPP_UNIT_TestSymbTimeAnalysis_H__
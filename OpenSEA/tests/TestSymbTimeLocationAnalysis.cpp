@@ -232,4 +232,92 @@ void TestSymbTimeLocationAnalysis::test7_compare_with_simulation_1()
 			SymbTimeLocationAnalysis::STANDARD); // 164 Latches!
 }
 
+// -------------------------------------------------------------------------------------------
+void TestSymbTimeLocationAnalysis::test8_resume_from_journal()
+{
+	compareResumedWithFullRun("inputs/ex5.2vul.2l.aig", 5, 5, 2);
+	compareResumedWithFullRun("inputs/beecount-synth.2vul.1l.aig", 2, 5, 1);
+	compareResumedWithFullRun("inputs/traffic-synth.5vul.1l.aig", 5, 14, 1);
+	compareResumedWithFullRun("inputs/s5378.50percent.aag", 3, 5, 2);
+}
+
+void TestSymbTimeLocationAnalysis::compareResumedWithFullRun(string path_to_aiger_circuit,
+		int num_tc, int num_timesteps, int num_err_latches)
+{
+	aiger* circuit = Utils::readAiger(path_to_aiger_circuit);
+	CPPUNIT_ASSERT_MESSAGE("can not open " + path_to_aiger_circuit, circuit != 0);
 
+	srand(0xCAFECAFE);
+	TestCaseProvider::instance().setCircuit(circuit);
+	vector<TestCase> tcs = TestCaseProvider::instance().generateRandomTestCases(num_tc, num_timesteps);
+
+	SymbTimeLocationAnalysis full(circuit, num_err_latches);
+	full.analyze(tcs);
+	set<unsigned> expected = full.getDetectedLatches();
+
+	// a) a run interrupted after half of its journal
+	Options::instance().setJournal("stla_full.journal", false);
+	SymbTimeLocationAnalysis interrupted(circuit, num_err_latches);
+	interrupted.analyze(tcs);
+	remove("stla_cut.journal");
+	appendJournal("stla_full.journal", "stla_cut.journal", false);
+
+	Options::instance().setJournal("stla_cut.journal", true);
+	SymbTimeLocationAnalysis resumed(circuit, num_err_latches);
+	resumed.analyze(tcs);
+	bool resumed_equal = (resumed.getDetectedLatches() == expected);
+
+	// b) two shards with disjoint --exclude lists, the second one interrupted
+	set<unsigned> first_half, second_half;
+	unsigned num_latches = circuit->num_latches - num_err_latches;
+	for (unsigned l_cnt = 0; l_cnt < num_latches; ++l_cnt)
+	{
+		if (l_cnt < num_latches / 2)
+			first_half.insert(circuit->latches[l_cnt].lit);
+		else
+			second_half.insert(circuit->latches[l_cnt].lit);
+	}
+	Options::instance().setLatchesToExclude(second_half);
+	Options::instance().setJournal("stla_shard1.journal", false);
+	SymbTimeLocationAnalysis shard1(circuit, num_err_latches);
+	shard1.analyze(tcs);
+	Options::instance().setLatchesToExclude(first_half);
+	Options::instance().setJournal("stla_shard2.journal", false);
+	SymbTimeLocationAnalysis shard2(circuit, num_err_latches);
+	shard2.analyze(tcs);
+	remove("stla_merged.journal");
+	appendJournal("stla_shard1.journal", "stla_merged.journal", true);
+	appendJournal("stla_shard2.journal", "stla_merged.journal", false);
+
+	Options::instance().setLatchesToExclude(set<unsigned>());
+	Options::instance().setJournal("stla_merged.journal", true);
+	SymbTimeLocationAnalysis merged(circuit, num_err_latches);
+	merged.analyze(tcs);
+	bool merged_equal = (merged.getDetectedLatches() == expected);
+
+	Options::instance().setJournal("", false);
+	remove("stla_full.journal");
+	remove("stla_cut.journal");
+	remove("stla_shard1.journal");
+	remove("stla_shard2.journal");
+	remove("stla_merged.journal");
+	aiger_reset(circuit);
+
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, resumed_equal);
+	CPPUNIT_ASSERT_MESSAGE(path_to_aiger_circuit, merged_equal);
+}
+
+void TestSymbTimeLocationAnalysis::appendJournal(const string& from, const string& to,
+		bool complete)
+{
+	ifstream in_file(from.c_str());
+	vector<string> lines;
+	string line;
+	while (getline(in_file, line))
+		lines.push_back(line);
+
+	ofstream out_file(to.c_str(), ios::app);
+	unsigned num_lines = complete ? lines.size() : (lines.size() + 1) / 2;
+	for (unsigned cnt = 0; cnt < num_lines; ++cnt)
+		out_file << lines[cnt] << endl;
+}
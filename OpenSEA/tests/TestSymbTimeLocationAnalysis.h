@@ -46,6 +46,7 @@ class TestSymbTimeLocationAnalysis: public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST (test3_two_latches);
 	CPPUNIT_TEST (test4_analysis_w_1_extra_latch);
 	CPPUNIT_TEST (test7_compare_with_simulation_1);
+	CPPUNIT_TEST (test8_resume_from_journal);
 	CPPUNIT_TEST_SUITE_END();
 
 	public:
@@ -68,6 +69,26 @@ class TestSymbTimeLocationAnalysis: public CPPUNIT_NS::TestFixture
 			int num_timesteps, int num_err_latches,
 			int mode = SymbTimeLocationAnalysis::STANDARD);
 
+// -------------------------------------------------------------------------------------------
+///
+/// @brief checks that runs resumed from (merged) journals detect the same latches as a
+///        single full run
+///
+/// Resumes a run that was interrupted after half of its journal, and a run from the
+/// concatenated journals of two shards with disjoint --exclude lists, where the second shard
+/// was interrupted.
+	void compareResumedWithFullRun(string path_to_aiger_circuit, int num_tc,
+			int num_timesteps, int num_err_latches);
+
+// -------------------------------------------------------------------------------------------
+///
+/// @brief appends the lines of a journal file to another file
+///
+/// @param from the journal to copy.
+/// @param to the file to append to.
+/// @param complete false to copy only the first half of the lines (an interrupted run).
+	void appendJournal(const string& from, const string& to, bool complete);
+
 	protected:
 
 // -------------------------------------------------------------------------------------------
@@ -78,6 +99,7 @@ class TestSymbTimeLocationAnalysis: public CPPUNIT_NS::TestFixture
 	void test3_two_latches();
 	void test4_analysis_w_1_extra_latch();
 	void test7_compare_with_simulation_1();
+	void test8_resume_from_journal();
 };
 
 #endif // CPP_UNIT_TestSymbTimeLocationAnalysis_H__